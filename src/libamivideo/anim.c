@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "anim.h"
+#include <string.h>
+#include "instrumentation.h"
+
+#define TRUE 1
+#define FALSE 0
+
+/* A DLTA chunk starts with 16 longword offsets: one per bitplane, followed by the data lists of method 7 */
+#define AMIVIDEO_ANIM_NUM_OF_OFFSETS 16
+
+/* Maximum amount of bitplanes that a delta can modify */
+#define AMIVIDEO_ANIM_MAX_NUM_OF_BITPLANES 8
+
+typedef struct
+{
+    const amiVideo_UByte *data;
+    amiVideo_ULong pos;
+    amiVideo_ULong size;
+}
+DeltaList;
+
+static amiVideo_ULong readLong(const amiVideo_UByte *data)
+{
+    return ((amiVideo_ULong)data[0] << 24) | ((amiVideo_ULong)data[1] << 16) | ((amiVideo_ULong)data[2] << 8) | (amiVideo_ULong)data[3];
+}
+
+static int initDeltaList(DeltaList *list, const amiVideo_UByte *delta, amiVideo_ULong deltaSize, amiVideo_ULong offset)
+{
+    list->data = delta;
+    list->pos = offset;
+    list->size = deltaSize;
+
+    return offset >= AMIVIDEO_ANIM_NUM_OF_OFFSETS * 4 && offset < deltaSize;
+}
+
+static int readValue(DeltaList *list, unsigned int size, amiVideo_ULong *value)
+{
+    unsigned int i;
+
+    if(size > list->size - list->pos)
+        return FALSE;
+
+    /* Values are stored in big endian order */
+    *value = 0;
+
+    for(i = 0; i < size; i++)
+        *value = (*value << 8) | list->data[list->pos++];
+
+    return TRUE;
+}
+
+static const amiVideo_UByte *readItems(DeltaList *list, unsigned int itemSize, amiVideo_ULong count)
+{
+    const amiVideo_UByte *items = list->data + list->pos;
+
+    if(count > (list->size - list->pos) / itemSize)
+        return NULL;
+
+    list->pos += count * itemSize;
+    return items;
+}
+
+static amiVideo_UByte *getColumnItem(const amiVideo_Screen *screen, amiVideo_UByte *column, amiVideo_ULong row)
+{
+    if(screen->bitplaneFormat.numOfWrapRows > 0)
+        row = (screen->bitplaneFormat.firstRow + row) % screen->bitplaneFormat.numOfWrapRows; /* Scanlines beyond the last row of the playfield continue at its first row */
+
+    return column + row * screen->bitplaneFormat.rowStride;
+}
+
+static void storeItems(const amiVideo_Screen *screen, amiVideo_UByte *column, amiVideo_ULong row, const amiVideo_UByte *items, unsigned int step, unsigned int itemSize, amiVideo_ULong count, int xorMode)
+{
+    amiVideo_ULong i;
+    unsigned int j;
+
+    for(i = 0; i < count; i++)
+    {
+        amiVideo_UByte *target = getColumnItem(screen, column, row + i);
+
+        if(xorMode)
+        {
+            for(j = 0; j < itemSize; j++)
+                target[j] ^= items[j];
+        }
+        else
+            memcpy(target, items, itemSize);
+
+        items += step;
+    }
+}
+
+static int applyColumn(amiVideo_Screen *screen, amiVideo_UByte *column, DeltaList *opcodes, DeltaList *data, unsigned int opcodeSize, unsigned int itemSize, int xorMode, int *modified)
+{
+    amiVideo_ULong uniqueFlag = (amiVideo_ULong)1 << (opcodeSize * 8 - 1);
+    amiVideo_ULong numOfOpcodes;
+    amiVideo_ULong row = 0;
+
+    if(!readValue(opcodes, opcodeSize, &numOfOpcodes))
+        return FALSE;
+
+    for(; numOfOpcodes > 0; numOfOpcodes--)
+    {
+        amiVideo_ULong opcode, count;
+        const amiVideo_UByte *items;
+        unsigned int step;
+
+        if(!readValue(opcodes, opcodeSize, &opcode))
+            return FALSE;
+
+        if(opcode == 0)
+        {
+            /* Same: a count followed by a single item that is repeated */
+            if(!readValue(opcodes, opcodeSize, &count))
+                return FALSE;
+
+            items = readItems(data, itemSize, 1);
+            step = 0;
+        }
+        else if(opcode & uniqueFlag)
+        {
+            /* Unique: a count of items that are stored after each other */
+            count = opcode & ~uniqueFlag;
+            items = readItems(data, itemSize, count);
+            step = itemSize;
+        }
+        else
+        {
+            /* Skip: the amount of scanlines that remain unchanged */
+            if(opcode > screen->height - row)
+                return FALSE;
+
+            row += opcode;
+            continue;
+        }
+
+        if(items == NULL || count > screen->height - row)
+            return FALSE;
+
+        storeItems(screen, column, row, items, step, itemSize, count, xorMode);
+
+        if(screen->deltaFormat.touchedRows != NULL)
+            memset(screen->deltaFormat.touchedRows + row, TRUE, count);
+
+        if(count > 0)
+            *modified = TRUE;
+
+        row += count;
+    }
+
+    return TRUE;
+}
+
+static void recordDirtyRows(amiVideo_Screen *screen)
+{
+    amiVideo_RowRange *dirtyRows = screen->deltaFormat.dirtyRows;
+    unsigned int numOfWrapRows = screen->bitplaneFormat.numOfWrapRows;
+    unsigned int numOfDirtyRows = 0;
+    unsigned int i;
+
+    /* Scanlines that wrap around to the same row of the playfield show the same modifications */
+    if(numOfWrapRows > 0 && numOfWrapRows < screen->height)
+    {
+        for(i = numOfWrapRows; i < screen->height; i++)
+        {
+            if(screen->deltaFormat.touchedRows[i])
+                screen->deltaFormat.touchedRows[i % numOfWrapRows] = TRUE;
+        }
+
+        for(i = numOfWrapRows; i < screen->height; i++)
+            screen->deltaFormat.touchedRows[i] = screen->deltaFormat.touchedRows[i % numOfWrapRows];
+    }
+
+    for(i = 0; i < screen->height; i++)
+    {
+        if(screen->deltaFormat.touchedRows[i])
+        {
+            if(numOfDirtyRows > 0 && dirtyRows[numOfDirtyRows - 1].lastRow == i)
+                dirtyRows[numOfDirtyRows - 1].lastRow++; /* Extend the previous range */
+            else
+            {
+                dirtyRows[numOfDirtyRows].firstRow = i;
+                dirtyRows[numOfDirtyRows].lastRow = i + 1;
+                numOfDirtyRows++;
+            }
+
+            screen->deltaFormat.touchedRows[i] = FALSE; /* Prepare for the next delta */
+        }
+    }
+
+    screen->deltaFormat.numOfDirtyRows = numOfDirtyRows;
+    screen->deltaFormat.numOfDeltas++;
+    screen->deltaFormat.valid = TRUE;
+}
+
+int amiVideo_applyScreenDelta(amiVideo_Screen *screen, unsigned int operation, amiVideo_ULong bits, const amiVideo_UByte *delta, amiVideo_ULong deltaSize)
+{
+    unsigned int pitch = screen->bitplaneFormat.pitch;
+    unsigned int numOfBitplanes = screen->bitplaneDepth < AMIVIDEO_ANIM_MAX_NUM_OF_BITPLANES ? screen->bitplaneDepth : AMIVIDEO_ANIM_MAX_NUM_OF_BITPLANES;
+    unsigned int opcodeSize = 1;
+    unsigned int itemSize = 1;
+    int separateData = FALSE;
+    int xorMode = (bits & AMIVIDEO_ANIM_BITS_XOR) != 0;
+    int status = TRUE;
+    unsigned int firstColumn = pitch;
+    unsigned int lastColumn = 0;
+    unsigned int i;
+    AMIVIDEO_DECLARE_TIMESTAMP(start)
+
+    switch(operation)
+    {
+        case AMIVIDEO_ANIM_OPERATION_BYTE_VERTICAL_DELTA:
+            break;
+        case AMIVIDEO_ANIM_OPERATION_SHORT_LONG_VERTICAL_DELTA:
+            itemSize = (bits & AMIVIDEO_ANIM_BITS_LONG_DATA) ? 4 : 2;
+            separateData = TRUE;
+            break;
+        case AMIVIDEO_ANIM_OPERATION_SHORT_LONG_VERTICAL_DELTA_INLINE:
+            itemSize = (bits & AMIVIDEO_ANIM_BITS_LONG_DATA) ? 4 : 2;
+            opcodeSize = itemSize;
+            break;
+        default:
+            return FALSE;
+    }
+
+    if(deltaSize < AMIVIDEO_ANIM_NUM_OF_OFFSETS * 4)
+        return FALSE;
+
+    AMIVIDEO_START_STAGE(start);
+
+    for(i = 0; i < numOfBitplanes && status; i++)
+    {
+        amiVideo_ULong offset = readLong(delta + i * 4);
+        DeltaList opcodes, data;
+        DeltaList *dataList = &opcodes;
+        unsigned int x;
+
+        if(offset == 0)
+            continue; /* The bitplane has not changed */
+
+        if(!initDeltaList(&opcodes, delta, deltaSize, offset))
+        {
+            status = FALSE;
+            break;
+        }
+
+        if(separateData)
+        {
+            if(!initDeltaList(&data, delta, deltaSize, readLong(delta + (i + AMIVIDEO_ANIM_MAX_NUM_OF_BITPLANES) * 4)))
+            {
+                status = FALSE;
+                break;
+            }
+
+            dataList = &data;
+        }
+
+        /* A corrupt column stops both loops, so that no further bitplanes are modified by the rest of the delta */
+        for(x = 0; x < pitch && status; x += itemSize)
+        {
+            /* In long mode, a scanline that is not a multiple of 32 pixels ends with a column of words */
+            unsigned int columnSize = pitch - x < itemSize ? pitch - x : itemSize;
+            int modified = FALSE;
+
+            status = applyColumn(screen, screen->bitplaneFormat.bitplanes[i] + x, &opcodes, dataList, opcodeSize, columnSize, xorMode, &modified);
+
+            if(modified)
+            {
+                if(x < firstColumn)
+                    firstColumn = x;
+
+                if(x + columnSize > lastColumn)
+                    lastColumn = x + columnSize;
+            }
+        }
+    }
+
+    /* Even a partially applied delta modifies the bitplanes, so it is recorded as well */
+    if(screen->deltaFormat.enabled)
+    {
+        recordDirtyRows(screen);
+        screen->deltaFormat.firstColumn = firstColumn < lastColumn ? firstColumn : 0;
+        screen->deltaFormat.lastColumn = lastColumn;
+    }
+
+    AMIVIDEO_FINISH_STAGE(screen, AMIVIDEO_STAGE_DELTA, start, 0, deltaSize);
+    return status;
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __AMIVIDEO_ANIM_H
+#define __AMIVIDEO_ANIM_H
+#include "amivideotypes.h"
+#include "screen.h"
+
+/** Byte vertical delta compression, which modifies columns of bytes */
+#define AMIVIDEO_ANIM_OPERATION_BYTE_VERTICAL_DELTA 5
+
+/** Short/long vertical delta compression, which stores the opcodes and the data in separate lists */
+#define AMIVIDEO_ANIM_OPERATION_SHORT_LONG_VERTICAL_DELTA 7
+
+/** Short/long vertical delta compression, which stores opcodes of the same size as the data in the same list */
+#define AMIVIDEO_ANIM_OPERATION_SHORT_LONG_VERTICAL_DELTA_INLINE 8
+
+/** Indicates that the delta modifies columns of longwords instead of words */
+#define AMIVIDEO_ANIM_BITS_LONG_DATA 0x1
+
+/** Indicates that the delta is combined with the bitplanes by XOR instead of replacing them */
+#define AMIVIDEO_ANIM_BITS_XOR 0x2
+
+/**
+ * Applies the contents of a DLTA chunk to the bitplanes of the screen. The
+ * bitplanes are modified in place, so they must contain the frame to which
+ * the delta refers, which is usually the frame two frames back because ANIM
+ * files are double buffered. When delta conversion is enabled, the modified
+ * scanlines and columns are recorded in the deltaFormat sub struct, so that
+ * the subsequent conversions only convert those scanlines and, unless they
+ * are HAM encoded, those columns. A corrupt delta stops at the first corrupt
+ * column, leaving the remaining bitplanes unmodified. The scanlines of a
+ * playfield that wraps around are stored in the rows that they are read from.
+ *
+ * @param screen Screen conversion structure, which bitplanes are modified
+ * @param operation Compression method of the delta, which is one of the AMIVIDEO_ANIM_OPERATION_* constants
+ * @param bits Bits of the ANHD chunk, a combination of AMIVIDEO_ANIM_BITS_* flags
+ * @param delta Contents of the DLTA chunk
+ * @param deltaSize Size of the DLTA chunk in bytes
+ * @return TRUE if the delta has been applied, FALSE if the delta is truncated or corrupt or the compression method is not supported
+ */
+int amiVideo_applyScreenDelta(amiVideo_Screen *screen, unsigned int operation, amiVideo_ULong bits, const amiVideo_UByte *delta, amiVideo_ULong deltaSize);
+
+#endif
@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "byterun1.h"
+#include <stdlib.h>
+#include <string.h>
+#include "planar.h"
+#include "instrumentation.h"
+
+#define TRUE 1
+#define FALSE 0
+
+/* Maximum amount of bytes that a single literal or replicate run covers */
+#define AMIVIDEO_MAX_RUN_LENGTH 128
+
+/* Evaluates to a non-zero value if any byte of the given word is 0 */
+#define HAS_ZERO_BYTE(word) (((word) - 0x01010101U) & ~(word) & 0x80808080U)
+
+amiVideo_ULong amiVideo_unpackByteRun1(const amiVideo_UByte *source, amiVideo_ULong sourceSize, amiVideo_UByte *target, amiVideo_ULong targetSize)
+{
+    amiVideo_ULong sourcePos = 0;
+    amiVideo_ULong targetPos = 0;
+
+    while(targetPos < targetSize)
+    {
+        int n;
+        amiVideo_ULong count;
+
+        if(sourcePos >= sourceSize)
+            return 0; /* Truncated */
+
+        n = (signed char)source[sourcePos++];
+
+        if(n >= 0)
+        {
+            /* Copy the next n + 1 bytes literally */
+            count = n + 1;
+
+            if(count > sourceSize - sourcePos || count > targetSize - targetPos)
+                return 0;
+
+            memcpy(target + targetPos, source + sourcePos, count);
+            sourcePos += count;
+        }
+        else if(n != -128)
+        {
+            /* Replicate the next byte -n + 1 times */
+            count = -n + 1;
+
+            if(sourcePos >= sourceSize || count > targetSize - targetPos)
+                return 0;
+
+            memset(target + targetPos, source[sourcePos++], count);
+        }
+        else
+            continue; /* -128 is a no-op */
+
+        targetPos += count;
+    }
+
+    return sourcePos;
+}
+
+int amiVideo_feedBodyToScanLineStream(amiVideo_ScanLineStream *stream, const amiVideo_UByte *body, amiVideo_ULong bodySize, unsigned int masking, unsigned int compression)
+{
+    const amiVideo_Screen *screen = stream->screen;
+    unsigned int numOfPlanes = screen->bitplaneDepth;
+    amiVideo_ULong scanLineSize;
+    amiVideo_ULong offset = 0;
+    amiVideo_UByte *scanLine;
+    int status = TRUE;
+
+    if(masking == AMIVIDEO_MASKING_HAS_MASK)
+        numOfPlanes++; /* The mask rows succeed the bitplane rows of each scanline */
+
+    scanLineSize = (amiVideo_ULong)numOfPlanes * screen->bitplaneFormat.pitch;
+
+    if(compression == AMIVIDEO_COMPRESSION_NONE)
+    {
+        /* Uncompressed scanlines are converted in place */
+        while(stream->row < screen->height)
+        {
+            if(scanLineSize > bodySize - offset)
+                return FALSE;
+
+            amiVideo_feedInterleavedScanLineStream(stream, (amiVideo_UByte*)(body + offset));
+            offset += scanLineSize;
+        }
+
+        return TRUE;
+    }
+    else if(compression != AMIVIDEO_COMPRESSION_BYTERUN1)
+        return FALSE;
+
+    /* Decompress every scanline into the same workspace, so that it stays in the cache while it is converted */
+    scanLine = (amiVideo_UByte*)malloc(scanLineSize > 0 ? scanLineSize : 1);
+
+    if(scanLine == NULL)
+        return FALSE;
+
+    AMIVIDEO_COUNT_ALLOCATION(stream->screen, scanLineSize);
+
+    while(stream->row < screen->height)
+    {
+        amiVideo_ULong consumed = amiVideo_unpackByteRun1(body + offset, bodySize - offset, scanLine, scanLineSize);
+
+        if(consumed == 0 && scanLineSize > 0)
+        {
+            status = FALSE;
+            break;
+        }
+
+        amiVideo_feedInterleavedScanLineStream(stream, scanLine);
+        offset += consumed;
+    }
+
+    free(scanLine);
+    return status;
+}
+
+amiVideo_ULong amiVideo_getByteRun1Bound(amiVideo_ULong size)
+{
+    /* In the worst case, every 128 bytes need a literal run header */
+    return size + (size + AMIVIDEO_MAX_RUN_LENGTH - 1) / AMIVIDEO_MAX_RUN_LENGTH;
+}
+
+static amiVideo_ULong loadWord(const amiVideo_UByte *source)
+{
+    amiVideo_ULong word;
+    memcpy(&word, source, sizeof(word));
+    return word;
+}
+
+static amiVideo_ULong getRunLength(const amiVideo_UByte *source, amiVideo_ULong pos, amiVideo_ULong end)
+{
+    amiVideo_ULong pattern = source[pos] * 0x01010101U;
+    amiVideo_ULong start = pos;
+
+    if(end - pos > AMIVIDEO_MAX_RUN_LENGTH)
+        end = pos + AMIVIDEO_MAX_RUN_LENGTH;
+
+    /* Compare four bytes at a time while the run continues */
+    while(end - pos >= 4 && loadWord(source + pos) == pattern)
+        pos += 4;
+
+    while(pos < end && source[pos] == source[start])
+        pos++;
+
+    return pos - start;
+}
+
+static amiVideo_ULong getLiteralLength(const amiVideo_UByte *source, amiVideo_ULong pos, amiVideo_ULong end)
+{
+    amiVideo_ULong start = pos;
+
+    if(end - pos > AMIVIDEO_MAX_RUN_LENGTH)
+        end = pos + AMIVIDEO_MAX_RUN_LENGTH;
+
+    while(pos < end)
+    {
+        /* Skip four positions at a time if none of them is followed by an equal byte */
+        if(end - pos >= 5)
+        {
+            amiVideo_ULong difference = loadWord(source + pos) ^ loadWord(source + pos + 1);
+
+            if(!HAS_ZERO_BYTE(difference))
+            {
+                pos += 4;
+                continue;
+            }
+        }
+
+        /* A run of at least 3 equal bytes terminates the literal run */
+        if(pos + 2 < end && source[pos] == source[pos + 1] && source[pos] == source[pos + 2])
+            break;
+
+        pos++;
+    }
+
+    return pos - start;
+}
+
+amiVideo_ULong amiVideo_packByteRun1(const amiVideo_UByte *source, amiVideo_ULong size, amiVideo_UByte *target)
+{
+    amiVideo_ULong pos = 0;
+    amiVideo_ULong targetPos = 0;
+
+    while(pos < size)
+    {
+        amiVideo_ULong count = getRunLength(source, pos, size);
+
+        if(count >= 3)
+        {
+            /* Replicate the byte */
+            target[targetPos++] = (amiVideo_UByte)(1 - (int)count);
+            target[targetPos++] = source[pos];
+        }
+        else
+        {
+            /* Copy the bytes up to the next run literally */
+            count = getLiteralLength(source, pos, size);
+            target[targetPos++] = (amiVideo_UByte)(count - 1);
+            memcpy(target + targetPos, source + pos, count);
+            targetPos += count;
+        }
+
+        pos += count;
+    }
+
+    return targetPos;
+}
+
+amiVideo_ULong amiVideo_getScreenBodyBound(const amiVideo_Screen *screen, unsigned int compression)
+{
+    amiVideo_ULong rowSize = screen->bitplaneFormat.pitch;
+
+    if(compression == AMIVIDEO_COMPRESSION_BYTERUN1)
+        rowSize = amiVideo_getByteRun1Bound(rowSize);
+
+    return rowSize * screen->bitplaneDepth * screen->height;
+}
+
+amiVideo_ULong amiVideo_convertScreenChunkyPixelsToBody(amiVideo_Screen *screen, amiVideo_UByte *body, unsigned int compression, int interleaved)
+{
+    const amiVideo_PlanarKernels *kernels = amiVideo_getPlanarKernels();
+    unsigned int pitch = screen->bitplaneFormat.pitch;
+    amiVideo_ULong planeBound = amiVideo_getByteRun1Bound(pitch) * screen->height;
+    amiVideo_ULong planeSizes[8];
+    const amiVideo_UByte *pixels = screen->uncorrectedChunkyFormat.pixels;
+    amiVideo_UByte *bitplaneRows[8];
+    amiVideo_UByte *scanLine;
+    amiVideo_ULong bodySize = 0;
+    unsigned int i, j;
+    AMIVIDEO_DECLARE_TIMESTAMP(start)
+
+    if(screen->bitplaneDepth > 8)
+        return 0; /* A chunky pixel can only hold the first 8 bitplanes */
+
+    AMIVIDEO_START_STAGE(start);
+
+    if(compression == AMIVIDEO_COMPRESSION_NONE)
+    {
+        /* Uncompressed bitplane rows are stored in the body directly */
+        for(i = 0; i < screen->height; i++)
+        {
+            for(j = 0; j < screen->bitplaneDepth; j++)
+            {
+                if(interleaved)
+                    bitplaneRows[j] = body + (i * screen->bitplaneDepth + j) * pitch;
+                else
+                    bitplaneRows[j] = body + (j * screen->height + i) * pitch;
+            }
+
+            kernels->convertChunkyPixelsToBitplaneRow(pixels, screen->width, bitplaneRows, screen->bitplaneDepth, pitch);
+            pixels += screen->uncorrectedChunkyFormat.pitch;
+        }
+
+        bodySize = amiVideo_getScreenBodyBound(screen, compression);
+        AMIVIDEO_FINISH_STAGE(screen, AMIVIDEO_STAGE_PLANAR_ENCODE, start, (unsigned long)screen->width * screen->height, bodySize);
+        return bodySize;
+    }
+    else if(compression != AMIVIDEO_COMPRESSION_BYTERUN1)
+        return 0;
+
+    /* Convert every scanline into the same workspace, so that it is still in the cache while it is packed */
+    scanLine = (amiVideo_UByte*)malloc(screen->bitplaneDepth * pitch > 0 ? screen->bitplaneDepth * pitch : 1);
+
+    if(scanLine == NULL)
+        return 0;
+
+    AMIVIDEO_COUNT_ALLOCATION(screen, screen->bitplaneDepth * pitch);
+
+    for(j = 0; j < screen->bitplaneDepth; j++)
+    {
+        bitplaneRows[j] = scanLine + j * pitch;
+        planeSizes[j] = 0;
+    }
+
+    for(i = 0; i < screen->height; i++)
+    {
+        kernels->convertChunkyPixelsToBitplaneRow(pixels, screen->width, bitplaneRows, screen->bitplaneDepth, pitch);
+
+        for(j = 0; j < screen->bitplaneDepth; j++)
+        {
+            if(interleaved)
+                bodySize += amiVideo_packByteRun1(bitplaneRows[j], pitch, body + bodySize);
+            else
+                planeSizes[j] += amiVideo_packByteRun1(bitplaneRows[j], pitch, body + j * planeBound + planeSizes[j]); /* Each bitplane is packed into its own worst-case sized region */
+        }
+
+        pixels += screen->uncorrectedChunkyFormat.pitch;
+    }
+
+    free(scanLine);
+
+    if(!interleaved)
+    {
+        /* Close the gaps between the packed bitplanes */
+        for(j = 0; j < screen->bitplaneDepth; j++)
+        {
+            memmove(body + bodySize, body + j * planeBound, planeSizes[j]);
+            bodySize += planeSizes[j];
+        }
+    }
+
+    AMIVIDEO_FINISH_STAGE(screen, AMIVIDEO_STAGE_PLANAR_ENCODE, start, (unsigned long)screen->width * screen->height, bodySize);
+    return bodySize;
+}
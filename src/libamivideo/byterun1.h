@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __AMIVIDEO_BYTERUN1_H
+#define __AMIVIDEO_BYTERUN1_H
+#include "amivideotypes.h"
+#include "screen.h"
+
+/** Indicates that the body only contains bitplanes */
+#define AMIVIDEO_MASKING_NONE 0
+
+/** Indicates that every scanline of the body has an additional mask bitplane */
+#define AMIVIDEO_MASKING_HAS_MASK 1
+
+/** Indicates that a color of the palette is transparent */
+#define AMIVIDEO_MASKING_HAS_TRANSPARENT_COLOR 2
+
+/** Indicates that the image should be lassoed */
+#define AMIVIDEO_MASKING_LASSO 3
+
+/** Indicates that the body is not compressed */
+#define AMIVIDEO_COMPRESSION_NONE 0
+
+/** Indicates that the body is compressed with the ByteRun1 algorithm */
+#define AMIVIDEO_COMPRESSION_BYTERUN1 1
+
+/**
+ * Decompresses ByteRun1 compressed data until the given amount of bytes has
+ * been produced.
+ *
+ * @param source Compressed data
+ * @param sourceSize Size of the compressed data in bytes
+ * @param target Buffer that receives the decompressed data
+ * @param targetSize Amount of bytes that must be decompressed
+ * @return The amount of compressed bytes that have been consumed or 0 if the compressed data is truncated or a run exceeds the target buffer
+ */
+amiVideo_ULong amiVideo_unpackByteRun1(const amiVideo_UByte *source, amiVideo_ULong sourceSize, amiVideo_UByte *target, amiVideo_ULong targetSize);
+
+/**
+ * Decodes the remaining scanlines of an ILBM body and feeds them to a
+ * scanline stream. Each scanline is decompressed into a small workspace and
+ * converted immediately, while it still resides in the cache, so that the
+ * decompressed bitplanes never have to be stored. The width, height and
+ * bitplane depth of the body are taken from the screen of the stream. The
+ * rows of a mask bitplane are skipped.
+ *
+ * @param stream Scanline stream structure
+ * @param body Contents of the body
+ * @param bodySize Size of the body in bytes
+ * @param masking Masking technique of the body, which is one of the AMIVIDEO_MASKING_* constants
+ * @param compression Compression method of the body, which is one of the AMIVIDEO_COMPRESSION_* constants
+ * @return TRUE if all scanlines have been converted, FALSE if the body is truncated or corrupt, the compression method is unknown or the memory could not be allocated
+ */
+int amiVideo_feedBodyToScanLineStream(amiVideo_ScanLineStream *stream, const amiVideo_UByte *body, amiVideo_ULong bodySize, unsigned int masking, unsigned int compression);
+
+/**
+ * Calculates the maximum amount of bytes that amiVideo_packByteRun1() can
+ * produce for data of the given size.
+ *
+ * @param size Size of the uncompressed data in bytes
+ * @return Worst-case size of the compressed data in bytes
+ */
+amiVideo_ULong amiVideo_getByteRun1Bound(amiVideo_ULong size);
+
+/**
+ * Compresses data with the ByteRun1 algorithm. Runs of at least 3 equal bytes
+ * are replicated and all other bytes are stored literally.
+ *
+ * @param source Uncompressed data
+ * @param size Size of the uncompressed data in bytes
+ * @param target Buffer that receives the compressed data. It must be at least amiVideo_getByteRun1Bound() bytes in size.
+ * @return The size of the compressed data in bytes
+ */
+amiVideo_ULong amiVideo_packByteRun1(const amiVideo_UByte *source, amiVideo_ULong size, amiVideo_UByte *target);
+
+/**
+ * Calculates the maximum size of a body produced by
+ * amiVideo_convertScreenChunkyPixelsToBody().
+ *
+ * @param screen Screen conversion structure
+ * @param compression Compression method of the body, which is one of the AMIVIDEO_COMPRESSION_* constants
+ * @return Worst-case size of the body in bytes
+ */
+amiVideo_ULong amiVideo_getScreenBodyBound(const amiVideo_Screen *screen, unsigned int compression);
+
+/**
+ * Converts the chunky pixels of the screen to bitplanes and packs every
+ * bitplane row as soon as it has been produced, so that the planar frame
+ * does not have to be stored or traversed a second time. Each bitplane row
+ * is compressed separately, as the ILBM format prescribes. The body does not
+ * contain a mask.
+ *
+ * @param screen Screen conversion structure. At most 8 bitplanes are supported.
+ * @param body Buffer that receives the body. It must be at least amiVideo_getScreenBodyBound() bytes in size.
+ * @param compression Compression method of the body, which is one of the AMIVIDEO_COMPRESSION_* constants
+ * @param interleaved TRUE to store the rows of all bitplanes of a scanline after each other (ILBM), FALSE to store each bitplane as a whole after each other
+ * @return The size of the body in bytes or 0 if the screen has more than 8 bitplanes, the compression method is unknown or the memory could not be allocated
+ */
+amiVideo_ULong amiVideo_convertScreenChunkyPixelsToBody(amiVideo_Screen *screen, amiVideo_UByte *body, unsigned int compression, int interleaved);
+
+#endif
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string.h>
+#include "correction.h"
+#include "cpufeatures.h"
+
+void amiVideo_replicateChunkyPixels1xScalar(const void *source, unsigned int numOfPixels, void *target)
+{
+    memcpy(target, source, numOfPixels);
+}
+
+void amiVideo_replicateRGBPixels1xScalar(const void *source, unsigned int numOfPixels, void *target)
+{
+    memcpy(target, source, numOfPixels * 4);
+}
+
+void amiVideo_replicateChunkyPixels2xScalar(const void *source, unsigned int numOfPixels, void *target)
+{
+    const amiVideo_UByte *sourcePixels = (const amiVideo_UByte*)source;
+    amiVideo_UByte *targetPixels = (amiVideo_UByte*)target;
+    unsigned int i;
+
+    for(i = 0; i < numOfPixels; i++)
+    {
+        targetPixels[0] = targetPixels[1] = sourcePixels[i];
+        targetPixels += 2;
+    }
+}
+
+void amiVideo_replicateChunkyPixels4xScalar(const void *source, unsigned int numOfPixels, void *target)
+{
+    const amiVideo_UByte *sourcePixels = (const amiVideo_UByte*)source;
+    amiVideo_UByte *targetPixels = (amiVideo_UByte*)target;
+    unsigned int i;
+
+    for(i = 0; i < numOfPixels; i++)
+    {
+        targetPixels[0] = targetPixels[1] = targetPixels[2] = targetPixels[3] = sourcePixels[i];
+        targetPixels += 4;
+    }
+}
+
+void amiVideo_replicateRGBPixels2xScalar(const void *source, unsigned int numOfPixels, void *target)
+{
+    const amiVideo_ULong *sourcePixels = (const amiVideo_ULong*)source;
+    amiVideo_ULong *targetPixels = (amiVideo_ULong*)target;
+    unsigned int i;
+
+    for(i = 0; i < numOfPixels; i++)
+    {
+        targetPixels[0] = targetPixels[1] = sourcePixels[i];
+        targetPixels += 2;
+    }
+}
+
+void amiVideo_replicateRGBPixels4xScalar(const void *source, unsigned int numOfPixels, void *target)
+{
+    const amiVideo_ULong *sourcePixels = (const amiVideo_ULong*)source;
+    amiVideo_ULong *targetPixels = (amiVideo_ULong*)target;
+    unsigned int i;
+
+    for(i = 0; i < numOfPixels; i++)
+    {
+        targetPixels[0] = targetPixels[1] = targetPixels[2] = targetPixels[3] = sourcePixels[i];
+        targetPixels += 4;
+    }
+}
+
+void amiVideo_replicateWordPixels1xScalar(const void *source, unsigned int numOfPixels, void *target)
+{
+    memcpy(target, source, numOfPixels * 2);
+}
+
+void amiVideo_replicateWordPixels2xScalar(const void *source, unsigned int numOfPixels, void *target)
+{
+    const amiVideo_UWord *sourcePixels = (const amiVideo_UWord*)source;
+    amiVideo_ULong *targetPixels = (amiVideo_ULong*)target;
+    unsigned int i;
+
+    for(i = 0; i < numOfPixels; i++)
+        targetPixels[i] = sourcePixels[i] * 0x00010001U; /* Both halves contain the pixel, regardless of the byte order */
+}
+
+void amiVideo_replicateWordPixels4xScalar(const void *source, unsigned int numOfPixels, void *target)
+{
+    const amiVideo_UWord *sourcePixels = (const amiVideo_UWord*)source;
+    amiVideo_ULong *targetPixels = (amiVideo_ULong*)target;
+    unsigned int i;
+
+    for(i = 0; i < numOfPixels; i++)
+    {
+        targetPixels[0] = targetPixels[1] = sourcePixels[i] * 0x00010001U;
+        targetPixels += 2;
+    }
+}
+
+void amiVideo_duplicateScanLineScalar(void *target, const void *source, unsigned int size)
+{
+    memcpy(target, source, size);
+}
+
+static amiVideo_CorrectionKernels kernels;
+static int kernelsSelected = 0;
+
+static void selectCorrectionKernels(amiVideo_ULong features)
+{
+    kernels.replicateChunkyPixels[0] = amiVideo_replicateChunkyPixels1xScalar;
+    kernels.replicateChunkyPixels[1] = amiVideo_replicateChunkyPixels2xScalar;
+    kernels.replicateChunkyPixels[2] = amiVideo_replicateChunkyPixels4xScalar;
+    kernels.replicateWordPixels[0] = amiVideo_replicateWordPixels1xScalar;
+    kernels.replicateWordPixels[1] = amiVideo_replicateWordPixels2xScalar;
+    kernels.replicateWordPixels[2] = amiVideo_replicateWordPixels4xScalar;
+    kernels.replicateRGBPixels[0] = amiVideo_replicateRGBPixels1xScalar;
+    kernels.replicateRGBPixels[1] = amiVideo_replicateRGBPixels2xScalar;
+    kernels.replicateRGBPixels[2] = amiVideo_replicateRGBPixels4xScalar;
+    kernels.duplicateScanLine = amiVideo_duplicateScanLineScalar;
+    kernels.streamScanLine = amiVideo_duplicateScanLineScalar;
+
+#if defined(AMIVIDEO_HAVE_X86_SIMD)
+    if(features & AMIVIDEO_CPU_AVX2)
+    {
+        kernels.replicateChunkyPixels[1] = amiVideo_replicateChunkyPixels2xAVX2;
+        kernels.replicateChunkyPixels[2] = amiVideo_replicateChunkyPixels4xAVX2;
+        kernels.replicateRGBPixels[1] = amiVideo_replicateRGBPixels2xAVX2;
+        kernels.replicateRGBPixels[2] = amiVideo_replicateRGBPixels4xAVX2;
+        kernels.streamScanLine = amiVideo_streamScanLineAVX2;
+    }
+    else if(features & AMIVIDEO_CPU_SSE2)
+    {
+        kernels.replicateChunkyPixels[1] = amiVideo_replicateChunkyPixels2xSSE2;
+        kernels.replicateChunkyPixels[2] = amiVideo_replicateChunkyPixels4xSSE2;
+        kernels.replicateRGBPixels[1] = amiVideo_replicateRGBPixels2xSSE2;
+        kernels.replicateRGBPixels[2] = amiVideo_replicateRGBPixels4xSSE2;
+        kernels.streamScanLine = amiVideo_streamScanLineSSE2;
+    }
+#elif defined(AMIVIDEO_HAVE_NEON_SIMD)
+    if(features & AMIVIDEO_CPU_NEON)
+    {
+        kernels.replicateChunkyPixels[1] = amiVideo_replicateChunkyPixels2xNEON;
+        kernels.replicateChunkyPixels[2] = amiVideo_replicateChunkyPixels4xNEON;
+        kernels.replicateRGBPixels[1] = amiVideo_replicateRGBPixels2xNEON;
+        kernels.replicateRGBPixels[2] = amiVideo_replicateRGBPixels4xNEON;
+    }
+#endif
+}
+
+const amiVideo_CorrectionKernels *amiVideo_getCorrectionKernels(void)
+{
+    if(!kernelsSelected)
+    {
+        selectCorrectionKernels(amiVideo_getCPUFeatures());
+        kernelsSelected = 1;
+    }
+
+    return &kernels;
+}
+
+amiVideo_ReplicatePixelsKernel amiVideo_getReplicatePixelsKernel(unsigned int bytesPerPixel, unsigned int repeatHorizontal)
+{
+    const amiVideo_CorrectionKernels *correctionKernels = amiVideo_getCorrectionKernels();
+    const amiVideo_ReplicatePixelsKernel *replicatePixels;
+
+    switch(bytesPerPixel)
+    {
+        case 1:
+            replicatePixels = correctionKernels->replicateChunkyPixels;
+            break;
+        case 2:
+            replicatePixels = correctionKernels->replicateWordPixels;
+            break;
+        case 4:
+            replicatePixels = correctionKernels->replicateRGBPixels;
+            break;
+        default:
+            return NULL;
+    }
+
+    switch(repeatHorizontal)
+    {
+        case 1:
+            return replicatePixels[0];
+        case 2:
+            return replicatePixels[1];
+        case 4:
+            return replicatePixels[2];
+        default:
+            return NULL;
+    }
+}
+
+amiVideo_DuplicateScanLineKernel amiVideo_getDuplicateScanLineKernel(unsigned int surfaceSize)
+{
+    const amiVideo_CorrectionKernels *correctionKernels = amiVideo_getCorrectionKernels();
+
+    if(surfaceSize >= AMIVIDEO_STREAMING_THRESHOLD)
+        return correctionKernels->streamScanLine;
+    else
+        return correctionKernels->duplicateScanLine;
+}
+
+void amiVideo_resetCorrectionKernels(void)
+{
+    kernelsSelected = 0;
+}
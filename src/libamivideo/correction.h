@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __AMIVIDEO_CORRECTION_H
+#define __AMIVIDEO_CORRECTION_H
+#include "amivideotypes.h"
+#include "simd.h"
+
+/**
+ * Minimum size in bytes of a corrected surface for which duplicated scanlines
+ * are written with non-temporal stores. Smaller surfaces usually stay in the
+ * cache, in which case regular stores are considerably faster.
+ */
+#define AMIVIDEO_STREAMING_THRESHOLD (8 * 1024 * 1024)
+
+/**
+ * Writes every pixel of a scanline a fixed amount of times to the output.
+ *
+ * @param source Pixel scanline that must be replicated
+ * @param numOfPixels Amount of source pixels that must be replicated
+ * @param target Pixel scanline that receives the replicated pixels
+ */
+typedef void (*amiVideo_ReplicatePixelsKernel)(const void *source, unsigned int numOfPixels, void *target);
+
+/**
+ * Copies a corrected scanline to another scanline of the same surface.
+ *
+ * @param target Scanline that receives the copy
+ * @param source Scanline that must be copied
+ * @param size Amount of bytes that must be copied
+ */
+typedef void (*amiVideo_DuplicateScanLineKernel)(void *target, const void *source, unsigned int size);
+
+/**
+ * A dispatch table containing the most efficient correction kernels that the
+ * processor supports. The replication kernels are indexed by the logarithm of
+ * the horizontal repeat factor, so the elements correspond to 1, 2 and 4 times.
+ * Scanlines of large surfaces are duplicated with the streaming kernel.
+ */
+typedef struct
+{
+    amiVideo_ReplicatePixelsKernel replicateChunkyPixels[3];
+    amiVideo_ReplicatePixelsKernel replicateWordPixels[3];
+    amiVideo_ReplicatePixelsKernel replicateRGBPixels[3];
+    amiVideo_DuplicateScanLineKernel duplicateScanLine;
+    amiVideo_DuplicateScanLineKernel streamScanLine;
+}
+amiVideo_CorrectionKernels;
+
+/**
+ * Portable replication kernels. Repeating a pixel once is a plain copy.
+ */
+void amiVideo_replicateChunkyPixels1xScalar(const void *source, unsigned int numOfPixels, void *target);
+void amiVideo_replicateRGBPixels1xScalar(const void *source, unsigned int numOfPixels, void *target);
+void amiVideo_replicateChunkyPixels2xScalar(const void *source, unsigned int numOfPixels, void *target);
+void amiVideo_replicateChunkyPixels4xScalar(const void *source, unsigned int numOfPixels, void *target);
+void amiVideo_replicateRGBPixels2xScalar(const void *source, unsigned int numOfPixels, void *target);
+void amiVideo_replicateRGBPixels4xScalar(const void *source, unsigned int numOfPixels, void *target);
+
+/**
+ * Portable replication kernels for 16-bit pixels, which write the repeated
+ * pixels as 32-bit words.
+ */
+void amiVideo_replicateWordPixels1xScalar(const void *source, unsigned int numOfPixels, void *target);
+void amiVideo_replicateWordPixels2xScalar(const void *source, unsigned int numOfPixels, void *target);
+void amiVideo_replicateWordPixels4xScalar(const void *source, unsigned int numOfPixels, void *target);
+
+/**
+ * Duplicates a scanline with a regular memory copy.
+ */
+void amiVideo_duplicateScanLineScalar(void *target, const void *source, unsigned int size);
+
+#if defined(AMIVIDEO_HAVE_X86_SIMD)
+/**
+ * Replication kernels using SSE2 unpack and shuffle instructions that process
+ * 16 bytes of source pixels at once.
+ */
+void amiVideo_replicateChunkyPixels2xSSE2(const void *source, unsigned int numOfPixels, void *target);
+void amiVideo_replicateChunkyPixels4xSSE2(const void *source, unsigned int numOfPixels, void *target);
+void amiVideo_replicateRGBPixels2xSSE2(const void *source, unsigned int numOfPixels, void *target);
+void amiVideo_replicateRGBPixels4xSSE2(const void *source, unsigned int numOfPixels, void *target);
+
+/**
+ * Duplicates a scanline with non-temporal stores, so that the copies of large
+ * surfaces do not evict the scanlines that still have to be converted from
+ * the cache.
+ */
+void amiVideo_streamScanLineSSE2(void *target, const void *source, unsigned int size);
+
+/**
+ * Replication kernels using AVX2 unpack instructions that process 32 bytes of
+ * source pixels at once.
+ */
+void amiVideo_replicateChunkyPixels2xAVX2(const void *source, unsigned int numOfPixels, void *target);
+void amiVideo_replicateChunkyPixels4xAVX2(const void *source, unsigned int numOfPixels, void *target);
+void amiVideo_replicateRGBPixels2xAVX2(const void *source, unsigned int numOfPixels, void *target);
+void amiVideo_replicateRGBPixels4xAVX2(const void *source, unsigned int numOfPixels, void *target);
+
+/**
+ * Duplicates a scanline with 32 byte non-temporal stores.
+ */
+void amiVideo_streamScanLineAVX2(void *target, const void *source, unsigned int size);
+#endif
+
+#if defined(AMIVIDEO_HAVE_NEON_SIMD)
+/**
+ * Replication kernels using NEON interleaving stores that process 16 bytes of
+ * source pixels at once.
+ */
+void amiVideo_replicateChunkyPixels2xNEON(const void *source, unsigned int numOfPixels, void *target);
+void amiVideo_replicateChunkyPixels4xNEON(const void *source, unsigned int numOfPixels, void *target);
+void amiVideo_replicateRGBPixels2xNEON(const void *source, unsigned int numOfPixels, void *target);
+void amiVideo_replicateRGBPixels4xNEON(const void *source, unsigned int numOfPixels, void *target);
+#endif
+
+/**
+ * Returns the dispatch table with the most efficient correction kernels for
+ * the current processor. The kernels are selected the first time this function
+ * is invoked.
+ *
+ * @return A dispatch table with correction kernels
+ */
+const amiVideo_CorrectionKernels *amiVideo_getCorrectionKernels(void);
+
+/**
+ * Returns the kernel that replicates pixels of the given size the given amount
+ * of times.
+ *
+ * @param bytesPerPixel Specifies of how many bytes a pixel consists (1 = chunky, 2 = 16-bit RGB, 4 = RGB)
+ * @param repeatHorizontal Amount of times each pixel must be repeated
+ * @return The replication kernel or NULL if there is no specialized kernel for the given pixel size and repeat factor
+ */
+amiVideo_ReplicatePixelsKernel amiVideo_getReplicatePixelsKernel(unsigned int bytesPerPixel, unsigned int repeatHorizontal);
+
+/**
+ * Returns the kernel that duplicates scanlines of a corrected surface.
+ *
+ * @param surfaceSize Size in bytes of the corrected surface
+ * @return The streaming kernel if the surface exceeds AMIVIDEO_STREAMING_THRESHOLD, otherwise a regular copy
+ */
+amiVideo_DuplicateScanLineKernel amiVideo_getDuplicateScanLineKernel(unsigned int surfaceSize);
+
+/**
+ * Discards the selected kernels so that they are selected again on the next
+ * request, e.g. after the usable processor features have been restricted.
+ */
+void amiVideo_resetCorrectionKernels(void);
+
+#endif
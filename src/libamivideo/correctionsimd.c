@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "correction.h"
+
+/*
+ * The vectorized replication kernels load a vector of source pixels and
+ * interleave it with itself. Every interleaving step doubles each element, so
+ * a repeat factor of 4 takes two steps. Remaining pixels that do not fill a
+ * vector are replicated by the scalar kernels.
+ */
+
+#if defined(AMIVIDEO_HAVE_X86_SIMD) || defined(AMIVIDEO_HAVE_NEON_SIMD)
+
+#if defined(AMIVIDEO_HAVE_X86_SIMD)
+#include <string.h>
+#include <immintrin.h>
+#else
+#include <arm_neon.h>
+#endif
+
+static void replicateRemainingPixels(amiVideo_ReplicatePixelsKernel kernel, const void *source, unsigned int offset, unsigned int numOfPixels, unsigned int bytesPerPixel, unsigned int repeatHorizontal, void *target)
+{
+    if(offset < numOfPixels)
+        kernel((const amiVideo_UByte*)source + offset * bytesPerPixel, numOfPixels - offset, (amiVideo_UByte*)target + offset * bytesPerPixel * repeatHorizontal);
+}
+
+#if defined(AMIVIDEO_HAVE_X86_SIMD)
+
+AMIVIDEO_TARGET_SSE2 void amiVideo_replicateChunkyPixels2xSSE2(const void *source, unsigned int numOfPixels, void *target)
+{
+    const amiVideo_UByte *sourcePixels = (const amiVideo_UByte*)source;
+    __m128i *targetVectors = (__m128i*)target;
+    unsigned int i;
+
+    for(i = 0; i + 16 <= numOfPixels; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(sourcePixels + i));
+
+        _mm_storeu_si128(targetVectors++, _mm_unpacklo_epi8(v, v));
+        _mm_storeu_si128(targetVectors++, _mm_unpackhi_epi8(v, v));
+    }
+
+    replicateRemainingPixels(amiVideo_replicateChunkyPixels2xScalar, source, i, numOfPixels, 1, 2, target);
+}
+
+AMIVIDEO_TARGET_SSE2 void amiVideo_replicateChunkyPixels4xSSE2(const void *source, unsigned int numOfPixels, void *target)
+{
+    const amiVideo_UByte *sourcePixels = (const amiVideo_UByte*)source;
+    __m128i *targetVectors = (__m128i*)target;
+    unsigned int i;
+
+    for(i = 0; i + 16 <= numOfPixels; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(sourcePixels + i));
+        __m128i lo = _mm_unpacklo_epi8(v, v);
+        __m128i hi = _mm_unpackhi_epi8(v, v);
+
+        _mm_storeu_si128(targetVectors++, _mm_unpacklo_epi16(lo, lo));
+        _mm_storeu_si128(targetVectors++, _mm_unpackhi_epi16(lo, lo));
+        _mm_storeu_si128(targetVectors++, _mm_unpacklo_epi16(hi, hi));
+        _mm_storeu_si128(targetVectors++, _mm_unpackhi_epi16(hi, hi));
+    }
+
+    replicateRemainingPixels(amiVideo_replicateChunkyPixels4xScalar, source, i, numOfPixels, 1, 4, target);
+}
+
+AMIVIDEO_TARGET_SSE2 void amiVideo_replicateRGBPixels2xSSE2(const void *source, unsigned int numOfPixels, void *target)
+{
+    const amiVideo_ULong *sourcePixels = (const amiVideo_ULong*)source;
+    __m128i *targetVectors = (__m128i*)target;
+    unsigned int i;
+
+    for(i = 0; i + 4 <= numOfPixels; i += 4)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(sourcePixels + i));
+
+        _mm_storeu_si128(targetVectors++, _mm_unpacklo_epi32(v, v));
+        _mm_storeu_si128(targetVectors++, _mm_unpackhi_epi32(v, v));
+    }
+
+    replicateRemainingPixels(amiVideo_replicateRGBPixels2xScalar, source, i, numOfPixels, 4, 2, target);
+}
+
+AMIVIDEO_TARGET_SSE2 void amiVideo_replicateRGBPixels4xSSE2(const void *source, unsigned int numOfPixels, void *target)
+{
+    const amiVideo_ULong *sourcePixels = (const amiVideo_ULong*)source;
+    __m128i *targetVectors = (__m128i*)target;
+    unsigned int i;
+
+    for(i = 0; i + 4 <= numOfPixels; i += 4)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(sourcePixels + i));
+
+        _mm_storeu_si128(targetVectors++, _mm_shuffle_epi32(v, 0x00));
+        _mm_storeu_si128(targetVectors++, _mm_shuffle_epi32(v, 0x55));
+        _mm_storeu_si128(targetVectors++, _mm_shuffle_epi32(v, 0xaa));
+        _mm_storeu_si128(targetVectors++, _mm_shuffle_epi32(v, 0xff));
+    }
+
+    replicateRemainingPixels(amiVideo_replicateRGBPixels4xScalar, source, i, numOfPixels, 4, 4, target);
+}
+
+AMIVIDEO_TARGET_SSE2 void amiVideo_streamScanLineSSE2(void *target, const void *source, unsigned int size)
+{
+    amiVideo_UByte *targetBytes = (amiVideo_UByte*)target;
+    const amiVideo_UByte *sourceBytes = (const amiVideo_UByte*)source;
+    unsigned int head = (16 - ((size_t)targetBytes & 15)) & 15; /* Non-temporal stores require an aligned target */
+    unsigned int i;
+
+    if(head > size)
+        head = size;
+
+    memcpy(targetBytes, sourceBytes, head);
+
+    for(i = head; i + 16 <= size; i += 16)
+        _mm_stream_si128((__m128i*)(targetBytes + i), _mm_loadu_si128((const __m128i*)(sourceBytes + i)));
+
+    memcpy(targetBytes + i, sourceBytes + i, size - i);
+    _mm_sfence();
+}
+
+/*
+ * AVX2 unpack instructions operate within each 128-bit lane. The lanes of the
+ * unpacked vectors are swapped back into memory order before storing them.
+ */
+
+AMIVIDEO_TARGET_AVX2 static void storeReplicatedVectorsAVX2(__m256i *target, __m256i lo, __m256i hi)
+{
+    _mm256_storeu_si256(target, _mm256_permute2x128_si256(lo, hi, 0x20));
+    _mm256_storeu_si256(target + 1, _mm256_permute2x128_si256(lo, hi, 0x31));
+}
+
+AMIVIDEO_TARGET_AVX2 void amiVideo_replicateChunkyPixels2xAVX2(const void *source, unsigned int numOfPixels, void *target)
+{
+    const amiVideo_UByte *sourcePixels = (const amiVideo_UByte*)source;
+    __m256i *targetVectors = (__m256i*)target;
+    unsigned int i;
+
+    for(i = 0; i + 32 <= numOfPixels; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(sourcePixels + i));
+
+        storeReplicatedVectorsAVX2(targetVectors, _mm256_unpacklo_epi8(v, v), _mm256_unpackhi_epi8(v, v));
+        targetVectors += 2;
+    }
+
+    replicateRemainingPixels(amiVideo_replicateChunkyPixels2xSSE2, source, i, numOfPixels, 1, 2, target);
+}
+
+AMIVIDEO_TARGET_AVX2 void amiVideo_replicateChunkyPixels4xAVX2(const void *source, unsigned int numOfPixels, void *target)
+{
+    const amiVideo_UByte *sourcePixels = (const amiVideo_UByte*)source;
+    __m256i *targetVectors = (__m256i*)target;
+    unsigned int i;
+
+    for(i = 0; i + 32 <= numOfPixels; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(sourcePixels + i));
+        __m256i lo = _mm256_unpacklo_epi8(v, v); /* Pixels 0-7 and 16-23 doubled */
+        __m256i hi = _mm256_unpackhi_epi8(v, v); /* Pixels 8-15 and 24-31 doubled */
+        __m256i first = _mm256_permute2x128_si256(lo, hi, 0x20); /* Pixels 0-15 doubled */
+        __m256i second = _mm256_permute2x128_si256(lo, hi, 0x31); /* Pixels 16-31 doubled */
+
+        storeReplicatedVectorsAVX2(targetVectors, _mm256_unpacklo_epi16(first, first), _mm256_unpackhi_epi16(first, first));
+        storeReplicatedVectorsAVX2(targetVectors + 2, _mm256_unpacklo_epi16(second, second), _mm256_unpackhi_epi16(second, second));
+        targetVectors += 4;
+    }
+
+    replicateRemainingPixels(amiVideo_replicateChunkyPixels4xSSE2, source, i, numOfPixels, 1, 4, target);
+}
+
+AMIVIDEO_TARGET_AVX2 void amiVideo_replicateRGBPixels2xAVX2(const void *source, unsigned int numOfPixels, void *target)
+{
+    const amiVideo_ULong *sourcePixels = (const amiVideo_ULong*)source;
+    __m256i *targetVectors = (__m256i*)target;
+    unsigned int i;
+
+    for(i = 0; i + 8 <= numOfPixels; i += 8)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(sourcePixels + i));
+
+        storeReplicatedVectorsAVX2(targetVectors, _mm256_unpacklo_epi32(v, v), _mm256_unpackhi_epi32(v, v));
+        targetVectors += 2;
+    }
+
+    replicateRemainingPixels(amiVideo_replicateRGBPixels2xSSE2, source, i, numOfPixels, 4, 2, target);
+}
+
+AMIVIDEO_TARGET_AVX2 void amiVideo_replicateRGBPixels4xAVX2(const void *source, unsigned int numOfPixels, void *target)
+{
+    const amiVideo_ULong *sourcePixels = (const amiVideo_ULong*)source;
+    __m256i *targetVectors = (__m256i*)target;
+    unsigned int i;
+
+    for(i = 0; i + 8 <= numOfPixels; i += 8)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(sourcePixels + i));
+        __m256i lo = _mm256_unpacklo_epi32(v, v);
+        __m256i hi = _mm256_unpackhi_epi32(v, v);
+        __m256i first = _mm256_permute2x128_si256(lo, hi, 0x20); /* Pixels 0-3 doubled */
+        __m256i second = _mm256_permute2x128_si256(lo, hi, 0x31); /* Pixels 4-7 doubled */
+
+        storeReplicatedVectorsAVX2(targetVectors, _mm256_unpacklo_epi64(first, first), _mm256_unpackhi_epi64(first, first));
+        storeReplicatedVectorsAVX2(targetVectors + 2, _mm256_unpacklo_epi64(second, second), _mm256_unpackhi_epi64(second, second));
+        targetVectors += 4;
+    }
+
+    replicateRemainingPixels(amiVideo_replicateRGBPixels4xSSE2, source, i, numOfPixels, 4, 4, target);
+}
+
+AMIVIDEO_TARGET_AVX2 void amiVideo_streamScanLineAVX2(void *target, const void *source, unsigned int size)
+{
+    amiVideo_UByte *targetBytes = (amiVideo_UByte*)target;
+    const amiVideo_UByte *sourceBytes = (const amiVideo_UByte*)source;
+    unsigned int head = (32 - ((size_t)targetBytes & 31)) & 31; /* Non-temporal stores require an aligned target */
+    unsigned int i;
+
+    if(head > size)
+        head = size;
+
+    memcpy(targetBytes, sourceBytes, head);
+
+    for(i = head; i + 32 <= size; i += 32)
+        _mm256_stream_si256((__m256i*)(targetBytes + i), _mm256_loadu_si256((const __m256i*)(sourceBytes + i)));
+
+    memcpy(targetBytes + i, sourceBytes + i, size - i);
+    _mm_sfence();
+}
+
+#else
+
+void amiVideo_replicateChunkyPixels2xNEON(const void *source, unsigned int numOfPixels, void *target)
+{
+    const amiVideo_UByte *sourcePixels = (const amiVideo_UByte*)source;
+    amiVideo_UByte *targetPixels = (amiVideo_UByte*)target;
+    unsigned int i;
+
+    for(i = 0; i + 16 <= numOfPixels; i += 16)
+    {
+        uint8x16x2_t v;
+
+        v.val[0] = v.val[1] = vld1q_u8(sourcePixels + i);
+        vst2q_u8(targetPixels + i * 2, v);
+    }
+
+    replicateRemainingPixels(amiVideo_replicateChunkyPixels2xScalar, source, i, numOfPixels, 1, 2, target);
+}
+
+void amiVideo_replicateChunkyPixels4xNEON(const void *source, unsigned int numOfPixels, void *target)
+{
+    const amiVideo_UByte *sourcePixels = (const amiVideo_UByte*)source;
+    amiVideo_UByte *targetPixels = (amiVideo_UByte*)target;
+    unsigned int i;
+
+    for(i = 0; i + 16 <= numOfPixels; i += 16)
+    {
+        uint8x16x4_t v;
+
+        v.val[0] = v.val[1] = v.val[2] = v.val[3] = vld1q_u8(sourcePixels + i);
+        vst4q_u8(targetPixels + i * 4, v);
+    }
+
+    replicateRemainingPixels(amiVideo_replicateChunkyPixels4xScalar, source, i, numOfPixels, 1, 4, target);
+}
+
+void amiVideo_replicateRGBPixels2xNEON(const void *source, unsigned int numOfPixels, void *target)
+{
+    const amiVideo_ULong *sourcePixels = (const amiVideo_ULong*)source;
+    amiVideo_ULong *targetPixels = (amiVideo_ULong*)target;
+    unsigned int i;
+
+    for(i = 0; i + 4 <= numOfPixels; i += 4)
+    {
+        uint32x4x2_t v;
+
+        v.val[0] = v.val[1] = vld1q_u32((const uint32_t*)(sourcePixels + i));
+        vst2q_u32((uint32_t*)(targetPixels + i * 2), v);
+    }
+
+    replicateRemainingPixels(amiVideo_replicateRGBPixels2xScalar, source, i, numOfPixels, 4, 2, target);
+}
+
+void amiVideo_replicateRGBPixels4xNEON(const void *source, unsigned int numOfPixels, void *target)
+{
+    const amiVideo_ULong *sourcePixels = (const amiVideo_ULong*)source;
+    amiVideo_ULong *targetPixels = (amiVideo_ULong*)target;
+    unsigned int i;
+
+    for(i = 0; i + 4 <= numOfPixels; i += 4)
+    {
+        uint32x4x4_t v;
+
+        v.val[0] = v.val[1] = v.val[2] = v.val[3] = vld1q_u32((const uint32_t*)(sourcePixels + i));
+        vst4q_u32((uint32_t*)(targetPixels + i * 4), v);
+    }
+
+    replicateRemainingPixels(amiVideo_replicateRGBPixels4xScalar, source, i, numOfPixels, 4, 4, target);
+}
+
+#endif
+
+#endif
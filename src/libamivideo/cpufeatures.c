@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cpufeatures.h"
+#include "planar.h"
+#include "correction.h"
+#include "swizzle.h"
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+static amiVideo_ULong detectedFeatures;
+static int featuresDetected = 0;
+static amiVideo_ULong featureMask = AMIVIDEO_CPU_ALL;
+
+static amiVideo_ULong detectCPUFeatures(void)
+{
+    amiVideo_ULong features = 0;
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    __builtin_cpu_init();
+
+    if(__builtin_cpu_supports("sse2"))
+        features |= AMIVIDEO_CPU_SSE2;
+    if(__builtin_cpu_supports("ssse3"))
+        features |= AMIVIDEO_CPU_SSSE3;
+    if(__builtin_cpu_supports("avx2"))
+        features |= AMIVIDEO_CPU_AVX2;
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    int info[4];
+
+    __cpuid(info, 0);
+
+    if(info[0] >= 1)
+    {
+        int maxLevel = info[0];
+
+        __cpuid(info, 1);
+
+        if(info[3] & (1 << 26))
+            features |= AMIVIDEO_CPU_SSE2;
+        if(info[2] & (1 << 9))
+            features |= AMIVIDEO_CPU_SSSE3;
+
+        /* AVX2 can only be used if the operating system saves the YMM registers */
+        if(maxLevel >= 7 && (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 0x6) == 0x6)
+        {
+            __cpuidex(info, 7, 0);
+
+            if(info[1] & (1 << 5))
+                features |= AMIVIDEO_CPU_AVX2;
+        }
+    }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+    features |= AMIVIDEO_CPU_NEON; /* NEON kernels are only compiled in if the target always supports them */
+#endif
+
+    return features;
+}
+
+amiVideo_ULong amiVideo_getCPUFeatures(void)
+{
+    if(!featuresDetected)
+    {
+        detectedFeatures = detectCPUFeatures();
+        featuresDetected = 1;
+    }
+
+    return detectedFeatures & featureMask;
+}
+
+void amiVideo_restrictCPUFeatures(amiVideo_ULong features)
+{
+    featureMask = features;
+    amiVideo_resetPlanarKernels();
+    amiVideo_resetCorrectionKernels();
+    amiVideo_resetSwizzleKernels();
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __AMIVIDEO_CPUFEATURES_H
+#define __AMIVIDEO_CPUFEATURES_H
+#include "amivideotypes.h"
+
+/** Indicates that the processor supports the SSE2 instruction set */
+#define AMIVIDEO_CPU_SSE2 0x1
+
+/** Indicates that the processor supports the SSSE3 instruction set */
+#define AMIVIDEO_CPU_SSSE3 0x2
+
+/** Indicates that the processor supports the AVX2 instruction set */
+#define AMIVIDEO_CPU_AVX2 0x4
+
+/** Indicates that the processor supports the NEON instruction set */
+#define AMIVIDEO_CPU_NEON 0x8
+
+/** Mask selecting all processor features */
+#define AMIVIDEO_CPU_ALL 0xffffffff
+
+/**
+ * Queries the instruction set extensions that the conversion kernels are
+ * allowed to use. The first time this function is invoked, the processor's
+ * capabilities are detected.
+ *
+ * @return A bitmask of AMIVIDEO_CPU_* flags
+ */
+amiVideo_ULong amiVideo_getCPUFeatures(void);
+
+/**
+ * Restricts the instruction set extensions that the conversion kernels are
+ * allowed to use to the given mask. This is useful to compare the performance
+ * of the kernels or to work around faulty hardware. The best suitable kernels
+ * are selected again on the next conversion.
+ *
+ * @param features A bitmask of AMIVIDEO_CPU_* flags or AMIVIDEO_CPU_ALL to use all detected features
+ */
+void amiVideo_restrictCPUFeatures(amiVideo_ULong features);
+
+#endif
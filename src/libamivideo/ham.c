@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ham.h"
+
+void amiVideo_initHAMTable(amiVideo_HAMTable *table, unsigned int bitplaneDepth, const amiVideo_ULong *colors, amiVideo_UByte rshift, amiVideo_UByte gshift, amiVideo_UByte bshift)
+{
+    unsigned int controlShift = bitplaneDepth - 2;
+    unsigned int i;
+
+    for(i = 0; i < 256; i++)
+    {
+        unsigned int mode = (i >> controlShift) & 0x3;
+        unsigned int index = i & ~(0x3 << controlShift);
+        amiVideo_ULong level = (index << (8 - controlShift)) & 0xff; /* Data bits are the most significant bits of the color component */
+
+        switch(mode)
+        {
+            case 0x0: /* Data bits are an index in the color palette */
+                table->keepMask[i] = 0;
+                table->setBits[i] = colors[index];
+                break;
+            case 0x1: /* Data bits are blue level */
+                table->keepMask[i] = ~((amiVideo_ULong)0xff << bshift);
+                table->setBits[i] = level << bshift;
+                break;
+            case 0x2: /* Data bits are red level */
+                table->keepMask[i] = ~((amiVideo_ULong)0xff << rshift);
+                table->setBits[i] = level << rshift;
+                break;
+            default: /* Data bits are green level */
+                table->keepMask[i] = ~((amiVideo_ULong)0xff << gshift);
+                table->setBits[i] = level << gshift;
+                break;
+        }
+    }
+}
+
+void amiVideo_convertHAMIndexesToRGBPixels(const amiVideo_HAMTable *table, const amiVideo_UByte *indexes, amiVideo_ULong *pixels, unsigned int numOfPixels, amiVideo_ULong *previousPixel)
+{
+    amiVideo_ULong pixel = *previousPixel;
+    unsigned int i;
+
+    for(i = 0; i < numOfPixels; i++)
+    {
+        amiVideo_UByte index = indexes[i];
+
+        pixel = (pixel & table->keepMask[index]) | table->setBits[index];
+        pixels[i] = pixel;
+    }
+
+    *previousPixel = pixel;
+}
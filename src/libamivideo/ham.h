@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __AMIVIDEO_HAM_H
+#define __AMIVIDEO_HAM_H
+#include "amivideotypes.h"
+
+/**
+ * Lookup tables that decode Hold-and-Modify (HAM) index values into packed
+ * RGB pixels. Every index value either selects a palette color or modifies a
+ * single color component of the previous pixel. Both can be expressed as
+ * (previous & keepMask) | setBits, so that decoding a pixel takes two lookups
+ * and no branches.
+ */
+typedef struct
+{
+    /** Bits of the previous pixel that are kept for each index value */
+    amiVideo_ULong keepMask[256];
+
+    /** Bits that are set for each index value */
+    amiVideo_ULong setBits[256];
+}
+amiVideo_HAMTable;
+
+/**
+ * Fills the HAM lookup tables for the control bit layout of the given bitplane
+ * depth, e.g. HAM6 (6 bitplanes) or HAM8 (8 bitplanes). The two most
+ * significant bitplanes contain the control bits.
+ *
+ * @param table HAM lookup tables
+ * @param bitplaneDepth Bitplane depth of the HAM screen
+ * @param colors Packed RGB pixel values of each palette color (256 entries)
+ * @param rshift The amount of bits that we have to left shift the red color component
+ * @param gshift The amount of bits that we have to left shift the green color component
+ * @param bshift The amount of bits that we have to left shift the blue color component
+ */
+void amiVideo_initHAMTable(amiVideo_HAMTable *table, unsigned int bitplaneDepth, const amiVideo_ULong *colors, amiVideo_UByte rshift, amiVideo_UByte gshift, amiVideo_UByte bshift);
+
+/**
+ * Decodes HAM index values into packed RGB pixels.
+ *
+ * @param table HAM lookup tables
+ * @param indexes Index values of the pixels
+ * @param pixels RGB pixels that receive the decoded colors
+ * @param numOfPixels Amount of pixels that must be decoded
+ * @param previousPixel Pixel that precedes the first pixel. It is updated to the last decoded pixel, so that a scanline can be decoded in multiple parts.
+ */
+void amiVideo_convertHAMIndexesToRGBPixels(const amiVideo_HAMTable *table, const amiVideo_UByte *indexes, amiVideo_ULong *pixels, unsigned int numOfPixels, amiVideo_ULong *previousPixel);
+
+#endif
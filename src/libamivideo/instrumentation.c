@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#if defined(HAVE_CLOCK_GETTIME) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "instrumentation.h"
+
+#if defined(AMIVIDEO_INSTRUMENTATION)
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+double amiVideo_getTimestamp(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter, frequency;
+
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (double)counter.QuadPart * 1e9 / (double)frequency.QuadPart;
+#elif defined(HAVE_CLOCK_GETTIME)
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec * 1e9 + (double)time.tv_nsec;
+#else
+    return (double)clock() * 1e9 / CLOCKS_PER_SEC; /* Processor time is the best that plain C offers */
+#endif
+}
+
+void amiVideo_recordStage(amiVideo_ScreenStats *stats, unsigned int stage, double start, unsigned long numOfPixels, unsigned long numOfBytes)
+{
+    amiVideo_StageStats *stageStats = &stats->stage[stage];
+
+    stageStats->numOfRuns++;
+    stageStats->time += amiVideo_getTimestamp() - start;
+    stageStats->numOfPixels += numOfPixels;
+    stageStats->numOfBytes += numOfBytes;
+}
+
+void amiVideo_recordAllocation(amiVideo_ScreenStats *stats, unsigned long size)
+{
+    stats->numOfAllocations++;
+    stats->allocatedBytes += size;
+}
+
+#endif
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __AMIVIDEO_INSTRUMENTATION_H
+#define __AMIVIDEO_INSTRUMENTATION_H
+#include "screen.h"
+
+/*
+ * The hot paths record their statistics through these macros, which expand
+ * to nothing unless the library is built with AMIVIDEO_INSTRUMENTATION
+ * defined. A stage is measured as follows:
+ *
+ * AMIVIDEO_DECLARE_TIMESTAMP(start)
+ * ...
+ * AMIVIDEO_START_STAGE(start);
+ * ...
+ * AMIVIDEO_FINISH_STAGE(screen, AMIVIDEO_STAGE_..., start, numOfPixels, numOfBytes);
+ *
+ * The arguments of the macros are not evaluated if instrumentation is
+ * disabled, so they may compute the amounts of pixels and bytes.
+ */
+
+#if defined(AMIVIDEO_INSTRUMENTATION)
+
+#define AMIVIDEO_DECLARE_TIMESTAMP(start) double start;
+#define AMIVIDEO_START_STAGE(start) start = amiVideo_getTimestamp()
+#define AMIVIDEO_FINISH_STAGE(screen, stage, start, numOfPixels, numOfBytes) amiVideo_recordStage(&(screen)->stats, stage, start, numOfPixels, numOfBytes)
+#define AMIVIDEO_COUNT_ALLOCATION(screen, size) amiVideo_recordAllocation(&(screen)->stats, size)
+
+/**
+ * Returns a monotonic time stamp.
+ *
+ * @return Time stamp in nanoseconds
+ */
+double amiVideo_getTimestamp(void);
+
+/**
+ * Adds a run of a stage to the statistics.
+ *
+ * @param stats Statistics of a screen
+ * @param stage Any of the AMIVIDEO_STAGE_* values
+ * @param start Time stamp at which the stage started
+ * @param numOfPixels Amount of pixels that the stage has produced
+ * @param numOfBytes Amount of bytes that the stage has written
+ */
+void amiVideo_recordStage(amiVideo_ScreenStats *stats, unsigned int stage, double start, unsigned long numOfPixels, unsigned long numOfBytes);
+
+/**
+ * Adds an allocated memory block to the statistics.
+ *
+ * @param stats Statistics of a screen
+ * @param size Size of the memory block in bytes
+ */
+void amiVideo_recordAllocation(amiVideo_ScreenStats *stats, unsigned long size);
+
+#else
+
+#define AMIVIDEO_DECLARE_TIMESTAMP(start)
+#define AMIVIDEO_START_STAGE(start)
+#define AMIVIDEO_FINISH_STAGE(screen, stage, start, numOfPixels, numOfBytes)
+#define AMIVIDEO_COUNT_ALLOCATION(screen, size)
+
+#endif
+
+#endif
@@ -24,6 +24,9 @@
 #include <string.h>
 #include "viewportmode.h"
 
+#define TRUE 1
+#define FALSE 0
+
 static unsigned int determineNumOfColors(unsigned int bitplaneDepth)
 {
     switch(bitplaneDepth)
@@ -51,29 +54,67 @@ static unsigned int determineNumOfColors(unsigned int bitplaneDepth)
 
 void amiVideo_initPalette(amiVideo_Palette *palette, unsigned int bitplaneDepth, unsigned int bitsPerColorChannel, amiVideo_Long viewportMode)
 {
-    /* Assign values */
-    palette->bitplaneFormat.viewportMode = viewportMode;
+    /* No memory has been allocated yet */
+    palette->bitplaneFormat.color = NULL;
+    palette->bitplaneFormat.maxNumOfColors = 0;
+    palette->chunkyFormat.color = NULL;
+    palette->chunkyFormat.numOfColors = 0;
+    palette->chunkyFormat.maxNumOfColors = 0;
+
+    /* The RGB pixel cache is generated on first use */
+    palette->rgbFormat.valid = FALSE;
+    palette->rgbFormat.pairIndexBits = 0;
+    palette->rgbFormat.pixelPair = NULL;
+    palette->rgbFormat.pixelPairValid = FALSE;
+    palette->rgbFormat.version = 0;
+
+    amiVideo_reinitPalette(palette, bitplaneDepth, bitsPerColorChannel, viewportMode);
+}
 
-    /* Allocate memory for bitplane colors */
+void amiVideo_reinitPalette(amiVideo_Palette *palette, unsigned int bitplaneDepth, unsigned int bitsPerColorChannel, amiVideo_Long viewportMode)
+{
+    unsigned int numOfChunkyColors;
 
+    /* Assign values */
+    palette->bitplaneFormat.viewportMode = viewportMode;
     palette->bitplaneFormat.bitsPerColorChannel = bitsPerColorChannel;
     palette->bitplaneFormat.numOfColors = determineNumOfColors(bitplaneDepth);
-    palette->bitplaneFormat.color = (amiVideo_Color*)malloc(palette->bitplaneFormat.numOfColors * sizeof(amiVideo_Color));
 
-    /* Allocate memory for chunky colors */
+    /* Allocate memory for bitplane colors, if the current memory is too small */
+
+    if(palette->bitplaneFormat.numOfColors > palette->bitplaneFormat.maxNumOfColors)
+    {
+        free(palette->bitplaneFormat.color);
+        palette->bitplaneFormat.color = (amiVideo_Color*)malloc(palette->bitplaneFormat.numOfColors * sizeof(amiVideo_Color));
+        palette->bitplaneFormat.maxNumOfColors = palette->bitplaneFormat.color == NULL ? 0 : palette->bitplaneFormat.numOfColors;
+    }
+
+    /* Allocate memory for chunky colors, if the current memory is too small */
 
     if(amiVideo_checkExtraHalfbrite(viewportMode))
-        palette->chunkyFormat.numOfColors = 2 * palette->bitplaneFormat.numOfColors; /* Extra halfbrite screen mode has double the amount of colors */
+        numOfChunkyColors = 2 * palette->bitplaneFormat.numOfColors; /* Extra halfbrite screen mode has double the amount of colors */
     else
-        palette->chunkyFormat.numOfColors = palette->bitplaneFormat.numOfColors;
+        numOfChunkyColors = palette->bitplaneFormat.numOfColors;
+
+    if(numOfChunkyColors > palette->chunkyFormat.maxNumOfColors)
+    {
+        free(palette->chunkyFormat.color);
+        palette->chunkyFormat.color = (amiVideo_OutputColor*)calloc(numOfChunkyColors, sizeof(amiVideo_OutputColor));
+        palette->chunkyFormat.maxNumOfColors = palette->chunkyFormat.color == NULL ? 0 : numOfChunkyColors;
+    }
+
+    /* The cached RGB pixels only cover the previous amount of chunky colors */
+    if(numOfChunkyColors != palette->chunkyFormat.numOfColors)
+        amiVideo_invalidatePaletteRGBPixels(palette);
 
-    palette->chunkyFormat.color = (amiVideo_OutputColor*)malloc(palette->chunkyFormat.numOfColors * sizeof(amiVideo_OutputColor));
+    palette->chunkyFormat.numOfColors = numOfChunkyColors;
 }
 
 void amiVideo_cleanupPalette(amiVideo_Palette *palette)
 {
     free(palette->bitplaneFormat.color);
     free(palette->chunkyFormat.color);
+    free(palette->rgbFormat.pixelPair);
 }
 
 void amiVideo_setBitplanePaletteColors(amiVideo_Palette *palette, amiVideo_Color *color, unsigned int numOfColors)
@@ -96,6 +137,22 @@ void amiVideo_setChunkyPaletteColors(amiVideo_Palette *palette, amiVideo_OutputC
 
     if(numOfRemainingColors > 0)
         memset(palette->chunkyFormat.color + numOfColors, '\0', numOfRemainingColors * sizeof(amiVideo_OutputColor)); /* Set the remaining ones to 0 */
+
+    amiVideo_invalidatePaletteRGBPixels(palette);
+}
+
+static amiVideo_Bool updateChunkyColor(amiVideo_OutputColor *targetColor, amiVideo_UByte r, amiVideo_UByte g, amiVideo_UByte b)
+{
+    if(targetColor->r == r && targetColor->g == g && targetColor->b == b && targetColor->a == '\0')
+        return FALSE;
+    else
+    {
+        targetColor->r = r;
+        targetColor->g = g;
+        targetColor->b = b;
+        targetColor->a = '\0';
+        return TRUE;
+    }
 }
 
 void amiVideo_convertBitplaneColorsToChunkyFormat(amiVideo_Palette *palette)
@@ -103,16 +160,14 @@ void amiVideo_convertBitplaneColorsToChunkyFormat(amiVideo_Palette *palette)
     /* We must convert color channels that consist do not consist of 8 bits */
     unsigned int i;
     int shift = 8 - palette->bitplaneFormat.bitsPerColorChannel;
+    amiVideo_Bool changed = FALSE;
 
     for(i = 0; i < palette->bitplaneFormat.numOfColors; i++)
     {
         amiVideo_Color *sourceColor = &palette->bitplaneFormat.color[i];
         amiVideo_OutputColor *targetColor = &palette->chunkyFormat.color[i];
 
-        targetColor->r = sourceColor->r << shift;
-        targetColor->g = sourceColor->g << shift;
-        targetColor->b = sourceColor->b << shift;
-        targetColor->a = '\0';
+        changed |= updateChunkyColor(targetColor, sourceColor->r << shift, sourceColor->g << shift, sourceColor->b << shift);
     }
 
     /* For extra half brite screen modes we must append half of the color values of the original color register values */
@@ -126,12 +181,13 @@ void amiVideo_convertBitplaneColorsToChunkyFormat(amiVideo_Palette *palette)
             amiVideo_OutputColor *sourceColor = &palette->chunkyFormat.color[i];
             amiVideo_OutputColor *targetColor = &palette->chunkyFormat.color[i + palette->bitplaneFormat.numOfColors];
 
-            targetColor->r = sourceColor->r >> 1;
-            targetColor->g = sourceColor->g >> 1;
-            targetColor->b = sourceColor->b >> 1;
-            targetColor->a = '\0';
+            changed |= updateChunkyColor(targetColor, sourceColor->r >> 1, sourceColor->g >> 1, sourceColor->b >> 1);
         }
     }
+
+    /* Conversions invoke this function for every frame, so only discard the cached RGB pixels if a color has really changed */
+    if(changed)
+        amiVideo_invalidatePaletteRGBPixels(palette);
 }
 
 void amiVideo_convertChunkyColorsToBitplaneFormat(amiVideo_Palette *palette)
@@ -150,6 +206,83 @@ void amiVideo_convertChunkyColorsToBitplaneFormat(amiVideo_Palette *palette)
     }
 }
 
+void amiVideo_invalidatePaletteRGBPixels(amiVideo_Palette *palette)
+{
+    palette->rgbFormat.valid = FALSE;
+    palette->rgbFormat.pixelPairValid = FALSE;
+    palette->rgbFormat.version++;
+}
+
+const amiVideo_ULong *amiVideo_getPaletteRGBPixels(amiVideo_Palette *palette, amiVideo_UByte rshift, amiVideo_UByte gshift, amiVideo_UByte bshift, amiVideo_UByte ashift)
+{
+    if(!palette->rgbFormat.valid || palette->rgbFormat.rshift != rshift || palette->rgbFormat.gshift != gshift || palette->rgbFormat.bshift != bshift || palette->rgbFormat.ashift != ashift)
+    {
+        unsigned int i;
+
+        for(i = 0; i < 256; i++)
+        {
+            if(i < palette->chunkyFormat.numOfColors)
+            {
+                amiVideo_OutputColor *color = &palette->chunkyFormat.color[i];
+                palette->rgbFormat.pixel[i] = ((amiVideo_ULong)color->r << rshift) | ((amiVideo_ULong)color->g << gshift) | ((amiVideo_ULong)color->b << bshift) | ((amiVideo_ULong)color->a << ashift);
+            }
+            else
+                palette->rgbFormat.pixel[i] = 0;
+        }
+
+        palette->rgbFormat.rshift = rshift;
+        palette->rgbFormat.gshift = gshift;
+        palette->rgbFormat.bshift = bshift;
+        palette->rgbFormat.ashift = ashift;
+        palette->rgbFormat.valid = TRUE;
+        palette->rgbFormat.pixelPairValid = FALSE; /* The pair table is derived from the pixel values */
+    }
+
+    return palette->rgbFormat.pixel;
+}
+
+const amiVideo_ULong *amiVideo_getPaletteRGBPixelPairs(amiVideo_Palette *palette, amiVideo_UByte rshift, amiVideo_UByte gshift, amiVideo_UByte bshift, amiVideo_UByte ashift, unsigned int *indexBits)
+{
+    const amiVideo_ULong *pixel = amiVideo_getPaletteRGBPixels(palette, rshift, gshift, bshift, ashift);
+
+    if(palette->chunkyFormat.numOfColors > AMIVIDEO_MAX_NUM_OF_PAIRED_COLORS)
+        return NULL;
+
+    if(!palette->rgbFormat.pixelPairValid)
+    {
+        unsigned int bits = 0;
+        unsigned int numOfIndexes;
+        unsigned int i;
+
+        while((1U << bits) < palette->chunkyFormat.numOfColors)
+            bits++;
+
+        numOfIndexes = 1 << bits;
+
+        if(palette->rgbFormat.pixelPair == NULL || palette->rgbFormat.pairIndexBits != bits)
+        {
+            free(palette->rgbFormat.pixelPair);
+            palette->rgbFormat.pixelPair = (amiVideo_ULong*)malloc(numOfIndexes * numOfIndexes * 2 * sizeof(amiVideo_ULong));
+
+            if(palette->rgbFormat.pixelPair == NULL)
+                return NULL;
+
+            palette->rgbFormat.pairIndexBits = bits;
+        }
+
+        for(i = 0; i < numOfIndexes * numOfIndexes; i++)
+        {
+            palette->rgbFormat.pixelPair[2 * i] = pixel[i >> bits];
+            palette->rgbFormat.pixelPair[2 * i + 1] = pixel[i & (numOfIndexes - 1)];
+        }
+
+        palette->rgbFormat.pixelPairValid = TRUE;
+    }
+
+    *indexBits = palette->rgbFormat.pairIndexBits;
+    return palette->rgbFormat.pixelPair;
+}
+
 amiVideo_UWord *amiVideo_generateRGB4ColorSpecs(const amiVideo_Palette *palette)
 {
     unsigned int i;
@@ -72,6 +72,9 @@ typedef struct
         /** Stores the color values of the palette */
         amiVideo_Color *color;
 
+        /** Contains the number of colors for which memory has been allocated */
+        unsigned int maxNumOfColors;
+
         /** Contains the number of bits that a color component has (4 = OCS/ECS, 8 = AGA) */
         unsigned int bitsPerColorChannel;
     }
@@ -84,11 +87,51 @@ typedef struct
 
         /** Stores the color values of the palette */
         amiVideo_OutputColor *color;
+
+        /** Contains the number of colors for which memory has been allocated */
+        unsigned int maxNumOfColors;
     }
     chunkyFormat;
+
+    struct
+    {
+        /** Indicates whether the cached RGB pixel values correspond to the current chunky colors */
+        amiVideo_Bool valid;
+
+        /** Contains the amount of bits that the red color component is left shifted in the cached pixels */
+        amiVideo_UByte rshift;
+
+        /** Contains the amount of bits that the green color component is left shifted in the cached pixels */
+        amiVideo_UByte gshift;
+
+        /** Contains the amount of bits that the blue color component is left shifted in the cached pixels */
+        amiVideo_UByte bshift;
+
+        /** Contains the amount of bits that the alpha color component is left shifted in the cached pixels */
+        amiVideo_UByte ashift;
+
+        /** Stores the RGB pixel value of every chunky color index. Indexes beyond the palette map to 0 */
+        amiVideo_ULong pixel[256];
+
+        /** Contains the amount of bits of a color index used in the pixel pair table */
+        unsigned int pairIndexBits;
+
+        /** Stores the RGB pixel values of every combination of two color indexes or NULL if it has not been generated */
+        amiVideo_ULong *pixelPair;
+
+        /** Indicates whether the pixel pair table corresponds to the cached RGB pixel values */
+        amiVideo_Bool pixelPairValid;
+
+        /** Is incremented every time the cached pixels are discarded, so that tables derived from them can detect that the colors have changed */
+        unsigned int version;
+    }
+    rgbFormat;
 }
 amiVideo_Palette;
 
+/** The maximum amount of chunky colors for which a pixel pair table is generated. Larger tables no longer fit in the data cache. */
+#define AMIVIDEO_MAX_NUM_OF_PAIRED_COLORS 64
+
 /**
  * Initialises the palette with the given bitplane depth, bits per color channel
  * and viewport mode.
@@ -100,6 +143,20 @@ amiVideo_Palette;
  */
 void amiVideo_initPalette(amiVideo_Palette *palette, unsigned int bitplaneDepth, unsigned int bitsPerColorChannel, amiVideo_Long viewportMode);
 
+/**
+ * Changes the bitplane depth, bits per color channel and viewport mode of a
+ * palette that has already been initialised. The color storage is only
+ * reallocated when it is too small to hold the new amount of colors, and the
+ * cached RGB pixels are retained when the amount of chunky colors does not
+ * change. The values of the colors are retained as well.
+ *
+ * @param palette Palette conversion structure
+ * @param bitplaneDepth Bitplane depth, a value between 1-6 (OCS/ECS) and 1-8 (AGA)
+ * @param bitsPerColorChannel The amount of bits for used for a color component (4 = ECS/OCS, 8 = AGA)
+ * @param viewportMode The viewport mode value
+ */
+void amiVideo_reinitPalette(amiVideo_Palette *palette, unsigned int bitplaneDepth, unsigned int bitsPerColorChannel, amiVideo_Long viewportMode);
+
 /**
  * Frees all the heap allocated members of the palette from memory.
  *
@@ -151,6 +208,48 @@ void amiVideo_convertBitplaneColorsToChunkyFormat(amiVideo_Palette *palette);
  */
 void amiVideo_convertChunkyColorsToBitplaneFormat(amiVideo_Palette *palette);
 
+/**
+ * Marks the cached RGB pixel values of the palette as outdated. This function
+ * is invoked by all palette functions that modify the chunky colors and only
+ * needs to be called after modifying the chunky colors directly.
+ *
+ * @param palette Palette conversion structure
+ */
+void amiVideo_invalidatePaletteRGBPixels(amiVideo_Palette *palette);
+
+/**
+ * Returns a lookup table that maps every chunky color index to an RGB pixel
+ * value in which the color components are shifted by the given amounts. The
+ * table is cached inside the palette and only regenerated when the chunky
+ * colors or the shift values have changed.
+ *
+ * @param palette Palette conversion structure
+ * @param rshift Amount of bits that the red color component is left shifted
+ * @param gshift Amount of bits that the green color component is left shifted
+ * @param bshift Amount of bits that the blue color component is left shifted
+ * @param ashift Amount of bits that the alpha color component is left shifted
+ * @return A lookup table with 256 RGB pixel values
+ */
+const amiVideo_ULong *amiVideo_getPaletteRGBPixels(amiVideo_Palette *palette, amiVideo_UByte rshift, amiVideo_UByte gshift, amiVideo_UByte bshift, amiVideo_UByte ashift);
+
+/**
+ * Returns a lookup table that maps two consecutive chunky color indexes to the
+ * RGB pixel values of both pixels, so that a single lookup produces two output
+ * pixels. Element ((first << indexBits) | second) * 2 contains the first pixel
+ * and the next element the second pixel. The table is cached inside the
+ * palette and only generated for palettes with at most
+ * AMIVIDEO_MAX_NUM_OF_PAIRED_COLORS colors.
+ *
+ * @param palette Palette conversion structure
+ * @param rshift Amount of bits that the red color component is left shifted
+ * @param gshift Amount of bits that the green color component is left shifted
+ * @param bshift Amount of bits that the blue color component is left shifted
+ * @param ashift Amount of bits that the alpha color component is left shifted
+ * @param indexBits Is set to the amount of bits that a color index occupies in the table index
+ * @return A lookup table of pixel pairs or NULL if the palette has too many colors or the table could not be allocated
+ */
+const amiVideo_ULong *amiVideo_getPaletteRGBPixelPairs(amiVideo_Palette *palette, amiVideo_UByte rshift, amiVideo_UByte gshift, amiVideo_UByte bshift, amiVideo_UByte ashift, unsigned int *indexBits);
+
 /**
  * Converts the bitplane palette to an array of word specifications, which can
  * be used by AmigaOS' LoadRGB4() function to set a screen's palette. This
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "pixelformat.h"
+
+void amiVideo_convertRGBPixelsToRGB565(const amiVideo_ULong *source, unsigned int numOfPixels, amiVideo_UWord *target)
+{
+    unsigned int i;
+
+    for(i = 0; i < numOfPixels; i++)
+    {
+        amiVideo_ULong pixel = source[i];
+        target[i] = (amiVideo_UWord)(((pixel >> 8) & 0xf800) | ((pixel >> 5) & 0x07e0) | ((pixel >> 3) & 0x001f));
+    }
+}
+
+void amiVideo_convertRGBPixelsToXRGB1555(const amiVideo_ULong *source, unsigned int numOfPixels, amiVideo_UWord *target)
+{
+    unsigned int i;
+
+    for(i = 0; i < numOfPixels; i++)
+    {
+        amiVideo_ULong pixel = source[i];
+        target[i] = (amiVideo_UWord)(((pixel >> 9) & 0x7c00) | ((pixel >> 6) & 0x03e0) | ((pixel >> 3) & 0x001f));
+    }
+}
+
+void amiVideo_storeRGB24Pixels(const amiVideo_ULong *source, unsigned int numOfPixels, unsigned int repeatHorizontal, amiVideo_UByte *target)
+{
+    unsigned int i;
+
+    for(i = 0; i < numOfPixels; i++)
+    {
+        amiVideo_ULong pixel = source[i];
+        amiVideo_UByte r = (amiVideo_UByte)(pixel >> 16);
+        amiVideo_UByte g = (amiVideo_UByte)(pixel >> 8);
+        amiVideo_UByte b = (amiVideo_UByte)pixel;
+        unsigned int j;
+
+        for(j = 0; j < repeatHorizontal; j++)
+        {
+            target[0] = r;
+            target[1] = g;
+            target[2] = b;
+            target += 3;
+        }
+    }
+}
+
+void amiVideo_storeChunky4Pixels(const amiVideo_UByte *source, unsigned int numOfPixels, unsigned int repeatHorizontal, amiVideo_UByte *target)
+{
+    if(repeatHorizontal == 1)
+    {
+        /* Combine every two pixels into a byte */
+        unsigned int i;
+
+        for(i = 0; i + 1 < numOfPixels; i += 2)
+            *target++ = (amiVideo_UByte)(((source[i] & 0xf) << 4) | (source[i + 1] & 0xf));
+
+        if(i < numOfPixels)
+            *target = (amiVideo_UByte)((source[i] & 0xf) << 4);
+    }
+    else
+    {
+        amiVideo_UByte byte = 0;
+        int highNibble = 1;
+        unsigned int i;
+
+        for(i = 0; i < numOfPixels; i++)
+        {
+            amiVideo_UByte index = source[i] & 0xf;
+            unsigned int j;
+
+            for(j = 0; j < repeatHorizontal; j++)
+            {
+                if(highNibble)
+                    byte = index << 4;
+                else
+                    *target++ = byte | index;
+
+                highNibble = !highNibble;
+            }
+        }
+
+        if(!highNibble)
+            *target = byte; /* The amount of written pixels is odd */
+    }
+}
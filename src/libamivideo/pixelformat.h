@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __AMIVIDEO_PIXELFORMAT_H
+#define __AMIVIDEO_PIXELFORMAT_H
+#include "amivideotypes.h"
+
+/*
+ * Kernels that store pixels in the compact pixel formats. The RGB kernels
+ * take pixels in which the red, green and blue color components are shifted
+ * 16, 8 and 0 bits, which is the layout that the conversions use internally
+ * for the compact RGB formats.
+ */
+
+/** The amount of bits that the red color component is shifted in the internal RGB layout */
+#define AMIVIDEO_COMPACT_RSHIFT 16
+
+/** The amount of bits that the green color component is shifted in the internal RGB layout */
+#define AMIVIDEO_COMPACT_GSHIFT 8
+
+/** The amount of bits that the blue color component is shifted in the internal RGB layout */
+#define AMIVIDEO_COMPACT_BSHIFT 0
+
+/** The amount of bits that the alpha color component is shifted in the internal RGB layout */
+#define AMIVIDEO_COMPACT_ASHIFT 24
+
+/**
+ * Converts RGB pixels to 16-bit pixels in which the red, green and blue
+ * components consist of 5, 6 and 5 bits.
+ *
+ * @param source RGB pixels in the internal layout
+ * @param numOfPixels Amount of pixels that must be converted
+ * @param target 16-bit pixels that receive the result
+ */
+void amiVideo_convertRGBPixelsToRGB565(const amiVideo_ULong *source, unsigned int numOfPixels, amiVideo_UWord *target);
+
+/**
+ * Converts RGB pixels to 16-bit pixels in which the red, green and blue
+ * components consist of 5 bits each and the most significant bit is unused.
+ *
+ * @param source RGB pixels in the internal layout
+ * @param numOfPixels Amount of pixels that must be converted
+ * @param target 16-bit pixels that receive the result
+ */
+void amiVideo_convertRGBPixelsToXRGB1555(const amiVideo_ULong *source, unsigned int numOfPixels, amiVideo_UWord *target);
+
+/**
+ * Stores RGB pixels as packed 24-bit pixels of which the bytes contain the
+ * red, green and blue components in memory order. Every pixel is written the
+ * given amount of times.
+ *
+ * @param source RGB pixels in the internal layout
+ * @param numOfPixels Amount of source pixels that must be stored
+ * @param repeatHorizontal Amount of times each pixel must be repeated
+ * @param target Packed pixels that receive the result
+ */
+void amiVideo_storeRGB24Pixels(const amiVideo_ULong *source, unsigned int numOfPixels, unsigned int repeatHorizontal, amiVideo_UByte *target);
+
+/**
+ * Stores chunky pixels as 4-bit pixels in which every byte contains two
+ * pixels. The leftmost pixel is stored in the most significant nibble. Every
+ * pixel is written the given amount of times. If the amount of written pixels
+ * is odd, the least significant nibble of the last byte is cleared.
+ *
+ * @param source Chunky pixels of which only the 4 least significant bits are used
+ * @param numOfPixels Amount of source pixels that must be stored
+ * @param repeatHorizontal Amount of times each pixel must be repeated
+ * @param target Packed pixels that receive the result
+ */
+void amiVideo_storeChunky4Pixels(const amiVideo_UByte *source, unsigned int numOfPixels, unsigned int repeatHorizontal, amiVideo_UByte *target);
+
+#endif
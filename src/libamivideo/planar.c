@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "planar.h"
+#include "cpufeatures.h"
+
+/*
+ * The planar to chunky conversion treats a group of 32 pixels as a 8x32 bit
+ * matrix in which each row is a 32-bit word containing the bits of a bitplane
+ * (the most significant bitplane comes first). Transposing each of the four
+ * 8x8 sub matrices yields words in which every byte is a chunky pixel.
+ *
+ * Because a transpose is its own inverse, the chunky to planar conversion uses
+ * the same network in the opposite direction.
+ */
+
+static amiVideo_ULong loadBitplaneWord(const amiVideo_UByte *bitplaneRow, unsigned int numOfBytes)
+{
+    if(numOfBytes >= 4)
+        return ((amiVideo_ULong)bitplaneRow[0] << 24) | ((amiVideo_ULong)bitplaneRow[1] << 16) | ((amiVideo_ULong)bitplaneRow[2] << 8) | (amiVideo_ULong)bitplaneRow[3];
+    else
+    {
+        /* Load the remaining bytes of the scanline and pad the missing ones with 0 */
+        amiVideo_ULong word = 0;
+        unsigned int i;
+
+        for(i = 0; i < numOfBytes; i++)
+            word |= (amiVideo_ULong)bitplaneRow[i] << (24 - 8 * i);
+
+        return word;
+    }
+}
+
+static void loadBitplaneWords(amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, unsigned int offset, unsigned int numOfBytes, amiVideo_ULong *words)
+{
+    unsigned int i;
+
+    for(i = 0; i < bitplaneDepth; i++)
+        words[7 - i] = loadBitplaneWord(bitplaneRows[i] + offset, numOfBytes);
+
+    for(; i < 8; i++)
+        words[7 - i] = 0; /* Absent bitplanes contribute nothing to the index value */
+}
+
+static void swapBitBlocks(amiVideo_ULong *upper, amiVideo_ULong *lower, unsigned int shift, amiVideo_ULong mask)
+{
+    amiVideo_ULong t = (*upper ^ (*lower >> shift)) & mask;
+    *upper ^= t;
+    *lower ^= t << shift;
+}
+
+static void transposeBitplaneWords(amiVideo_ULong *words)
+{
+    unsigned int i;
+
+    /* Swap the 4x4 blocks */
+    for(i = 0; i < 4; i++)
+        swapBitBlocks(&words[i], &words[i + 4], 4, 0x0f0f0f0f);
+
+    /* Swap the 2x2 blocks */
+    for(i = 0; i < 8; i += 4)
+    {
+        swapBitBlocks(&words[i], &words[i + 2], 2, 0x33333333);
+        swapBitBlocks(&words[i + 1], &words[i + 3], 2, 0x33333333);
+    }
+
+    /* Swap the single bits */
+    for(i = 0; i < 8; i += 2)
+        swapBitBlocks(&words[i], &words[i + 1], 1, 0x55555555);
+}
+
+void amiVideo_convertBitplaneRowToChunkyPixelsScalar(amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, amiVideo_UByte *pixels, unsigned int width)
+{
+    amiVideo_ULong words[8];
+    unsigned int x;
+    unsigned int offset = 0;
+
+    for(x = 0; x < width; x += 32)
+    {
+        unsigned int numOfPixels = width - x;
+        unsigned int i;
+
+        if(numOfPixels > 32)
+            numOfPixels = 32;
+
+        loadBitplaneWords(bitplaneRows, bitplaneDepth, offset, (numOfPixels + 7) / 8, words);
+        transposeBitplaneWords(words);
+
+        /* After the transpose, byte n of word i contains the index value of pixel 8 * n + i */
+        if(numOfPixels == 32)
+        {
+            for(i = 0; i < 8; i++)
+            {
+                pixels[x + i] = (amiVideo_UByte)(words[i] >> 24);
+                pixels[x + 8 + i] = (amiVideo_UByte)(words[i] >> 16);
+                pixels[x + 16 + i] = (amiVideo_UByte)(words[i] >> 8);
+                pixels[x + 24 + i] = (amiVideo_UByte)words[i];
+            }
+        }
+        else
+        {
+            for(i = 0; i < numOfPixels; i++)
+                pixels[x + i] = (amiVideo_UByte)(words[i % 8] >> (24 - 8 * (i / 8)));
+        }
+
+        offset += 4;
+    }
+}
+
+static amiVideo_ULong loadChunkyWord(const amiVideo_UByte *pixels, unsigned int index, unsigned int numOfPixels)
+{
+    amiVideo_ULong word = 0;
+    unsigned int i;
+
+    for(i = 0; i < 4; i++)
+    {
+        word <<= 8;
+
+        if(index < numOfPixels)
+            word |= pixels[index];
+
+        index += 8;
+    }
+
+    return word;
+}
+
+void amiVideo_convertChunkyPixelsToBitplaneRowScalar(const amiVideo_UByte *pixels, unsigned int width, amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, unsigned int pitch)
+{
+    amiVideo_ULong words[8];
+    unsigned int offset;
+    unsigned int x = 0;
+
+    for(offset = 0; offset < pitch; offset += 4)
+    {
+        unsigned int numOfPixels = x < width ? width - x : 0;
+        unsigned int numOfBytes = pitch - offset;
+        unsigned int i;
+
+        if(numOfBytes > 4)
+            numOfBytes = 4;
+
+        /* Put pixel 8 * n + i in byte n of word i, so that the transpose yields the bitplane words */
+        if(numOfPixels >= 32)
+        {
+            for(i = 0; i < 8; i++)
+                words[i] = ((amiVideo_ULong)pixels[x + i] << 24) | ((amiVideo_ULong)pixels[x + 8 + i] << 16) | ((amiVideo_ULong)pixels[x + 16 + i] << 8) | (amiVideo_ULong)pixels[x + 24 + i];
+        }
+        else
+        {
+            /* The padding bits beyond the width of the scanline become 0 */
+            for(i = 0; i < 8; i++)
+                words[i] = loadChunkyWord(pixels + x, i, numOfPixels);
+        }
+
+        transposeBitplaneWords(words);
+
+        /* Write each byte of each bitplane exactly once */
+        for(i = 0; i < bitplaneDepth; i++)
+        {
+            amiVideo_ULong word = words[7 - i];
+            amiVideo_UByte *bitplaneRow = bitplaneRows[i] + offset;
+
+            if(numOfBytes == 4)
+            {
+                bitplaneRow[0] = (amiVideo_UByte)(word >> 24);
+                bitplaneRow[1] = (amiVideo_UByte)(word >> 16);
+                bitplaneRow[2] = (amiVideo_UByte)(word >> 8);
+                bitplaneRow[3] = (amiVideo_UByte)word;
+            }
+            else
+            {
+                unsigned int j;
+
+                for(j = 0; j < numOfBytes; j++)
+                    bitplaneRow[j] = (amiVideo_UByte)(word >> (24 - 8 * j));
+            }
+        }
+
+        x += 32;
+    }
+}
+
+void amiVideo_alignBitplaneRow(const amiVideo_UByte *bitplaneRow, unsigned int bitOffset, unsigned int width, amiVideo_UByte *target)
+{
+    unsigned int numOfBytes = (width + 7) / 8;
+    unsigned int lastByte = (bitOffset + width - 1) / 8; /* Last byte of the source that contains a pixel */
+    unsigned int i;
+
+    for(i = 0; i < numOfBytes; i++)
+    {
+        unsigned int value = bitplaneRow[i] << bitOffset;
+
+        if(i < lastByte)
+            value |= bitplaneRow[i + 1] >> (8 - bitOffset);
+
+        target[i] = (amiVideo_UByte)value;
+    }
+}
+
+void amiVideo_storeAlignedBitplaneRow(const amiVideo_UByte *source, unsigned int width, unsigned int bitOffset, amiVideo_UByte *bitplaneRow)
+{
+    unsigned int numOfSourceBytes = (width + 7) / 8;
+    unsigned int lastBit = bitOffset + width;
+    unsigned int i;
+
+    for(i = 0; i < (lastBit + 7) / 8; i++)
+    {
+        unsigned int value = (i < numOfSourceBytes ? source[i] : 0) >> bitOffset;
+        unsigned int mask = 0xff;
+
+        if(i > 0)
+            value |= source[i - 1] << (8 - bitOffset);
+
+        /* Only replace the bits that are covered by the pixels */
+        if(i == 0)
+            mask &= 0xff >> bitOffset;
+
+        if(8 * i + 8 > lastBit)
+            mask &= 0xff << (8 * i + 8 - lastBit);
+
+        bitplaneRow[i] = (amiVideo_UByte)((bitplaneRow[i] & ~mask) | (value & mask));
+    }
+}
+
+static amiVideo_PlanarKernels kernels;
+static int kernelsSelected = 0;
+
+static void selectPlanarKernels(amiVideo_ULong features)
+{
+    kernels.convertBitplaneRowToChunkyPixels = amiVideo_convertBitplaneRowToChunkyPixelsScalar;
+    kernels.convertChunkyPixelsToBitplaneRow = amiVideo_convertChunkyPixelsToBitplaneRowScalar;
+
+#if defined(AMIVIDEO_HAVE_X86_SIMD)
+    if(features & AMIVIDEO_CPU_AVX2)
+    {
+        kernels.convertBitplaneRowToChunkyPixels = amiVideo_convertBitplaneRowToChunkyPixelsAVX2;
+        kernels.convertChunkyPixelsToBitplaneRow = amiVideo_convertChunkyPixelsToBitplaneRowAVX2;
+    }
+    else if(features & AMIVIDEO_CPU_SSE2)
+    {
+        kernels.convertBitplaneRowToChunkyPixels = amiVideo_convertBitplaneRowToChunkyPixelsSSE2;
+        kernels.convertChunkyPixelsToBitplaneRow = amiVideo_convertChunkyPixelsToBitplaneRowSSE2;
+    }
+#elif defined(AMIVIDEO_HAVE_NEON_SIMD)
+    if(features & AMIVIDEO_CPU_NEON)
+    {
+        kernels.convertBitplaneRowToChunkyPixels = amiVideo_convertBitplaneRowToChunkyPixelsNEON;
+        kernels.convertChunkyPixelsToBitplaneRow = amiVideo_convertChunkyPixelsToBitplaneRowNEON;
+    }
+#endif
+}
+
+const amiVideo_PlanarKernels *amiVideo_getPlanarKernels(void)
+{
+    if(!kernelsSelected)
+    {
+        selectPlanarKernels(amiVideo_getCPUFeatures());
+        kernelsSelected = 1;
+    }
+
+    return &kernels;
+}
+
+void amiVideo_resetPlanarKernels(void)
+{
+    kernelsSelected = 0;
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __AMIVIDEO_PLANAR_H
+#define __AMIVIDEO_PLANAR_H
+#include "amivideotypes.h"
+#include "simd.h"
+
+/** Amount of pixels that the fused conversions decode into an intermediate buffer on the stack at once */
+#define AMIVIDEO_ROW_CHUNK_SIZE 256
+
+/**
+ * Converts a scanline of bitplanes to chunky pixels.
+ *
+ * @param bitplaneRows Pointers to the start of the scanline in each bitplane
+ * @param bitplaneDepth Bitplane depth, a value between 1-8
+ * @param pixels Chunky pixel scanline in which each byte represents an index in the palette
+ * @param width Amount of pixels that must be converted
+ */
+typedef void (*amiVideo_BitplaneRowToChunkyPixelsKernel)(amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, amiVideo_UByte *pixels, unsigned int width);
+
+/**
+ * Converts a scanline of chunky pixels to bitplanes. Every byte of the
+ * bitplane scanlines is written exactly once and the padding bits beyond the
+ * width of the scanline are set to 0.
+ *
+ * @param pixels Chunky pixel scanline in which each byte represents an index in the palette
+ * @param width Amount of pixels that must be converted
+ * @param bitplaneRows Pointers to the start of the scanline in each bitplane
+ * @param bitplaneDepth Bitplane depth, a value between 1-8
+ * @param pitch Amount of bytes of a bitplane scanline (padded to the nearest word boundary)
+ */
+typedef void (*amiVideo_ChunkyPixelsToBitplaneRowKernel)(const amiVideo_UByte *pixels, unsigned int width, amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, unsigned int pitch);
+
+/**
+ * A dispatch table containing the most efficient conversion kernels that the
+ * processor supports.
+ */
+typedef struct
+{
+    amiVideo_BitplaneRowToChunkyPixelsKernel convertBitplaneRowToChunkyPixels;
+    amiVideo_ChunkyPixelsToBitplaneRowKernel convertChunkyPixelsToBitplaneRow;
+}
+amiVideo_PlanarKernels;
+
+/**
+ * Converts a scanline of bitplanes to chunky pixels. Pixels are processed in
+ * groups of 32 in which the corresponding bits of all bitplanes are merged
+ * with a bit-matrix transpose, so that every chunky byte is written only once.
+ */
+void amiVideo_convertBitplaneRowToChunkyPixelsScalar(amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, amiVideo_UByte *pixels, unsigned int width);
+
+/**
+ * Converts a scanline of chunky pixels to bitplanes by transposing groups of
+ * 32 pixels with the same merge network as the planar to chunky conversion.
+ */
+void amiVideo_convertChunkyPixelsToBitplaneRowScalar(const amiVideo_UByte *pixels, unsigned int width, amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, unsigned int pitch);
+
+#if defined(AMIVIDEO_HAVE_X86_SIMD)
+/**
+ * Converts a scanline of bitplanes to chunky pixels using SSE2 instructions.
+ * Pixels are processed in groups of 128.
+ */
+void amiVideo_convertBitplaneRowToChunkyPixelsSSE2(amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, amiVideo_UByte *pixels, unsigned int width);
+
+/**
+ * Converts a scanline of bitplanes to chunky pixels using AVX2 instructions.
+ * Pixels are processed in groups of 256.
+ */
+void amiVideo_convertBitplaneRowToChunkyPixelsAVX2(amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, amiVideo_UByte *pixels, unsigned int width);
+
+/**
+ * Converts a scanline of chunky pixels to bitplanes using SSE2 instructions.
+ * The bits of each bitplane are extracted from 16 pixels at once with a
+ * movemask instruction.
+ */
+void amiVideo_convertChunkyPixelsToBitplaneRowSSE2(const amiVideo_UByte *pixels, unsigned int width, amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, unsigned int pitch);
+
+/**
+ * Converts a scanline of chunky pixels to bitplanes using AVX2 instructions.
+ * The bits of each bitplane are extracted from 32 pixels at once with a
+ * movemask instruction.
+ */
+void amiVideo_convertChunkyPixelsToBitplaneRowAVX2(const amiVideo_UByte *pixels, unsigned int width, amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, unsigned int pitch);
+#endif
+
+#if defined(AMIVIDEO_HAVE_NEON_SIMD)
+/**
+ * Converts a scanline of bitplanes to chunky pixels using NEON instructions.
+ * Pixels are processed in groups of 128.
+ */
+void amiVideo_convertBitplaneRowToChunkyPixelsNEON(amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, amiVideo_UByte *pixels, unsigned int width);
+
+/**
+ * Converts a scanline of chunky pixels to bitplanes using NEON instructions.
+ * Pixels are processed in groups of 128 by reversing the byte interleaving and
+ * the merge network of the planar to chunky conversion.
+ */
+void amiVideo_convertChunkyPixelsToBitplaneRowNEON(const amiVideo_UByte *pixels, unsigned int width, amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, unsigned int pitch);
+#endif
+
+/**
+ * Copies a bitplane row of which the first pixel is not at a byte boundary
+ * into a byte aligned row, so that it can be decoded by the kernels. Only the
+ * bytes of the source that contain pixels are read.
+ *
+ * @param bitplaneRow Bitplane row of which the first pixel is at bit bitOffset of the first byte
+ * @param bitOffset Amount of pixels that precede the first pixel in the first byte, a value between 0-7
+ * @param width Amount of pixels that must be copied
+ * @param target Byte aligned bitplane row of (width + 7) / 8 bytes that receives the result
+ */
+void amiVideo_alignBitplaneRow(const amiVideo_UByte *bitplaneRow, unsigned int bitOffset, unsigned int width, amiVideo_UByte *target);
+
+/**
+ * Stores a byte aligned bitplane row in a bitplane row of which the first pixel
+ * is not at a byte boundary. The bits of the target that precede or follow the
+ * pixels are left untouched.
+ *
+ * @param source Byte aligned bitplane row
+ * @param width Amount of pixels that must be stored
+ * @param bitOffset Amount of pixels that precede the first pixel in the first byte of the target, a value between 0-7
+ * @param bitplaneRow Bitplane row that receives the pixels
+ */
+void amiVideo_storeAlignedBitplaneRow(const amiVideo_UByte *source, unsigned int width, unsigned int bitOffset, amiVideo_UByte *bitplaneRow);
+
+/**
+ * Returns the dispatch table with the most efficient kernels for the current
+ * processor. The kernels are selected the first time this function is invoked.
+ *
+ * @return A dispatch table with conversion kernels
+ */
+const amiVideo_PlanarKernels *amiVideo_getPlanarKernels(void);
+
+/**
+ * Discards the selected kernels so that they are selected again on the next
+ * request, e.g. after the usable processor features have been restricted.
+ */
+void amiVideo_resetPlanarKernels(void);
+
+#endif
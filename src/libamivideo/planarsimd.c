@@ -0,0 +1,496 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "planar.h"
+
+/*
+ * The vectorized planar to chunky kernels use the same merge network as the
+ * scalar kernel, but they transpose the 8x8 bit matrices of 16 (or 32) byte
+ * columns at once. Afterwards, vector n contains pixel n of every column.
+ * Three rounds of byte interleaving put the pixels in their final order.
+ */
+
+#if defined(AMIVIDEO_HAVE_X86_SIMD) || defined(AMIVIDEO_HAVE_NEON_SIMD)
+
+#if defined(AMIVIDEO_HAVE_X86_SIMD)
+#include <immintrin.h>
+#else
+#include <arm_neon.h>
+#endif
+
+static void convertRemainingPixels(amiVideo_BitplaneRowToChunkyPixelsKernel kernel, amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, unsigned int offset, amiVideo_UByte *pixels, unsigned int width)
+{
+    if(width > 0)
+    {
+        amiVideo_UByte *remainingRows[8];
+        unsigned int i;
+
+        for(i = 0; i < bitplaneDepth; i++)
+            remainingRows[i] = bitplaneRows[i] + offset;
+
+        kernel(remainingRows, bitplaneDepth, pixels, width);
+    }
+}
+
+static void convertRemainingChunkyPixels(amiVideo_ChunkyPixelsToBitplaneRowKernel kernel, const amiVideo_UByte *pixels, unsigned int width, amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, unsigned int offset, unsigned int pitch)
+{
+    if(offset < pitch)
+    {
+        amiVideo_UByte *remainingRows[8];
+        unsigned int i;
+
+        for(i = 0; i < bitplaneDepth; i++)
+            remainingRows[i] = bitplaneRows[i] + offset;
+
+        kernel(pixels, width, remainingRows, bitplaneDepth, pitch - offset);
+    }
+}
+
+#if defined(AMIVIDEO_HAVE_X86_SIMD)
+
+#define SWAP_BIT_BLOCKS_SSE2(upper, lower, shift, mask) \
+    { \
+        __m128i t = _mm_and_si128(_mm_xor_si128(upper, _mm_srli_epi16(lower, shift)), mask); \
+        upper = _mm_xor_si128(upper, t); \
+        lower = _mm_xor_si128(lower, _mm_slli_epi16(t, shift)); \
+    }
+
+AMIVIDEO_TARGET_SSE2 static __m128i loadBitplaneVectorSSE2(amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, unsigned int index, unsigned int offset)
+{
+    if(index < bitplaneDepth)
+        return _mm_loadu_si128((const __m128i*)(bitplaneRows[index] + offset));
+    else
+        return _mm_setzero_si128(); /* Absent bitplanes contribute nothing to the index value */
+}
+
+AMIVIDEO_TARGET_SSE2 void amiVideo_convertBitplaneRowToChunkyPixelsSSE2(amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, amiVideo_UByte *pixels, unsigned int width)
+{
+    const __m128i mask4 = _mm_set1_epi8(0x0f);
+    const __m128i mask2 = _mm_set1_epi8(0x33);
+    const __m128i mask1 = _mm_set1_epi8(0x55);
+    unsigned int x;
+    unsigned int offset = 0;
+
+    for(x = 0; x + 128 <= width; x += 128)
+    {
+        /* The most significant bitplane comes first */
+        __m128i v0 = loadBitplaneVectorSSE2(bitplaneRows, bitplaneDepth, 7, offset);
+        __m128i v1 = loadBitplaneVectorSSE2(bitplaneRows, bitplaneDepth, 6, offset);
+        __m128i v2 = loadBitplaneVectorSSE2(bitplaneRows, bitplaneDepth, 5, offset);
+        __m128i v3 = loadBitplaneVectorSSE2(bitplaneRows, bitplaneDepth, 4, offset);
+        __m128i v4 = loadBitplaneVectorSSE2(bitplaneRows, bitplaneDepth, 3, offset);
+        __m128i v5 = loadBitplaneVectorSSE2(bitplaneRows, bitplaneDepth, 2, offset);
+        __m128i v6 = loadBitplaneVectorSSE2(bitplaneRows, bitplaneDepth, 1, offset);
+        __m128i v7 = loadBitplaneVectorSSE2(bitplaneRows, bitplaneDepth, 0, offset);
+        __m128i a0, a1, a2, a3, a4, a5, a6, a7;
+        __m128i b0, b1, b2, b3, b4, b5, b6, b7;
+        __m128i *output = (__m128i*)(pixels + x);
+
+        /* Transpose the 8x8 bit matrix of each byte column */
+        SWAP_BIT_BLOCKS_SSE2(v0, v4, 4, mask4);
+        SWAP_BIT_BLOCKS_SSE2(v1, v5, 4, mask4);
+        SWAP_BIT_BLOCKS_SSE2(v2, v6, 4, mask4);
+        SWAP_BIT_BLOCKS_SSE2(v3, v7, 4, mask4);
+        SWAP_BIT_BLOCKS_SSE2(v0, v2, 2, mask2);
+        SWAP_BIT_BLOCKS_SSE2(v1, v3, 2, mask2);
+        SWAP_BIT_BLOCKS_SSE2(v4, v6, 2, mask2);
+        SWAP_BIT_BLOCKS_SSE2(v5, v7, 2, mask2);
+        SWAP_BIT_BLOCKS_SSE2(v0, v1, 1, mask1);
+        SWAP_BIT_BLOCKS_SSE2(v2, v3, 1, mask1);
+        SWAP_BIT_BLOCKS_SSE2(v4, v5, 1, mask1);
+        SWAP_BIT_BLOCKS_SSE2(v6, v7, 1, mask1);
+
+        /* Interleave the bytes, so that the pixels of each column become adjacent */
+        a0 = _mm_unpacklo_epi8(v0, v1);
+        a1 = _mm_unpackhi_epi8(v0, v1);
+        a2 = _mm_unpacklo_epi8(v2, v3);
+        a3 = _mm_unpackhi_epi8(v2, v3);
+        a4 = _mm_unpacklo_epi8(v4, v5);
+        a5 = _mm_unpackhi_epi8(v4, v5);
+        a6 = _mm_unpacklo_epi8(v6, v7);
+        a7 = _mm_unpackhi_epi8(v6, v7);
+
+        b0 = _mm_unpacklo_epi16(a0, a2);
+        b1 = _mm_unpackhi_epi16(a0, a2);
+        b2 = _mm_unpacklo_epi16(a1, a3);
+        b3 = _mm_unpackhi_epi16(a1, a3);
+        b4 = _mm_unpacklo_epi16(a4, a6);
+        b5 = _mm_unpackhi_epi16(a4, a6);
+        b6 = _mm_unpacklo_epi16(a5, a7);
+        b7 = _mm_unpackhi_epi16(a5, a7);
+
+        _mm_storeu_si128(output, _mm_unpacklo_epi32(b0, b4));
+        _mm_storeu_si128(output + 1, _mm_unpackhi_epi32(b0, b4));
+        _mm_storeu_si128(output + 2, _mm_unpacklo_epi32(b1, b5));
+        _mm_storeu_si128(output + 3, _mm_unpackhi_epi32(b1, b5));
+        _mm_storeu_si128(output + 4, _mm_unpacklo_epi32(b2, b6));
+        _mm_storeu_si128(output + 5, _mm_unpackhi_epi32(b2, b6));
+        _mm_storeu_si128(output + 6, _mm_unpacklo_epi32(b3, b7));
+        _mm_storeu_si128(output + 7, _mm_unpackhi_epi32(b3, b7));
+
+        offset += 16;
+    }
+
+    convertRemainingPixels(amiVideo_convertBitplaneRowToChunkyPixelsScalar, bitplaneRows, bitplaneDepth, offset, pixels + x, width - x);
+}
+
+AMIVIDEO_TARGET_SSE2 static __m128i reversePixelOrderSSE2(__m128i pixels)
+{
+    /* Reverse the order of the 16-bit words and then the order of the bytes within each word */
+    pixels = _mm_shufflelo_epi16(pixels, _MM_SHUFFLE(0, 1, 2, 3));
+    pixels = _mm_shufflehi_epi16(pixels, _MM_SHUFFLE(0, 1, 2, 3));
+    return _mm_or_si128(_mm_slli_epi16(pixels, 8), _mm_srli_epi16(pixels, 8));
+}
+
+AMIVIDEO_TARGET_SSE2 void amiVideo_convertChunkyPixelsToBitplaneRowSSE2(const amiVideo_UByte *pixels, unsigned int width, amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, unsigned int pitch)
+{
+    unsigned int x;
+    unsigned int offset = 0;
+
+    for(x = 0; x + 16 <= width; x += 16)
+    {
+        /* Reverse the pixels of each group of 8, so that the first pixel ends up in the most significant bit of a bitplane byte */
+        __m128i v = reversePixelOrderSSE2(_mm_loadu_si128((const __m128i*)(pixels + x)));
+        unsigned int i;
+
+        /* Move the bit of the most significant bitplane into the sign bit of each byte */
+        for(i = 8; i > bitplaneDepth; i--)
+            v = _mm_add_epi8(v, v);
+
+        while(i > 0)
+        {
+            int mask = _mm_movemask_epi8(v);
+
+            i--;
+            bitplaneRows[i][offset] = (amiVideo_UByte)mask;
+            bitplaneRows[i][offset + 1] = (amiVideo_UByte)(mask >> 8);
+
+            v = _mm_add_epi8(v, v);
+        }
+
+        offset += 2;
+    }
+
+    convertRemainingChunkyPixels(amiVideo_convertChunkyPixelsToBitplaneRowScalar, pixels + x, width - x, bitplaneRows, bitplaneDepth, offset, pitch);
+}
+
+#define SWAP_BIT_BLOCKS_AVX2(upper, lower, shift, mask) \
+    { \
+        __m256i t = _mm256_and_si256(_mm256_xor_si256(upper, _mm256_srli_epi16(lower, shift)), mask); \
+        upper = _mm256_xor_si256(upper, t); \
+        lower = _mm256_xor_si256(lower, _mm256_slli_epi16(t, shift)); \
+    }
+
+AMIVIDEO_TARGET_AVX2 static __m256i loadBitplaneVectorAVX2(amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, unsigned int index, unsigned int offset)
+{
+    if(index < bitplaneDepth)
+        return _mm256_loadu_si256((const __m256i*)(bitplaneRows[index] + offset));
+    else
+        return _mm256_setzero_si256(); /* Absent bitplanes contribute nothing to the index value */
+}
+
+AMIVIDEO_TARGET_AVX2 void amiVideo_convertBitplaneRowToChunkyPixelsAVX2(amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, amiVideo_UByte *pixels, unsigned int width)
+{
+    const __m256i mask4 = _mm256_set1_epi8(0x0f);
+    const __m256i mask2 = _mm256_set1_epi8(0x33);
+    const __m256i mask1 = _mm256_set1_epi8(0x55);
+    unsigned int x;
+    unsigned int offset = 0;
+
+    for(x = 0; x + 256 <= width; x += 256)
+    {
+        /* The most significant bitplane comes first */
+        __m256i v0 = loadBitplaneVectorAVX2(bitplaneRows, bitplaneDepth, 7, offset);
+        __m256i v1 = loadBitplaneVectorAVX2(bitplaneRows, bitplaneDepth, 6, offset);
+        __m256i v2 = loadBitplaneVectorAVX2(bitplaneRows, bitplaneDepth, 5, offset);
+        __m256i v3 = loadBitplaneVectorAVX2(bitplaneRows, bitplaneDepth, 4, offset);
+        __m256i v4 = loadBitplaneVectorAVX2(bitplaneRows, bitplaneDepth, 3, offset);
+        __m256i v5 = loadBitplaneVectorAVX2(bitplaneRows, bitplaneDepth, 2, offset);
+        __m256i v6 = loadBitplaneVectorAVX2(bitplaneRows, bitplaneDepth, 1, offset);
+        __m256i v7 = loadBitplaneVectorAVX2(bitplaneRows, bitplaneDepth, 0, offset);
+        __m256i a0, a1, a2, a3, a4, a5, a6, a7;
+        __m256i b0, b1, b2, b3, b4, b5, b6, b7;
+        __m256i c0, c1, c2, c3, c4, c5, c6, c7;
+        __m256i *output = (__m256i*)(pixels + x);
+
+        /* Transpose the 8x8 bit matrix of each byte column */
+        SWAP_BIT_BLOCKS_AVX2(v0, v4, 4, mask4);
+        SWAP_BIT_BLOCKS_AVX2(v1, v5, 4, mask4);
+        SWAP_BIT_BLOCKS_AVX2(v2, v6, 4, mask4);
+        SWAP_BIT_BLOCKS_AVX2(v3, v7, 4, mask4);
+        SWAP_BIT_BLOCKS_AVX2(v0, v2, 2, mask2);
+        SWAP_BIT_BLOCKS_AVX2(v1, v3, 2, mask2);
+        SWAP_BIT_BLOCKS_AVX2(v4, v6, 2, mask2);
+        SWAP_BIT_BLOCKS_AVX2(v5, v7, 2, mask2);
+        SWAP_BIT_BLOCKS_AVX2(v0, v1, 1, mask1);
+        SWAP_BIT_BLOCKS_AVX2(v2, v3, 1, mask1);
+        SWAP_BIT_BLOCKS_AVX2(v4, v5, 1, mask1);
+        SWAP_BIT_BLOCKS_AVX2(v6, v7, 1, mask1);
+
+        /* Interleave the bytes within each 128-bit lane */
+        a0 = _mm256_unpacklo_epi8(v0, v1);
+        a1 = _mm256_unpackhi_epi8(v0, v1);
+        a2 = _mm256_unpacklo_epi8(v2, v3);
+        a3 = _mm256_unpackhi_epi8(v2, v3);
+        a4 = _mm256_unpacklo_epi8(v4, v5);
+        a5 = _mm256_unpackhi_epi8(v4, v5);
+        a6 = _mm256_unpacklo_epi8(v6, v7);
+        a7 = _mm256_unpackhi_epi8(v6, v7);
+
+        b0 = _mm256_unpacklo_epi16(a0, a2);
+        b1 = _mm256_unpackhi_epi16(a0, a2);
+        b2 = _mm256_unpacklo_epi16(a1, a3);
+        b3 = _mm256_unpackhi_epi16(a1, a3);
+        b4 = _mm256_unpacklo_epi16(a4, a6);
+        b5 = _mm256_unpackhi_epi16(a4, a6);
+        b6 = _mm256_unpacklo_epi16(a5, a7);
+        b7 = _mm256_unpackhi_epi16(a5, a7);
+
+        c0 = _mm256_unpacklo_epi32(b0, b4);
+        c1 = _mm256_unpackhi_epi32(b0, b4);
+        c2 = _mm256_unpacklo_epi32(b1, b5);
+        c3 = _mm256_unpackhi_epi32(b1, b5);
+        c4 = _mm256_unpacklo_epi32(b2, b6);
+        c5 = _mm256_unpackhi_epi32(b2, b6);
+        c6 = _mm256_unpacklo_epi32(b3, b7);
+        c7 = _mm256_unpackhi_epi32(b3, b7);
+
+        /* The lower lanes contain the first 128 pixels, the upper lanes the last 128 */
+        _mm256_storeu_si256(output, _mm256_permute2x128_si256(c0, c1, 0x20));
+        _mm256_storeu_si256(output + 1, _mm256_permute2x128_si256(c2, c3, 0x20));
+        _mm256_storeu_si256(output + 2, _mm256_permute2x128_si256(c4, c5, 0x20));
+        _mm256_storeu_si256(output + 3, _mm256_permute2x128_si256(c6, c7, 0x20));
+        _mm256_storeu_si256(output + 4, _mm256_permute2x128_si256(c0, c1, 0x31));
+        _mm256_storeu_si256(output + 5, _mm256_permute2x128_si256(c2, c3, 0x31));
+        _mm256_storeu_si256(output + 6, _mm256_permute2x128_si256(c4, c5, 0x31));
+        _mm256_storeu_si256(output + 7, _mm256_permute2x128_si256(c6, c7, 0x31));
+
+        offset += 32;
+    }
+
+    convertRemainingPixels(amiVideo_convertBitplaneRowToChunkyPixelsSSE2, bitplaneRows, bitplaneDepth, offset, pixels + x, width - x);
+}
+
+AMIVIDEO_TARGET_AVX2 void amiVideo_convertChunkyPixelsToBitplaneRowAVX2(const amiVideo_UByte *pixels, unsigned int width, amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, unsigned int pitch)
+{
+    const __m256i reverse = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    unsigned int x;
+    unsigned int offset = 0;
+
+    for(x = 0; x + 32 <= width; x += 32)
+    {
+        /* Reverse the pixels of each group of 8, so that the first pixel ends up in the most significant bit of a bitplane byte */
+        __m256i v = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(pixels + x)), reverse);
+        unsigned int i;
+
+        /* Move the bit of the most significant bitplane into the sign bit of each byte */
+        for(i = 8; i > bitplaneDepth; i--)
+            v = _mm256_add_epi8(v, v);
+
+        while(i > 0)
+        {
+            amiVideo_ULong mask = (amiVideo_ULong)_mm256_movemask_epi8(v);
+            amiVideo_UByte *bitplaneRow;
+
+            i--;
+            bitplaneRow = bitplaneRows[i] + offset;
+            bitplaneRow[0] = (amiVideo_UByte)mask;
+            bitplaneRow[1] = (amiVideo_UByte)(mask >> 8);
+            bitplaneRow[2] = (amiVideo_UByte)(mask >> 16);
+            bitplaneRow[3] = (amiVideo_UByte)(mask >> 24);
+
+            v = _mm256_add_epi8(v, v);
+        }
+
+        offset += 4;
+    }
+
+    convertRemainingChunkyPixels(amiVideo_convertChunkyPixelsToBitplaneRowSSE2, pixels + x, width - x, bitplaneRows, bitplaneDepth, offset, pitch);
+}
+
+#endif
+
+#if defined(AMIVIDEO_HAVE_NEON_SIMD)
+
+#define SWAP_BIT_BLOCKS_NEON(upper, lower, shift, mask) \
+    { \
+        uint8x16_t t = vandq_u8(veorq_u8(upper, vshrq_n_u8(lower, shift)), mask); \
+        upper = veorq_u8(upper, t); \
+        lower = veorq_u8(lower, vshlq_n_u8(t, shift)); \
+    }
+
+static uint8x16_t loadBitplaneVectorNEON(amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, unsigned int index, unsigned int offset)
+{
+    if(index < bitplaneDepth)
+        return vld1q_u8(bitplaneRows[index] + offset);
+    else
+        return vdupq_n_u8(0); /* Absent bitplanes contribute nothing to the index value */
+}
+
+void amiVideo_convertBitplaneRowToChunkyPixelsNEON(amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, amiVideo_UByte *pixels, unsigned int width)
+{
+    const uint8x16_t mask4 = vdupq_n_u8(0x0f);
+    const uint8x16_t mask2 = vdupq_n_u8(0x33);
+    const uint8x16_t mask1 = vdupq_n_u8(0x55);
+    unsigned int x;
+    unsigned int offset = 0;
+
+    for(x = 0; x + 128 <= width; x += 128)
+    {
+        /* The most significant bitplane comes first */
+        uint8x16_t v0 = loadBitplaneVectorNEON(bitplaneRows, bitplaneDepth, 7, offset);
+        uint8x16_t v1 = loadBitplaneVectorNEON(bitplaneRows, bitplaneDepth, 6, offset);
+        uint8x16_t v2 = loadBitplaneVectorNEON(bitplaneRows, bitplaneDepth, 5, offset);
+        uint8x16_t v3 = loadBitplaneVectorNEON(bitplaneRows, bitplaneDepth, 4, offset);
+        uint8x16_t v4 = loadBitplaneVectorNEON(bitplaneRows, bitplaneDepth, 3, offset);
+        uint8x16_t v5 = loadBitplaneVectorNEON(bitplaneRows, bitplaneDepth, 2, offset);
+        uint8x16_t v6 = loadBitplaneVectorNEON(bitplaneRows, bitplaneDepth, 1, offset);
+        uint8x16_t v7 = loadBitplaneVectorNEON(bitplaneRows, bitplaneDepth, 0, offset);
+        uint8x16x2_t a01, a23, a45, a67;
+        uint16x8x2_t b02, b13, b46, b57;
+        uint32x4x2_t c01, c23, c45, c67;
+        amiVideo_UByte *output = pixels + x;
+
+        /* Transpose the 8x8 bit matrix of each byte column */
+        SWAP_BIT_BLOCKS_NEON(v0, v4, 4, mask4);
+        SWAP_BIT_BLOCKS_NEON(v1, v5, 4, mask4);
+        SWAP_BIT_BLOCKS_NEON(v2, v6, 4, mask4);
+        SWAP_BIT_BLOCKS_NEON(v3, v7, 4, mask4);
+        SWAP_BIT_BLOCKS_NEON(v0, v2, 2, mask2);
+        SWAP_BIT_BLOCKS_NEON(v1, v3, 2, mask2);
+        SWAP_BIT_BLOCKS_NEON(v4, v6, 2, mask2);
+        SWAP_BIT_BLOCKS_NEON(v5, v7, 2, mask2);
+        SWAP_BIT_BLOCKS_NEON(v0, v1, 1, mask1);
+        SWAP_BIT_BLOCKS_NEON(v2, v3, 1, mask1);
+        SWAP_BIT_BLOCKS_NEON(v4, v5, 1, mask1);
+        SWAP_BIT_BLOCKS_NEON(v6, v7, 1, mask1);
+
+        /* Interleave the bytes, so that the pixels of each column become adjacent */
+        a01 = vzipq_u8(v0, v1);
+        a23 = vzipq_u8(v2, v3);
+        a45 = vzipq_u8(v4, v5);
+        a67 = vzipq_u8(v6, v7);
+
+        b02 = vzipq_u16(vreinterpretq_u16_u8(a01.val[0]), vreinterpretq_u16_u8(a23.val[0]));
+        b13 = vzipq_u16(vreinterpretq_u16_u8(a01.val[1]), vreinterpretq_u16_u8(a23.val[1]));
+        b46 = vzipq_u16(vreinterpretq_u16_u8(a45.val[0]), vreinterpretq_u16_u8(a67.val[0]));
+        b57 = vzipq_u16(vreinterpretq_u16_u8(a45.val[1]), vreinterpretq_u16_u8(a67.val[1]));
+
+        c01 = vzipq_u32(vreinterpretq_u32_u16(b02.val[0]), vreinterpretq_u32_u16(b46.val[0]));
+        c23 = vzipq_u32(vreinterpretq_u32_u16(b02.val[1]), vreinterpretq_u32_u16(b46.val[1]));
+        c45 = vzipq_u32(vreinterpretq_u32_u16(b13.val[0]), vreinterpretq_u32_u16(b57.val[0]));
+        c67 = vzipq_u32(vreinterpretq_u32_u16(b13.val[1]), vreinterpretq_u32_u16(b57.val[1]));
+
+        vst1q_u8(output, vreinterpretq_u8_u32(c01.val[0]));
+        vst1q_u8(output + 16, vreinterpretq_u8_u32(c01.val[1]));
+        vst1q_u8(output + 32, vreinterpretq_u8_u32(c23.val[0]));
+        vst1q_u8(output + 48, vreinterpretq_u8_u32(c23.val[1]));
+        vst1q_u8(output + 64, vreinterpretq_u8_u32(c45.val[0]));
+        vst1q_u8(output + 80, vreinterpretq_u8_u32(c45.val[1]));
+        vst1q_u8(output + 96, vreinterpretq_u8_u32(c67.val[0]));
+        vst1q_u8(output + 112, vreinterpretq_u8_u32(c67.val[1]));
+
+        offset += 16;
+    }
+
+    convertRemainingPixels(amiVideo_convertBitplaneRowToChunkyPixelsScalar, bitplaneRows, bitplaneDepth, offset, pixels + x, width - x);
+}
+
+static void storeBitplaneVectorNEON(amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, unsigned int index, unsigned int offset, uint8x16_t v)
+{
+    if(index < bitplaneDepth)
+        vst1q_u8(bitplaneRows[index] + offset, v);
+}
+
+void amiVideo_convertChunkyPixelsToBitplaneRowNEON(const amiVideo_UByte *pixels, unsigned int width, amiVideo_UByte **bitplaneRows, unsigned int bitplaneDepth, unsigned int pitch)
+{
+    const uint8x16_t mask4 = vdupq_n_u8(0x0f);
+    const uint8x16_t mask2 = vdupq_n_u8(0x33);
+    const uint8x16_t mask1 = vdupq_n_u8(0x55);
+    unsigned int x;
+    unsigned int offset = 0;
+
+    for(x = 0; x + 128 <= width; x += 128)
+    {
+        const amiVideo_UByte *input = pixels + x;
+        uint32x4x2_t b04, b15, b26, b37;
+        uint16x8x2_t a02, a46, a13, a57;
+        uint8x16x2_t v01, v23, v45, v67;
+        uint8x16_t v0, v1, v2, v3, v4, v5, v6, v7;
+
+        /* Undo the byte interleaving, so that vector n contains pixel n of every byte column */
+        b04 = vuzpq_u32(vreinterpretq_u32_u8(vld1q_u8(input)), vreinterpretq_u32_u8(vld1q_u8(input + 16)));
+        b15 = vuzpq_u32(vreinterpretq_u32_u8(vld1q_u8(input + 32)), vreinterpretq_u32_u8(vld1q_u8(input + 48)));
+        b26 = vuzpq_u32(vreinterpretq_u32_u8(vld1q_u8(input + 64)), vreinterpretq_u32_u8(vld1q_u8(input + 80)));
+        b37 = vuzpq_u32(vreinterpretq_u32_u8(vld1q_u8(input + 96)), vreinterpretq_u32_u8(vld1q_u8(input + 112)));
+
+        a02 = vuzpq_u16(vreinterpretq_u16_u32(b04.val[0]), vreinterpretq_u16_u32(b15.val[0]));
+        a13 = vuzpq_u16(vreinterpretq_u16_u32(b26.val[0]), vreinterpretq_u16_u32(b37.val[0]));
+        a46 = vuzpq_u16(vreinterpretq_u16_u32(b04.val[1]), vreinterpretq_u16_u32(b15.val[1]));
+        a57 = vuzpq_u16(vreinterpretq_u16_u32(b26.val[1]), vreinterpretq_u16_u32(b37.val[1]));
+
+        v01 = vuzpq_u8(vreinterpretq_u8_u16(a02.val[0]), vreinterpretq_u8_u16(a13.val[0]));
+        v23 = vuzpq_u8(vreinterpretq_u8_u16(a02.val[1]), vreinterpretq_u8_u16(a13.val[1]));
+        v45 = vuzpq_u8(vreinterpretq_u8_u16(a46.val[0]), vreinterpretq_u8_u16(a57.val[0]));
+        v67 = vuzpq_u8(vreinterpretq_u8_u16(a46.val[1]), vreinterpretq_u8_u16(a57.val[1]));
+
+        v0 = v01.val[0];
+        v1 = v01.val[1];
+        v2 = v23.val[0];
+        v3 = v23.val[1];
+        v4 = v45.val[0];
+        v5 = v45.val[1];
+        v6 = v67.val[0];
+        v7 = v67.val[1];
+
+        /* Transpose the 8x8 bit matrix of each byte column back */
+        SWAP_BIT_BLOCKS_NEON(v0, v4, 4, mask4);
+        SWAP_BIT_BLOCKS_NEON(v1, v5, 4, mask4);
+        SWAP_BIT_BLOCKS_NEON(v2, v6, 4, mask4);
+        SWAP_BIT_BLOCKS_NEON(v3, v7, 4, mask4);
+        SWAP_BIT_BLOCKS_NEON(v0, v2, 2, mask2);
+        SWAP_BIT_BLOCKS_NEON(v1, v3, 2, mask2);
+        SWAP_BIT_BLOCKS_NEON(v4, v6, 2, mask2);
+        SWAP_BIT_BLOCKS_NEON(v5, v7, 2, mask2);
+        SWAP_BIT_BLOCKS_NEON(v0, v1, 1, mask1);
+        SWAP_BIT_BLOCKS_NEON(v2, v3, 1, mask1);
+        SWAP_BIT_BLOCKS_NEON(v4, v5, 1, mask1);
+        SWAP_BIT_BLOCKS_NEON(v6, v7, 1, mask1);
+
+        /* The most significant bitplane comes first */
+        storeBitplaneVectorNEON(bitplaneRows, bitplaneDepth, 7, offset, v0);
+        storeBitplaneVectorNEON(bitplaneRows, bitplaneDepth, 6, offset, v1);
+        storeBitplaneVectorNEON(bitplaneRows, bitplaneDepth, 5, offset, v2);
+        storeBitplaneVectorNEON(bitplaneRows, bitplaneDepth, 4, offset, v3);
+        storeBitplaneVectorNEON(bitplaneRows, bitplaneDepth, 3, offset, v4);
+        storeBitplaneVectorNEON(bitplaneRows, bitplaneDepth, 2, offset, v5);
+        storeBitplaneVectorNEON(bitplaneRows, bitplaneDepth, 1, offset, v6);
+        storeBitplaneVectorNEON(bitplaneRows, bitplaneDepth, 0, offset, v7);
+
+        offset += 16;
+    }
+
+    convertRemainingChunkyPixels(amiVideo_convertChunkyPixelsToBitplaneRowScalar, pixels + x, width - x, bitplaneRows, bitplaneDepth, offset, pitch);
+}
+
+#endif
+
+#endif
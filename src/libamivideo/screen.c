@@ -2,14 +2,36 @@
 #include <stdlib.h>
 #include <string.h>
 #include "viewportmode.h"
+#include "planar.h"
+#include "correction.h"
+#include "threads.h"
+#include "ham.h"
+#include "pixelformat.h"
+#include "swizzle.h"
+#include "instrumentation.h"
 
 #define TRUE 1
 #define FALSE 0
 
-void amiVideo_initScreen(amiVideo_Screen *screen, amiVideo_Word width, amiVideo_Word height, unsigned int bitplaneDepth, unsigned int bitsPerColorChannel, amiVideo_Long viewportMode)
+static void setBitplanePitch(amiVideo_Screen *screen)
 {
-    unsigned int scanLineSizeInWords;
+    /* Calculate the pitch of the bitplanes. The width in bytes is rounded to the nearest word boundary */
+
+    unsigned int scanLineSizeInWords = screen->width / 16;
+
+    if(screen->width % 16 != 0)
+        scanLineSizeInWords++;
+
+    screen->bitplaneFormat.pitch = scanLineSizeInWords * 2;
+    screen->bitplaneFormat.rowStride = screen->bitplaneFormat.pitch; /* Bitplanes are stored separately by default */
+    screen->bitplaneFormat.bitOffset = 0;
+    screen->bitplaneFormat.numOfWrapRows = 0;
+    screen->bitplaneFormat.firstRow = 0;
+    screen->bitplaneFormat.playfield = FALSE;
+}
 
+void amiVideo_initScreen(amiVideo_Screen *screen, amiVideo_Word width, amiVideo_Word height, unsigned int bitplaneDepth, unsigned int bitsPerColorChannel, amiVideo_Long viewportMode)
+{
     /* Assign values */
     screen->width = width;
     screen->height = height;
@@ -20,18 +42,91 @@ void amiVideo_initScreen(amiVideo_Screen *screen, amiVideo_Word width, amiVideo_
     screen->bitplaneFormat.memoryAllocated = FALSE;
     screen->uncorrectedChunkyFormat.memoryAllocated = FALSE;
     screen->uncorrectedRGBFormat.memoryAllocated = FALSE;
+    screen->uncorrectedChunkyFormat.pixels = NULL;
+    screen->uncorrectedRGBFormat.pixels = NULL;
+
+    /* Use the pixel formats of the original chunky and RGB surfaces by default */
+    screen->uncorrectedChunkyFormat.pixelFormat = AMIVIDEO_PIXEL_FORMAT_CHUNKY8;
+    screen->uncorrectedRGBFormat.pixelFormat = AMIVIDEO_PIXEL_FORMAT_RGB32;
+    screen->correctedFormat.pixelFormat = AMIVIDEO_PIXEL_FORMAT_CHUNKY8;
+
+    /* The aspect ratio is not corrected until a scale factor has been set */
+    screen->correctedFormat.lowresPixelScaleFactor = 0;
+    screen->correctedFormat.width = 0;
+    screen->correctedFormat.height = 0;
+
+    /* Incremental conversion is disabled by default */
+    screen->incrementalFormat.enabled = FALSE;
+    screen->incrementalFormat.previousBitplanes = NULL;
+    screen->incrementalFormat.previousBitplanesSize = 0;
+    screen->incrementalFormat.previousValid = FALSE;
+    screen->incrementalFormat.dirtyRows = NULL;
+    screen->incrementalFormat.numOfDirtyRows = 0;
+    screen->incrementalFormat.maxNumOfDirtyRows = 0;
+
+    /* Delta conversion is disabled by default */
+    screen->deltaFormat.enabled = FALSE;
+    screen->deltaFormat.valid = FALSE;
+    screen->deltaFormat.touchedRows = NULL;
+    screen->deltaFormat.dirtyRows = NULL;
+    screen->deltaFormat.numOfDirtyRows = 0;
+    screen->deltaFormat.maxHeight = 0;
+    screen->deltaFormat.numOfDeltas = 0;
+    memset(screen->deltaFormat.previousValid, '\0', sizeof(screen->deltaFormat.previousValid));
+    memset(screen->deltaFormat.previousSettings, '\0', sizeof(screen->deltaFormat.previousSettings));
+
+    /* The registers do not change within a frame by default */
+    screen->registerFormat.changes = NULL;
+    screen->registerFormat.numOfChanges = 0;
+    screen->registerFormat.version = 0;
+    screen->registerFormat.state = NULL;
+
+    amiVideo_resetScreenStats(screen);
 
     /* Sets the palette */
     amiVideo_initPalette(&screen->palette, bitplaneDepth, bitsPerColorChannel, viewportMode);
 
-    /* Calculate the pitch of the bitplanes. The width in bytes is rounded to the nearest word boundary */
+    setBitplanePitch(screen);
+}
 
-    scanLineSizeInWords = screen->width / 16;
+int amiVideo_reinitScreen(amiVideo_Screen *screen, amiVideo_Word width, amiVideo_Word height, unsigned int bitplaneDepth, unsigned int bitsPerColorChannel, amiVideo_Long viewportMode)
+{
+    int sizeChanged = width != screen->width || height != screen->height || bitplaneDepth != screen->bitplaneDepth;
+    int status = TRUE;
 
-    if(screen->width % 16 != 0)
-        scanLineSizeInWords++;
+    if(sizeChanged || viewportMode != screen->viewportMode || bitsPerColorChannel != screen->palette.bitplaneFormat.bitsPerColorChannel)
+        screen->registerFormat.version++; /* The register changes are applied to a different palette */
 
-    screen->bitplaneFormat.pitch = scanLineSizeInWords * 2;
+    /* The target surfaces do not contain a conversion of the new frame, so neither the previous frame nor the last delta can be used to skip scanlines */
+    screen->incrementalFormat.previousValid = FALSE;
+    screen->deltaFormat.valid = FALSE;
+    memset(screen->deltaFormat.previousValid, '\0', sizeof(screen->deltaFormat.previousValid));
+
+    /* Assign values */
+    screen->width = width;
+    screen->height = height;
+    screen->bitplaneDepth = bitplaneDepth;
+    screen->viewportMode = viewportMode;
+
+    /* Reuse the storage of the palette */
+    amiVideo_reinitPalette(&screen->palette, bitplaneDepth, bitsPerColorChannel, viewportMode);
+
+    setBitplanePitch(screen);
+
+    if(sizeChanged)
+    {
+        /* Buffers that depend on the dimensions are only allocated again when they no longer fit */
+        if(screen->incrementalFormat.enabled && !amiVideo_setScreenIncrementalConversion(screen, TRUE))
+            status = FALSE;
+
+        if(screen->deltaFormat.enabled && !amiVideo_setScreenDeltaConversion(screen, TRUE))
+            status = FALSE;
+    }
+
+    /* Keep correcting the aspect ratio with the same scale factor */
+    amiVideo_setLowresPixelScaleFactor(screen, screen->correctedFormat.lowresPixelScaleFactor);
+
+    return status;
 }
 
 amiVideo_Screen *amiVideo_createScreen(amiVideo_Word width, amiVideo_Word height, unsigned int bitplaneDepth, unsigned int bitsPerColorChannel, amiVideo_Long viewportMode)
@@ -49,11 +144,11 @@ void amiVideo_cleanupScreen(amiVideo_Screen *screen)
 {
     amiVideo_cleanupPalette(&screen->palette);
 
-    if(screen->uncorrectedChunkyFormat.memoryAllocated)
-        free(screen->uncorrectedChunkyFormat.pixels);
-
-    if(screen->uncorrectedRGBFormat.memoryAllocated)
-        free(screen->uncorrectedRGBFormat.pixels);
+    free(screen->incrementalFormat.previousBitplanes);
+    free(screen->incrementalFormat.dirtyRows);
+    free(screen->deltaFormat.touchedRows);
+    free(screen->deltaFormat.dirtyRows);
+    amiVideo_setScreenRegisterChanges(screen, NULL, 0);
 }
 
 void amiVideo_freeScreen(amiVideo_Screen *screen)
@@ -93,47 +188,76 @@ void amiVideo_setScreenBitplanePointers(amiVideo_Screen *screen, amiVideo_UByte
     memcpy(screen->bitplaneFormat.bitplanes, bitplanes, screen->bitplaneDepth * sizeof(amiVideo_UByte*));
 }
 
-void amiVideo_setScreenBitplanes(amiVideo_Screen *screen, amiVideo_UByte *bitplanes)
+void amiVideo_setScreenBitplaneLayout(amiVideo_Screen *screen, amiVideo_UByte *bitplanes, unsigned int planeOffset, unsigned int rowStride)
 {
     amiVideo_UByte *bitplanePointers[AMIVIDEO_MAX_NUM_OF_BITPLANES];
-    unsigned int offset = 0;
     unsigned int i;
 
     /* Set bitplane pointers */
 
     for(i = 0; i < screen->bitplaneDepth; i++)
-    {
-        bitplanePointers[i] = bitplanes + offset;
-        offset += screen->bitplaneFormat.pitch * screen->height;
-    }
+        bitplanePointers[i] = bitplanes + i * planeOffset;
+
+    /* Reset the layout to unscrolled scanlines that are rowStride bytes apart */
+    screen->bitplaneFormat.rowStride = rowStride;
+    screen->bitplaneFormat.bitOffset = 0;
+    screen->bitplaneFormat.numOfWrapRows = 0;
+    screen->bitplaneFormat.firstRow = 0;
+    screen->bitplaneFormat.playfield = FALSE;
 
     /* Set bitplane pointers */
     amiVideo_setScreenBitplanePointers(screen, bitplanePointers);
 }
 
+void amiVideo_setScreenPlayfield(amiVideo_Screen *screen, const amiVideo_Playfield *playfield)
+{
+    amiVideo_UByte *bitplanes = playfield->bitplanes + playfield->x / 8; /* The remaining pixels are skipped while decoding */
+
+    if(playfield->numOfRows > 0)
+    {
+        /* The bitplane pointers refer to the first row, so that the rows can wrap around */
+        amiVideo_setScreenBitplaneLayout(screen, bitplanes, playfield->planeOffset, playfield->rowStride);
+        screen->bitplaneFormat.numOfWrapRows = playfield->numOfRows;
+        screen->bitplaneFormat.firstRow = playfield->y % playfield->numOfRows;
+    }
+    else
+        amiVideo_setScreenBitplaneLayout(screen, bitplanes + playfield->y * playfield->rowStride, playfield->planeOffset, playfield->rowStride);
+
+    screen->bitplaneFormat.bitOffset = playfield->x % 8;
+    screen->bitplaneFormat.playfield = TRUE;
+}
+
+void amiVideo_setScreenBitplanes(amiVideo_Screen *screen, amiVideo_UByte *bitplanes)
+{
+    /* Each bitplane is stored after the previous one */
+    amiVideo_setScreenBitplaneLayout(screen, bitplanes, screen->bitplaneFormat.pitch * screen->height, screen->bitplaneFormat.pitch);
+}
+
+void amiVideo_setScreenInterleavedBitplanes(amiVideo_Screen *screen, amiVideo_UByte *bitplanes)
+{
+    /* A scanline of each bitplane is stored after the same scanline of the previous one */
+    amiVideo_setScreenBitplaneLayout(screen, bitplanes, screen->bitplaneFormat.pitch, screen->bitplaneFormat.pitch * screen->bitplaneDepth);
+}
+
 void amiVideo_setScreenUncorrectedChunkyPixelsPointer(amiVideo_Screen *screen, amiVideo_UByte *pixels, unsigned int pitch)
 {
     screen->uncorrectedChunkyFormat.pixels = pixels;
     screen->uncorrectedChunkyFormat.pitch = pitch;
-    screen->uncorrectedChunkyFormat.memoryAllocated = FALSE;
+    screen->uncorrectedChunkyFormat.pixelFormat = AMIVIDEO_PIXEL_FORMAT_CHUNKY8;
 }
 
 void amiVideo_setScreenUncorrectedRGBPixelsPointer(amiVideo_Screen *screen, amiVideo_ULong *pixels, unsigned int pitch, int allocateUncorrectedMemory, amiVideo_UByte rshift, amiVideo_UByte gshift, amiVideo_UByte bshift, amiVideo_UByte ashift)
 {
     screen->uncorrectedRGBFormat.pixels = pixels;
     screen->uncorrectedRGBFormat.pitch = pitch;
-    screen->uncorrectedRGBFormat.memoryAllocated = FALSE;
+    screen->uncorrectedRGBFormat.pixelFormat = AMIVIDEO_PIXEL_FORMAT_RGB32;
     screen->uncorrectedRGBFormat.rshift = rshift;
     screen->uncorrectedRGBFormat.gshift = gshift;
     screen->uncorrectedRGBFormat.bshift = bshift;
     screen->uncorrectedRGBFormat.ashift = ashift;
 
-    if(allocateUncorrectedMemory)
-    {
-        screen->uncorrectedChunkyFormat.pitch = screen->width;
-        screen->uncorrectedChunkyFormat.pixels = (amiVideo_UByte*)calloc(screen->uncorrectedChunkyFormat.pitch * screen->height, sizeof(amiVideo_UByte));
-        screen->uncorrectedChunkyFormat.memoryAllocated = TRUE;
-    }
+    /* RGB conversions decode the bitplanes directly, including HAM screens, so no intermediate memory needs to be allocated */
+    (void)allocateUncorrectedMemory;
 }
 
 void amiVideo_setScreenCorrectedPixelsPointer(amiVideo_Screen *screen, void *pixels, unsigned int pitch, unsigned int bytesPerPixel, int allocateUncorrectedMemory, amiVideo_UByte rshift, amiVideo_UByte gshift, amiVideo_UByte bshift, amiVideo_UByte ashift)
@@ -142,316 +266,1945 @@ void amiVideo_setScreenCorrectedPixelsPointer(amiVideo_Screen *screen, void *pix
     screen->correctedFormat.pitch = pitch;
     screen->correctedFormat.bytesPerPixel = bytesPerPixel;
 
-    if(allocateUncorrectedMemory)
+    switch(bytesPerPixel)
     {
-        screen->uncorrectedChunkyFormat.pitch = screen->width;
-        screen->uncorrectedChunkyFormat.pixels = (amiVideo_UByte*)calloc(screen->uncorrectedChunkyFormat.pitch * screen->height, sizeof(amiVideo_UByte));
-        screen->uncorrectedChunkyFormat.memoryAllocated = TRUE;
-
-        if(bytesPerPixel == 4)
-        {
-            screen->uncorrectedRGBFormat.pitch = screen->width * 4;
-            screen->uncorrectedRGBFormat.pixels = (amiVideo_ULong*)calloc(screen->uncorrectedRGBFormat.pitch * screen->height, sizeof(amiVideo_UByte));
-            screen->uncorrectedRGBFormat.memoryAllocated = TRUE;
-            screen->uncorrectedRGBFormat.rshift = rshift;
-            screen->uncorrectedRGBFormat.gshift = gshift;
-            screen->uncorrectedRGBFormat.bshift = bshift;
-            screen->uncorrectedRGBFormat.ashift = ashift;
-        }
-        else
-            screen->uncorrectedRGBFormat.memoryAllocated = FALSE;
+        case 2:
+            screen->correctedFormat.pixelFormat = AMIVIDEO_PIXEL_FORMAT_RGB565;
+            break;
+        case 3:
+            screen->correctedFormat.pixelFormat = AMIVIDEO_PIXEL_FORMAT_RGB24;
+            break;
+        case 4:
+            screen->correctedFormat.pixelFormat = AMIVIDEO_PIXEL_FORMAT_RGB32;
+            break;
+        default:
+            screen->correctedFormat.pixelFormat = AMIVIDEO_PIXEL_FORMAT_CHUNKY8;
     }
-    else
+
+    if(bytesPerPixel == 4)
     {
-        screen->uncorrectedChunkyFormat.memoryAllocated = FALSE;
-        screen->uncorrectedRGBFormat.memoryAllocated = FALSE;
+        screen->uncorrectedRGBFormat.rshift = rshift;
+        screen->uncorrectedRGBFormat.gshift = gshift;
+        screen->uncorrectedRGBFormat.bshift = bshift;
+        screen->uncorrectedRGBFormat.ashift = ashift;
     }
+
+    /* All screens are converted straight into the corrected surface, so no intermediate chunky or RGB surface needs to be allocated */
+    (void)allocateUncorrectedMemory;
 }
 
-static void convertScreenBitplanesToTarget(amiVideo_Screen *screen, int chunky)
+static unsigned int getBitsPerPixel(amiVideo_PixelFormat pixelFormat)
 {
-    unsigned int i;
-
-    for(i = 0; i < screen->bitplaneDepth; i++) /* Iterate over each bitplane */
+    switch(pixelFormat)
     {
-        unsigned int count = 0;
-        amiVideo_ULong indexBit = 1 << i;
-        amiVideo_UByte *bitplanes = screen->bitplaneFormat.bitplanes[i];
-        unsigned int vOffset = 0;
-        unsigned int j;
-
-        for(j = 0; j < screen->height; j++) /* Iterate over each scan line */
-        {
-            unsigned int hOffset = vOffset;
-            unsigned int k;
-            unsigned int pixelCount = 0;
-
-            for(k = 0; k < screen->bitplaneFormat.pitch; k++) /* Iterate over each byte containing 8 pixels */
-            {
-                amiVideo_UByte bitplane = bitplanes[hOffset];
-                unsigned char bitmask = 0x80;
-                unsigned int l;
-
-                for(l = 0; l < 8; l++) /* Iterate over each bit representing a pixel */
-                {
-                    if(pixelCount < screen->width) /* We must skip the padding bits. If we have already converted sufficient pixels on this scanline, ignore the rest */
-                    {
-                        if(bitplane & bitmask)
-                        {
-                            if(chunky)
-                                screen->uncorrectedChunkyFormat.pixels[count] |= indexBit;
-                            else
-                                screen->uncorrectedRGBFormat.pixels[count] |= indexBit;
-                        }
-                        count++;
-                    }
+        case AMIVIDEO_PIXEL_FORMAT_CHUNKY4:
+            return 4;
+        case AMIVIDEO_PIXEL_FORMAT_RGB32:
+            return 32;
+        case AMIVIDEO_PIXEL_FORMAT_RGB565:
+        case AMIVIDEO_PIXEL_FORMAT_XRGB1555:
+            return 16;
+        case AMIVIDEO_PIXEL_FORMAT_RGB24:
+            return 24;
+        default:
+            return 8;
+    }
+}
 
-                    pixelCount++;
-                    bitmask >>= 1;
-                }
+static int checkChunkyPixelFormat(amiVideo_PixelFormat pixelFormat)
+{
+    return pixelFormat == AMIVIDEO_PIXEL_FORMAT_CHUNKY8 || pixelFormat == AMIVIDEO_PIXEL_FORMAT_CHUNKY4;
+}
 
-                hOffset++;
-            }
+void amiVideo_setScreenUncorrectedChunkyPixelFormat(amiVideo_Screen *screen, amiVideo_PixelFormat pixelFormat)
+{
+    if(checkChunkyPixelFormat(pixelFormat))
+        screen->uncorrectedChunkyFormat.pixelFormat = pixelFormat;
+}
 
-            /* Skip the padding bytes in the output */
-            if(chunky)
-                count += screen->uncorrectedChunkyFormat.pitch - screen->width;
-            else
-                count += screen->uncorrectedRGBFormat.pitch / 4 - screen->width;
+void amiVideo_setScreenUncorrectedRGBPixelFormat(amiVideo_Screen *screen, amiVideo_PixelFormat pixelFormat)
+{
+    if(!checkChunkyPixelFormat(pixelFormat))
+        screen->uncorrectedRGBFormat.pixelFormat = pixelFormat;
+}
 
-            vOffset += screen->bitplaneFormat.pitch;
-        }
-    }
+void amiVideo_setScreenCorrectedPixelFormat(amiVideo_Screen *screen, amiVideo_PixelFormat pixelFormat)
+{
+    screen->correctedFormat.pixelFormat = pixelFormat;
+    screen->correctedFormat.bytesPerPixel = getBitsPerPixel(pixelFormat) / 8;
 }
 
-void amiVideo_convertScreenBitplanesToChunkyPixels(amiVideo_Screen *screen)
+static amiVideo_PixelFormat selectChunkyPixelFormat(amiVideo_PixelFormat pixelFormat)
 {
-    convertScreenBitplanesToTarget(screen, TRUE);
+    return checkChunkyPixelFormat(pixelFormat) ? pixelFormat : AMIVIDEO_PIXEL_FORMAT_CHUNKY8;
 }
 
-static amiVideo_ULong convertColorToRGBPixel(const amiVideo_OutputColor *color, amiVideo_UByte rshift, amiVideo_UByte gshift, amiVideo_UByte bshift, amiVideo_UByte ashift)
+static amiVideo_PixelFormat selectRGBPixelFormat(amiVideo_PixelFormat pixelFormat)
 {
-    return (color->r << rshift) | (color->g << gshift) | (color->b << bshift) | (color->a << ashift);
+    return checkChunkyPixelFormat(pixelFormat) ? AMIVIDEO_PIXEL_FORMAT_RGB32 : pixelFormat;
 }
 
-void amiVideo_convertScreenChunkyPixelsToRGBPixels(amiVideo_Screen *screen)
+int amiVideo_setScreenIncrementalConversion(amiVideo_Screen *screen, int enabled)
 {
-    unsigned int screenWidthInPixels = screen->uncorrectedRGBFormat.pitch / 4;
+    screen->incrementalFormat.previousValid = FALSE;
+    screen->incrementalFormat.numOfDirtyRows = 0;
 
-    if(amiVideo_checkHoldAndModify(screen->viewportMode))
+    if(enabled)
     {
-        /* HAM mode has its own decompression technique */
-
-        unsigned int i;
-        unsigned int offset = 0;
+        /* At most every other scanline starts a new range of dirty scanlines */
+        amiVideo_ULong previousBitplanesSize = (amiVideo_ULong)screen->bitplaneDepth * screen->bitplaneFormat.pitch * screen->height;
+        unsigned int maxNumOfDirtyRows = screen->height / 2 + 1;
 
-        for(i = 0; i < screen->height; i++)
+        /* The buffers are kept while they are large enough, so that a reused screen does not allocate them for every frame */
+        if(previousBitplanesSize > screen->incrementalFormat.previousBitplanesSize || maxNumOfDirtyRows > screen->incrementalFormat.maxNumOfDirtyRows)
         {
-            unsigned int j;
-            amiVideo_OutputColor previousResult = screen->palette.chunkyFormat.color[0];
-
-            for(j = 0; j < screenWidthInPixels; j++)
-            {
-                amiVideo_UByte byte = screen->uncorrectedChunkyFormat.pixels[offset + j];
-                amiVideo_UByte mode = (byte & (0x3 << (screen->bitplaneDepth - 2))) >> (screen->bitplaneDepth - 2);
-                amiVideo_UByte index = byte & ~(0x3 << (screen->bitplaneDepth - 2));
-                amiVideo_OutputColor result;
-
-                if(mode == 0x0) /* Data bits are an index in the color palette */
-                    result = screen->palette.chunkyFormat.color[index];
-                else if(mode == 0x1) /* Data bits are blue level */
-                {
-                    result = previousResult;
-                    result.b = index << (8 - screen->bitplaneDepth + 2);
-                }
-                else if(mode == 0x2) /* Data bits are red level */
-                {
-                    result = previousResult;
-                    result.r = index << (8 - screen->bitplaneDepth + 2);
-                }
-                else if(mode == 0x3) /* Data bits are green level */
-                {
-                    result = previousResult;
-                    result.g = index << (8 - screen->bitplaneDepth + 2);
-                }
+            free(screen->incrementalFormat.previousBitplanes);
+            free(screen->incrementalFormat.dirtyRows);
 
-                /* set new pixel on offset + j */
-                screen->uncorrectedRGBFormat.pixels[offset + j] = convertColorToRGBPixel(&result, screen->uncorrectedRGBFormat.rshift, screen->uncorrectedRGBFormat.gshift, screen->uncorrectedRGBFormat.bshift, screen->uncorrectedRGBFormat.ashift);
+            screen->incrementalFormat.previousBitplanes = (amiVideo_UByte*)calloc(previousBitplanesSize > 0 ? previousBitplanesSize : 1, sizeof(amiVideo_UByte));
+            screen->incrementalFormat.dirtyRows = (amiVideo_RowRange*)malloc(maxNumOfDirtyRows * sizeof(amiVideo_RowRange));
+            screen->incrementalFormat.previousBitplanesSize = previousBitplanesSize;
+            screen->incrementalFormat.maxNumOfDirtyRows = maxNumOfDirtyRows;
 
-                previousResult = result;
+            if(screen->incrementalFormat.previousBitplanes == NULL || screen->incrementalFormat.dirtyRows == NULL)
+            {
+                amiVideo_setScreenIncrementalConversion(screen, FALSE);
+                return FALSE;
             }
 
-            offset += screenWidthInPixels;
+            AMIVIDEO_COUNT_ALLOCATION(screen, previousBitplanesSize);
+            AMIVIDEO_COUNT_ALLOCATION(screen, maxNumOfDirtyRows * sizeof(amiVideo_RowRange));
         }
+
+        screen->incrementalFormat.enabled = TRUE;
     }
     else
     {
-        /* Normal mode */
-
-        unsigned int i;
-
-        for(i = 0; i < screenWidthInPixels * screen->height; i++)
-            screen->uncorrectedRGBFormat.pixels[i] = convertColorToRGBPixel(&screen->palette.chunkyFormat.color[screen->uncorrectedChunkyFormat.pixels[i]], screen->uncorrectedRGBFormat.rshift, screen->uncorrectedRGBFormat.gshift, screen->uncorrectedRGBFormat.bshift, screen->uncorrectedRGBFormat.ashift);
+        free(screen->incrementalFormat.previousBitplanes);
+        free(screen->incrementalFormat.dirtyRows);
+
+        screen->incrementalFormat.enabled = FALSE;
+        screen->incrementalFormat.previousBitplanes = NULL;
+        screen->incrementalFormat.previousBitplanesSize = 0;
+        screen->incrementalFormat.dirtyRows = NULL;
+        screen->incrementalFormat.maxNumOfDirtyRows = 0;
     }
+
+    return TRUE;
 }
 
-void amiVideo_convertScreenChunkyPixelsToBitplanes(amiVideo_Screen *screen)
+int amiVideo_setScreenDeltaConversion(amiVideo_Screen *screen, int enabled)
 {
-    int i;
-    unsigned int bitplaneIndex = 0;
-    int bit = 7;
+    screen->deltaFormat.valid = FALSE;
+    memset(screen->deltaFormat.previousValid, '\0', sizeof(screen->deltaFormat.previousValid));
+    screen->deltaFormat.numOfDirtyRows = 0;
 
-    for(i = 0; i < screen->width * screen->height; i++)
+    if(enabled)
     {
-        unsigned int j;
-        amiVideo_UByte bitmask = 1 << bit;
-
-        for(j = 0; j < screen->bitplaneDepth; j++)
+        /* The buffers are kept while they are large enough, so that a reused screen does not allocate them for every frame */
+        if(screen->height > screen->deltaFormat.maxHeight || screen->deltaFormat.touchedRows == NULL)
         {
-            if(screen->uncorrectedChunkyFormat.pixels[i] & (1 << j)) /* Check if the current bit of the index value is set */
-                screen->bitplaneFormat.bitplanes[j][bitplaneIndex] |= bitmask; /* Modify the current bit in the bitplane byte to be 1 and leave the others untouched */
-            else
-                screen->bitplaneFormat.bitplanes[j][bitplaneIndex] &= ~bitmask; /* Modify the current bit in the bitplane byte to be 0 and leave the others untouched */
-        }
+            unsigned int maxHeight = screen->height > 0 ? screen->height : 1;
 
-        bit--;
+            free(screen->deltaFormat.touchedRows);
+            free(screen->deltaFormat.dirtyRows);
 
-        if(bit < 0)
-        {
-            bit = 7; /* Reset the bit counter */
-            bitplaneIndex++; /* Go to the next byte in the bitplane memory */
+            /* At most every other scanline starts a new range of modified scanlines */
+            screen->deltaFormat.touchedRows = (amiVideo_UByte*)malloc(maxHeight * sizeof(amiVideo_UByte));
+            screen->deltaFormat.dirtyRows = (amiVideo_RowRange*)malloc((maxHeight / 2 + 1) * sizeof(amiVideo_RowRange));
+            screen->deltaFormat.maxHeight = maxHeight;
+
+            if(screen->deltaFormat.touchedRows == NULL || screen->deltaFormat.dirtyRows == NULL)
+            {
+                amiVideo_setScreenDeltaConversion(screen, FALSE);
+                return FALSE;
+            }
+
+            AMIVIDEO_COUNT_ALLOCATION(screen, maxHeight);
+            AMIVIDEO_COUNT_ALLOCATION(screen, (maxHeight / 2 + 1) * sizeof(amiVideo_RowRange));
         }
+
+        memset(screen->deltaFormat.touchedRows, FALSE, screen->deltaFormat.maxHeight);
+        screen->deltaFormat.enabled = TRUE;
     }
+    else
+    {
+        free(screen->deltaFormat.touchedRows);
+        free(screen->deltaFormat.dirtyRows);
+
+        screen->deltaFormat.enabled = FALSE;
+        screen->deltaFormat.touchedRows = NULL;
+        screen->deltaFormat.dirtyRows = NULL;
+        screen->deltaFormat.maxHeight = 0;
+    }
+
+    return TRUE;
 }
 
-void amiVideo_correctScreenPixels(amiVideo_Screen *screen)
+static void getBitplaneRows(const amiVideo_Screen *screen, unsigned int row, amiVideo_UByte **bitplaneRows)
 {
+    unsigned int offset;
     unsigned int i;
-    unsigned int sourceOffset = 0, destOffset = 0;
 
-    unsigned int repeatHorizontal;
-    unsigned int repeatVertical;
+    if(screen->bitplaneFormat.numOfWrapRows > 0)
+        row = (screen->bitplaneFormat.firstRow + row) % screen->bitplaneFormat.numOfWrapRows; /* Scanlines beyond the last row of the playfield continue at its first row */
 
-    amiVideo_UByte *pixels;
+    offset = row * screen->bitplaneFormat.rowStride;
+
+    for(i = 0; i < screen->bitplaneDepth; i++)
+        bitplaneRows[i] = screen->bitplaneFormat.bitplanes[i] + offset;
+}
 
+static void computeRepeatFactors(const amiVideo_Screen *screen, unsigned int *repeatHorizontal, unsigned int *repeatVertical)
+{
     /* Calculate how many times we have to horizontally repeat a pixel */
     if(amiVideo_checkSuperHires(screen->viewportMode))
-        repeatHorizontal = screen->correctedFormat.lowresPixelScaleFactor / 4;
+        *repeatHorizontal = screen->correctedFormat.lowresPixelScaleFactor / 4;
     else if(amiVideo_checkHires(screen->viewportMode))
-        repeatHorizontal = screen->correctedFormat.lowresPixelScaleFactor / 2;
+        *repeatHorizontal = screen->correctedFormat.lowresPixelScaleFactor / 2;
     else
-        repeatHorizontal = screen->correctedFormat.lowresPixelScaleFactor;
+        *repeatHorizontal = screen->correctedFormat.lowresPixelScaleFactor;
 
     /* Calculate how many times we have to vertically repeat a scanline */
 
     if(amiVideo_checkLaced(screen->viewportMode))
-        repeatVertical = screen->correctedFormat.lowresPixelScaleFactor / 2;
+        *repeatVertical = screen->correctedFormat.lowresPixelScaleFactor / 2;
     else
-        repeatVertical = screen->correctedFormat.lowresPixelScaleFactor;
+        *repeatVertical = screen->correctedFormat.lowresPixelScaleFactor;
+}
+
+/*
+ * Every conversion is split into a preparation step that runs once and a
+ * function that converts a range of scanlines. Because scanlines can be
+ * converted independently (HAM colors are reset at the start of each
+ * scanline), the frame can be split into horizontal bands that are converted
+ * in parallel. Each band writes to its own rows only, so the output is the
+ * same regardless of the amount of bands.
+ */
+
+/* Lookup tables that convert the index values of a range of scanlines into pixels */
+typedef struct
+{
+    /** First scanline to which the tables apply */
+    unsigned int firstRow;
 
-    /* Check which pixels we have to correct */
+    /** Viewport mode of the scanlines */
+    amiVideo_Long viewportMode;
 
-    if(screen->correctedFormat.bytesPerPixel == 1)
-        pixels = screen->uncorrectedChunkyFormat.pixels;
-    else
-        pixels = (amiVideo_UByte*)screen->uncorrectedRGBFormat.pixels;
+    /** RGB pixel values of each possible index value */
+    amiVideo_ULong colors[256];
 
-    /* Do the correction */
-    for(i = 0; i < screen->height; i++)
+    /** Lookup tables that decode HAM index values */
+    amiVideo_HAMTable hamTable;
+
+    /** Lookup table that converts two color indexes into two RGB pixels at once or NULL if it should not be used */
+    const amiVideo_ULong *pixelPairs;
+
+    /** Amount of bits that a color index occupies in the pixel pair table index */
+    unsigned int pairIndexBits;
+
+    /** 16-bit pixel values of each possible index value for the 16-bit pixel formats */
+    amiVideo_UWord wordColors[256];
+}
+amiVideo_ColorTables;
+
+/* Lookup tables of each range of scanlines with the same register values */
+struct amiVideo_RegisterState
+{
+    /** Palette to which the register changes are applied */
+    amiVideo_Palette palette;
+
+    /** Lookup tables sorted by their first scanline */
+    amiVideo_ColorTables *tables;
+
+    /** Amount of lookup tables */
+    unsigned int numOfTables;
+
+    /** Indicates whether the tables have been computed */
+    int valid;
+
+    /** Version of the register changes from which the tables have been computed */
+    unsigned int version;
+
+    /** Version of the RGB pixels of the screen palette from which the tables have been computed */
+    unsigned int paletteVersion;
+
+    /** Pixel format for which the tables have been computed */
+    amiVideo_PixelFormat pixelFormat;
+
+    /** Amounts of bits that the color components are shifted in the tables */
+    amiVideo_UByte rshift;
+    amiVideo_UByte gshift;
+    amiVideo_UByte bshift;
+    amiVideo_UByte ashift;
+};
+
+int amiVideo_setScreenRegisterChanges(amiVideo_Screen *screen, const amiVideo_RegisterChange *changes, unsigned int numOfChanges)
+{
+    struct amiVideo_RegisterState *state = screen->registerFormat.state;
+
+    if(state != NULL)
     {
-        unsigned int j;
+        amiVideo_cleanupPalette(&state->palette);
+        free(state->tables);
+        free(state);
+    }
 
-        for(j = 0; j < screen->width; j++)
-        {
-            unsigned int k;
+    screen->registerFormat.changes = NULL;
+    screen->registerFormat.numOfChanges = 0;
+    screen->registerFormat.version++; /* Invalidates the output of the previous conversions */
+    screen->registerFormat.state = NULL;
 
-            /* Scale the pixel horizontally */
-            for(k = 0; k < repeatHorizontal; k++)
-            {
-                memcpy((amiVideo_UByte*)screen->correctedFormat.pixels + destOffset, pixels + sourceOffset, screen->correctedFormat.bytesPerPixel);
-                destOffset += screen->correctedFormat.bytesPerPixel;
-            }
+    if(changes != NULL && numOfChanges > 0)
+    {
+        state = (struct amiVideo_RegisterState*)malloc(sizeof(struct amiVideo_RegisterState));
+
+        if(state == NULL)
+            return FALSE;
+
+        /* Every change may start a new range of scanlines, in addition to the range that starts at the top */
+        state->tables = (amiVideo_ColorTables*)malloc((numOfChanges + 1) * sizeof(amiVideo_ColorTables));
 
-            sourceOffset += screen->correctedFormat.bytesPerPixel;
+        if(state->tables == NULL)
+        {
+            free(state);
+            return FALSE;
         }
 
-        destOffset += screen->correctedFormat.pitch - screen->correctedFormat.width * screen->correctedFormat.bytesPerPixel; /* Skip the padding bytes */
+        amiVideo_initPalette(&state->palette, screen->bitplaneDepth, screen->palette.bitplaneFormat.bitsPerColorChannel, screen->viewportMode);
+        state->numOfTables = 0;
+        state->valid = FALSE;
 
-        /* Non-interlace screen scanlines must be doubled */
+        screen->registerFormat.changes = changes;
+        screen->registerFormat.numOfChanges = numOfChanges;
+        screen->registerFormat.state = state;
+        AMIVIDEO_COUNT_ALLOCATION(screen, sizeof(struct amiVideo_RegisterState));
+        AMIVIDEO_COUNT_ALLOCATION(screen, (numOfChanges + 1) * sizeof(amiVideo_ColorTables));
+    }
 
-        for(j = 1; j < repeatVertical; j++)
+    return TRUE;
+}
+
+typedef struct amiVideo_ConversionJob amiVideo_ConversionJob;
+
+typedef void (*amiVideo_ConvertRowsFunction)(const amiVideo_ConversionJob *job, unsigned int firstRow, unsigned int lastRow);
+
+struct amiVideo_ConversionJob
+{
+    /** Screen that must be converted */
+    amiVideo_Screen *screen;
+
+    /** Function that converts a range of scanlines */
+    amiVideo_ConvertRowsFunction convertRows;
+
+    /** Amount of bands in which the frame is split */
+    unsigned int numOfBands;
+
+    /** Indicates whether the fused conversions read from the bitplanes or from the chunky pixels */
+    int fromBitplanes;
+
+    /** Settings that determine the output of the conversion */
+    amiVideo_ConversionSettings settings;
+
+    /** Ranges of scanlines that must be converted */
+    const amiVideo_RowRange *ranges;
+
+    /** Amount of ranges that must be converted */
+    unsigned int numOfRanges;
+
+    /** Lookup tables that convert the index values of all scanlines */
+    amiVideo_ColorTables tables;
+
+    /** Lookup tables of the ranges of scanlines in which registers have been changed or NULL if the registers do not change */
+    const amiVideo_ColorTables *lineTables;
+
+    /** Amount of lookup tables in lineTables */
+    unsigned int numOfLineTables;
+
+    /** Stage of which the statistics are recorded */
+    unsigned int stage;
+
+    /** Shifts of the color channels of a true color screen, for each group of 8 bitplanes starting with the lowest */
+    amiVideo_UByte channelShifts[4];
+
+    /** Index of the first column of every scanline that must be converted */
+    unsigned int firstColumn;
+
+    /** Index of the column after the last column of every scanline that must be converted */
+    unsigned int lastColumn;
+
+    /** Indicates whether only a region of the screen is converted, of which the surrounding pixels must be preserved */
+    int partial;
+};
+
+/* Identifies the conversions from bitplanes that can be performed incrementally, numbered from 1 up to AMIVIDEO_NUM_OF_BITPLANE_CONVERSIONS */
+#define CONVERSION_NONE 0
+#define CONVERSION_BITPLANES_TO_CHUNKY 1
+#define CONVERSION_BITPLANES_TO_RGB 2
+#define CONVERSION_BITPLANES_TO_CORRECTED_CHUNKY 3
+#define CONVERSION_BITPLANES_TO_CORRECTED_RGB 4
+
+static void convertBand(void *data, unsigned int band)
+{
+    const amiVideo_ConversionJob *job = (const amiVideo_ConversionJob*)data;
+    unsigned int firstRow = band * job->screen->height / job->numOfBands;
+    unsigned int lastRow = (band + 1) * job->screen->height / job->numOfBands;
+    unsigned int i;
+
+    /* Convert the parts of the ranges that overlap with this band */
+    for(i = 0; i < job->numOfRanges; i++)
+    {
+        unsigned int rangeFirstRow = job->ranges[i].firstRow > firstRow ? job->ranges[i].firstRow : firstRow;
+        unsigned int rangeLastRow = job->ranges[i].lastRow < lastRow ? job->ranges[i].lastRow : lastRow;
+
+        if(rangeFirstRow < rangeLastRow)
+            job->convertRows(job, rangeFirstRow, rangeLastRow);
+    }
+}
+
+static int checkRowChanged(amiVideo_Screen *screen, unsigned int row)
+{
+    amiVideo_UByte *bitplaneRows[AMIVIDEO_MAX_NUM_OF_BITPLANES];
+    amiVideo_UByte *previousRow = screen->incrementalFormat.previousBitplanes + row * screen->bitplaneDepth * screen->bitplaneFormat.pitch; /* The copy is stored interleaved, so that a scanline is compared in one go */
+    int changed = FALSE;
+    unsigned int i;
+
+    getBitplaneRows(screen, row, bitplaneRows);
+
+    for(i = 0; i < screen->bitplaneDepth; i++)
+    {
+        if(screen->bitplaneFormat.bitOffset != 0)
+        {
+            /* Compare the visible pixels of rows that do not start at a byte boundary in aligned chunks */
+            unsigned int x;
+
+            for(x = 0; x < screen->width; x += AMIVIDEO_ROW_CHUNK_SIZE)
+            {
+                amiVideo_UByte alignedRow[AMIVIDEO_ROW_CHUNK_SIZE / 8];
+                unsigned int numOfPixels = screen->width - x < AMIVIDEO_ROW_CHUNK_SIZE ? screen->width - x : AMIVIDEO_ROW_CHUNK_SIZE;
+                unsigned int numOfBytes = (numOfPixels + 7) / 8;
+
+                amiVideo_alignBitplaneRow(bitplaneRows[i] + x / 8, screen->bitplaneFormat.bitOffset, numOfPixels, alignedRow);
+
+                if(memcmp(previousRow + x / 8, alignedRow, numOfBytes) != 0)
+                {
+                    memcpy(previousRow + x / 8, alignedRow, numOfBytes);
+                    changed = TRUE;
+                }
+            }
+        }
+        else if(memcmp(previousRow, bitplaneRows[i], screen->bitplaneFormat.pitch) != 0)
         {
-            memcpy((amiVideo_UByte*)screen->correctedFormat.pixels + destOffset, (amiVideo_UByte*)screen->correctedFormat.pixels + destOffset - screen->correctedFormat.pitch, screen->correctedFormat.pitch);
-            destOffset += screen->correctedFormat.pitch;
+            memcpy(previousRow, bitplaneRows[i], screen->bitplaneFormat.pitch);
+            changed = TRUE;
         }
+
+        previousRow += screen->bitplaneFormat.pitch;
     }
+
+    return changed;
 }
 
-void amiVideo_convertScreenBitplanesToRGBPixels(amiVideo_Screen *screen)
+static unsigned int collectDirtyRows(amiVideo_Screen *screen, const amiVideo_ConversionSettings *settings)
 {
-    if(screen->bitplaneDepth == 24 || screen->bitplaneDepth == 32) /* For true color images we directly convert bitplanes to RGB pixels */
+    int reuse = screen->incrementalFormat.previousValid && memcmp(&screen->incrementalFormat.previousSettings, settings, sizeof(amiVideo_ConversionSettings)) == 0;
+    amiVideo_RowRange *dirtyRows = screen->incrementalFormat.dirtyRows;
+    unsigned int numOfDirtyRows = 0;
+    unsigned int i;
+
+    for(i = 0; i < screen->height; i++)
     {
-        convertScreenBitplanesToTarget(screen, FALSE);
-        amiVideo_reorderRGBPixels(screen);
+        /* Every row is compared, so that the copy of the bitplanes is always updated */
+        if(checkRowChanged(screen, i) || !reuse)
+        {
+            if(numOfDirtyRows > 0 && dirtyRows[numOfDirtyRows - 1].lastRow == i)
+                dirtyRows[numOfDirtyRows - 1].lastRow++; /* Extend the previous range */
+            else
+            {
+                dirtyRows[numOfDirtyRows].firstRow = i;
+                dirtyRows[numOfDirtyRows].lastRow = i + 1;
+                numOfDirtyRows++;
+            }
+        }
     }
-    else
+
+    screen->incrementalFormat.previousSettings = *settings;
+    screen->incrementalFormat.previousValid = TRUE;
+
+    return numOfDirtyRows;
+}
+
+/* Checks whether the target surface of a conversion contains the frame to which the last delta has been applied, converted with the same settings */
+static int checkDeltaReusable(const amiVideo_Screen *screen, const amiVideo_ConversionSettings *settings)
+{
+    unsigned int i = settings->conversion - 1;
+
+    return screen->deltaFormat.valid
+        && screen->deltaFormat.previousValid[i]
+        && screen->deltaFormat.numOfDeltas - screen->deltaFormat.previousNumOfDeltas[i] <= 1 /* A delta that was not converted leaves scanlines out of date */
+        && memcmp(&screen->deltaFormat.previousSettings[i], settings, sizeof(amiVideo_ConversionSettings)) == 0;
+}
+
+/* Forgets the previous conversions that wrote to the given surface, because their results have been overwritten */
+static void invalidateDeltaTargets(amiVideo_Screen *screen, const void *pixels)
+{
+    unsigned int i;
+
+    for(i = 0; i < AMIVIDEO_NUM_OF_BITPLANE_CONVERSIONS; i++)
     {
-        /* For lower bitplane depths we first have to compose chunky pixels to determine the actual color values */
-        amiVideo_convertBitplaneColorsToChunkyFormat(&screen->palette);
-        amiVideo_convertScreenBitplanesToChunkyPixels(screen);
-        amiVideo_convertScreenChunkyPixelsToRGBPixels(screen);
+        if(screen->deltaFormat.previousSettings[i].pixels == pixels)
+            screen->deltaFormat.previousValid[i] = FALSE;
     }
 }
 
-void amiVideo_convertScreenBitplanesToCorrectedChunkyPixels(amiVideo_Screen *screen)
+static void recordDeltaConversion(amiVideo_Screen *screen, const amiVideo_ConversionSettings *settings)
 {
-    amiVideo_convertScreenBitplanesToChunkyPixels(screen);
-    amiVideo_correctScreenPixels(screen);
+    unsigned int i = settings->conversion - 1;
+
+    invalidateDeltaTargets(screen, settings->pixels);
+    screen->deltaFormat.previousValid[i] = TRUE;
+    screen->deltaFormat.previousNumOfDeltas[i] = screen->deltaFormat.numOfDeltas;
+    screen->deltaFormat.previousSettings[i] = *settings;
 }
 
-void amiVideo_convertScreenBitplanesToCorrectedRGBPixels(amiVideo_Screen *screen)
+#if defined(AMIVIDEO_INSTRUMENTATION)
+static unsigned long countJobRows(const amiVideo_ConversionJob *job)
 {
-    amiVideo_convertScreenBitplanesToRGBPixels(screen);
-    amiVideo_correctScreenPixels(screen);
+    unsigned long numOfRows = 0;
+    unsigned int i;
+
+    for(i = 0; i < job->numOfRanges; i++)
+        numOfRows += job->ranges[i].lastRow - job->ranges[i].firstRow;
+
+    return numOfRows;
 }
 
-void amiVideo_convertScreenChunkyPixelsToCorrectedRGBPixels(amiVideo_Screen *screen)
+static unsigned long countJobPixels(const amiVideo_ConversionJob *job)
 {
-    amiVideo_convertScreenChunkyPixelsToRGBPixels(screen);
-    amiVideo_correctScreenPixels(screen);
+    return countJobRows(job) * (job->lastColumn - job->firstColumn) * job->settings.repeatHorizontal * job->settings.repeatVertical;
 }
 
-amiVideo_ColorFormat amiVideo_autoSelectColorFormat(const amiVideo_Screen *screen)
+static unsigned long countJobBytes(const amiVideo_ConversionJob *job)
 {
-    if(amiVideo_checkHoldAndModify(screen->viewportMode) || screen->bitplaneDepth == 24 || screen->bitplaneDepth == 32)
-        return AMIVIDEO_RGB_FORMAT;
+    if(job->stage == AMIVIDEO_STAGE_PLANAR_ENCODE)
+        return countJobRows(job) * job->screen->bitplaneDepth * job->screen->bitplaneFormat.pitch; /* Bitplanes are written instead of pixels */
     else
-        return AMIVIDEO_CHUNKY_FORMAT;
+        return countJobPixels(job) * getBitsPerPixel(job->settings.pixelFormat) / 8;
 }
-
-static void reorderPixelBytes(amiVideo_Screen *screen, amiVideo_UByte rshift, amiVideo_UByte gshift, amiVideo_UByte bshift, amiVideo_UByte ashift)
+#endif
+
+/*
+ * Restricts the job to the given region of the screen, clipped to the
+ * boundaries of the screen, and stores the scanlines of the region in the given
+ * range. Two packed 4-bit pixels share a byte of the target, so the columns are
+ * widened to the byte boundaries of the target.
+ */
+static void setJobRegion(amiVideo_ConversionJob *job, const amiVideo_Region *region, amiVideo_RowRange *rows)
 {
-    unsigned int i;
+    unsigned int width = job->screen->width;
+    unsigned int height = job->screen->height;
 
-    for(i = 0; i < screen->uncorrectedRGBFormat.pitch / 4 * screen->height; i++)
-    {
-        amiVideo_ULong pixel = screen->uncorrectedRGBFormat.pixels[i];
-        amiVideo_OutputColor color;
+    job->partial = TRUE;
+    job->firstColumn = region->x < width ? region->x : width;
+    job->lastColumn = region->width < width - job->firstColumn ? job->firstColumn + region->width : width;
+    rows->firstRow = region->y < height ? region->y : height;
+    rows->lastRow = region->height < height - rows->firstRow ? rows->firstRow + region->height : height;
 
-        color.r = (pixel >> rshift) & 0xff;
-        color.g = (pixel >> gshift) & 0xff;
-        color.b = (pixel >> bshift) & 0xff;
-        color.a = (pixel >> ashift) & 0xff;
+    if(job->settings.pixelFormat == AMIVIDEO_PIXEL_FORMAT_CHUNKY4 && job->settings.repeatHorizontal % 2 == 1)
+    {
+        if(job->firstColumn % 2 == 1)
+            job->firstColumn--;
 
-        convertColorToRGBPixel(&color, screen->uncorrectedRGBFormat.rshift, screen->uncorrectedRGBFormat.gshift, screen->uncorrectedRGBFormat.bshift, screen->uncorrectedRGBFormat.ashift);
+        if(job->lastColumn % 2 == 1 && job->lastColumn < width)
+            job->lastColumn++;
     }
 }
 
-void amiVideo_reorderRGBPixels(amiVideo_Screen *screen)
+/*
+ * Restricts a delta conversion to the columns that the last delta has
+ * modified. A HAM pixel depends on the pixels to its left, so scanlines that
+ * may be HAM encoded are still converted up to their end.
+ */
+static void setDeltaColumns(amiVideo_ConversionJob *job)
+{
+    amiVideo_Screen *screen = job->screen;
+    unsigned int bitOffset = screen->bitplaneFormat.bitOffset;
+    unsigned int firstColumn = screen->deltaFormat.firstColumn * 8;
+    unsigned int lastColumn = screen->deltaFormat.lastColumn * 8;
+    amiVideo_Region region;
+    amiVideo_RowRange rows;
+
+    if(!job->fromBitplanes)
+        return; /* Only the fused conversions can convert a part of a scanline */
+
+    /* The bitplane rows start bitOffset pixels before the first column of the screen */
+    region.x = firstColumn > bitOffset ? firstColumn - bitOffset : 0;
+    region.y = 0;
+    region.width = lastColumn > bitOffset + region.x ? lastColumn - bitOffset - region.x : 0;
+    region.height = screen->height;
+
+    if(!checkChunkyPixelFormat(job->settings.pixelFormat) && (amiVideo_checkHoldAndModify(job->settings.viewportMode) || screen->registerFormat.numOfChanges > 0))
+        region.width = screen->width; /* Clipped to the end of the scanlines */
+
+    setJobRegion(job, &region, &rows);
+}
+
+static void runConversionJob(amiVideo_ConversionJob *job, const amiVideo_Region *region, unsigned int numOfThreads, amiVideo_Executor executor, void *executorData)
+{
+    amiVideo_Screen *screen = job->screen;
+    amiVideo_RowRange frame;
+    int deltaConversion = screen->deltaFormat.enabled && region == NULL && job->settings.conversion != CONVERSION_NONE;
+    AMIVIDEO_DECLARE_TIMESTAMP(start)
+
+    AMIVIDEO_START_STAGE(start);
+
+    /* Select the kernels up front, so that the bands do not race to do it */
+    amiVideo_getPlanarKernels();
+    amiVideo_getCorrectionKernels();
+
+    /* Determine which scanlines must be converted */
+    frame.firstRow = 0;
+    frame.lastRow = screen->height;
+
+    if(region != NULL)
+    {
+        /* Only the scanlines of the region are converted, regardless of which scanlines have changed */
+        setJobRegion(job, region, &frame);
+        job->ranges = &frame;
+        job->numOfRanges = 1;
+        screen->incrementalFormat.previousValid = FALSE; /* The copy of the bitplanes is not updated */
+    }
+    else if(deltaConversion && checkDeltaReusable(screen, &job->settings))
+    {
+        /* The delta decoder already knows which scanlines and columns have changed */
+        job->ranges = screen->deltaFormat.dirtyRows;
+        job->numOfRanges = screen->deltaFormat.numOfDirtyRows;
+        setDeltaColumns(job);
+        screen->incrementalFormat.previousValid = FALSE; /* The copy of the bitplanes is not updated */
+    }
+    else if(screen->incrementalFormat.enabled && job->settings.conversion != CONVERSION_NONE)
+    {
+        job->ranges = screen->incrementalFormat.dirtyRows;
+        job->numOfRanges = collectDirtyRows(screen, &job->settings);
+    }
+    else
+    {
+        job->ranges = &frame;
+        job->numOfRanges = 1;
+        screen->incrementalFormat.previousValid = FALSE; /* The target of an incremental conversion may have been overwritten */
+    }
+
+    /* Every frame that a delta conversion can build on must be recorded, including those that are converted entirely */
+    if(deltaConversion)
+        recordDeltaConversion(screen, &job->settings);
+    else if(screen->deltaFormat.enabled)
+        invalidateDeltaTargets(screen, job->settings.pixels);
+
+    /* A band contains at least one scanline */
+    if(numOfThreads > screen->height)
+        job->numOfBands = screen->height;
+    else
+        job->numOfBands = numOfThreads;
+
+    if(job->numOfBands <= 1)
+    {
+        job->numOfBands = 1;
+        convertBand(job, 0);
+    }
+    else if(executor == NULL)
+        amiVideo_runBandsInThreads(convertBand, job, job->numOfBands);
+    else
+        executor(convertBand, job, job->numOfBands, executorData);
+
+    AMIVIDEO_FINISH_STAGE(screen, job->stage, start, countJobPixels(job), countJobBytes(job));
+
+    /* Report the scanlines of the target surface that have been written */
+    if(screen->incrementalFormat.enabled)
+    {
+        unsigned int i;
+
+        if(job->ranges != screen->incrementalFormat.dirtyRows)
+            memcpy(screen->incrementalFormat.dirtyRows, job->ranges, job->numOfRanges * sizeof(amiVideo_RowRange));
+
+        screen->incrementalFormat.numOfDirtyRows = job->numOfRanges;
+
+        for(i = 0; i < screen->incrementalFormat.numOfDirtyRows; i++)
+        {
+            screen->incrementalFormat.dirtyRows[i].firstRow *= job->settings.repeatVertical;
+            screen->incrementalFormat.dirtyRows[i].lastRow *= job->settings.repeatVertical;
+        }
+    }
+}
+
+static void initConversionJob(amiVideo_ConversionJob *job, amiVideo_Screen *screen, amiVideo_ConvertRowsFunction convertRows, unsigned int stage, int conversion, int corrected)
+{
+    memset(job, '\0', sizeof(amiVideo_ConversionJob)); /* Clear the padding of the settings, so that they can be compared */
+    job->screen = screen;
+    job->convertRows = convertRows;
+    job->stage = stage;
+    job->settings.conversion = conversion;
+    job->settings.viewportMode = screen->viewportMode;
+    job->settings.rshift = screen->uncorrectedRGBFormat.rshift;
+    job->settings.gshift = screen->uncorrectedRGBFormat.gshift;
+    job->settings.bshift = screen->uncorrectedRGBFormat.bshift;
+    job->settings.ashift = screen->uncorrectedRGBFormat.ashift;
+    job->settings.registerVersion = screen->registerFormat.version;
+    job->settings.bitOffset = screen->bitplaneFormat.bitOffset;
+    job->firstColumn = 0;
+    job->lastColumn = screen->width;
+
+    if(corrected)
+        computeRepeatFactors(screen, &job->settings.repeatHorizontal, &job->settings.repeatVertical);
+    else
+    {
+        job->settings.repeatHorizontal = 1;
+        job->settings.repeatVertical = 1;
+    }
+}
+
+static void convertBitplanesToChunkyPixelRows(const amiVideo_ConversionJob *job, unsigned int firstRow, unsigned int lastRow)
+{
+    amiVideo_Screen *screen = job->screen;
+    const amiVideo_PlanarKernels *kernels = amiVideo_getPlanarKernels();
+    unsigned int bitplaneDepth = screen->bitplaneDepth > 8 ? 8 : screen->bitplaneDepth; /* A chunky pixel can only hold the first 8 bitplanes */
+    amiVideo_UByte *pixels = screen->uncorrectedChunkyFormat.pixels + firstRow * screen->uncorrectedChunkyFormat.pitch;
+    unsigned int i;
+
+    for(i = firstRow; i < lastRow; i++) /* Iterate over each scan line */
+    {
+        amiVideo_UByte *bitplaneRows[AMIVIDEO_MAX_NUM_OF_BITPLANES];
+
+        getBitplaneRows(screen, i, bitplaneRows);
+        kernels->convertBitplaneRowToChunkyPixels(bitplaneRows, bitplaneDepth, pixels, screen->width);
+
+        pixels += screen->uncorrectedChunkyFormat.pitch;
+    }
+}
+
+static void convertIndexesToRGBPixels(const amiVideo_ColorTables *tables, const amiVideo_UByte *indexes, amiVideo_ULong *pixels, unsigned int numOfPixels, amiVideo_ULong *previousPixel)
+{
+    if(amiVideo_checkHoldAndModify(tables->viewportMode))
+        amiVideo_convertHAMIndexesToRGBPixels(&tables->hamTable, indexes, pixels, numOfPixels, previousPixel); /* HAM mode has its own decompression technique */
+    else if(tables->pixelPairs != NULL)
+    {
+        /* Normal mode, looking up two pixels at once */
+        unsigned int i;
+
+        for(i = 0; i + 1 < numOfPixels; i += 2)
+        {
+            const amiVideo_ULong *pair = tables->pixelPairs + 2 * ((indexes[i] << tables->pairIndexBits) | indexes[i + 1]);
+
+            pixels[i] = pair[0];
+            pixels[i + 1] = pair[1];
+        }
+
+        if(i < numOfPixels)
+            pixels[i] = tables->colors[indexes[i]];
+    }
+    else
+    {
+        /* Normal mode */
+        unsigned int i;
+
+        for(i = 0; i < numOfPixels; i++)
+            pixels[i] = tables->colors[indexes[i]];
+    }
+}
+
+static void replicatePixels(amiVideo_ReplicatePixelsKernel kernel, const amiVideo_UByte *source, unsigned int numOfPixels, unsigned int bytesPerPixel, unsigned int repeatHorizontal, amiVideo_UByte *target)
+{
+    if(kernel == NULL)
+    {
+        /* There is no specialized kernel for this repeat factor, so copy each pixel separately */
+        unsigned int i;
+
+        for(i = 0; i < numOfPixels; i++)
+        {
+            unsigned int j;
+
+            for(j = 0; j < repeatHorizontal; j++)
+            {
+                memcpy(target, source, bytesPerPixel);
+                target += bytesPerPixel;
+            }
+
+            source += bytesPerPixel;
+        }
+    }
+    else
+        kernel(source, numOfPixels, target);
+}
+
+static void convertIndexesToWordPixels(const amiVideo_ColorTables *tables, amiVideo_PixelFormat pixelFormat, const amiVideo_UByte *indexes, amiVideo_ULong *rgbBuffer, amiVideo_UWord *pixels, unsigned int numOfPixels, amiVideo_ULong *previousPixel)
+{
+    if(amiVideo_checkHoldAndModify(tables->viewportMode))
+    {
+        /* HAM colors are composed in the internal RGB layout and reduced afterwards */
+        amiVideo_convertHAMIndexesToRGBPixels(&tables->hamTable, indexes, rgbBuffer, numOfPixels, previousPixel);
+
+        if(pixelFormat == AMIVIDEO_PIXEL_FORMAT_RGB565)
+            amiVideo_convertRGBPixelsToRGB565(rgbBuffer, numOfPixels, pixels);
+        else
+            amiVideo_convertRGBPixelsToXRGB1555(rgbBuffer, numOfPixels, pixels);
+    }
+    else
+    {
+        unsigned int i;
+
+        for(i = 0; i < numOfPixels; i++)
+            pixels[i] = tables->wordColors[indexes[i]];
+    }
+}
+
+/*
+ * Obtains the rows of the given bitplanes for a chunk of a scanline that starts
+ * at pixel x. When the chunk does not start at a byte boundary, the rows of the
+ * chunk are aligned in the given buffers.
+ */
+static void getChunkRows(const amiVideo_ConversionJob *job, amiVideo_UByte **bitplaneRows, unsigned int firstBitplane, unsigned int numOfBitplanes, unsigned int x, unsigned int numOfPixels, amiVideo_UByte alignedRows[][AMIVIDEO_ROW_CHUNK_SIZE / 8], amiVideo_UByte **chunkRows)
+{
+    unsigned int position = job->settings.bitOffset + x;
+    unsigned int i;
+
+    for(i = 0; i < numOfBitplanes; i++)
+    {
+        amiVideo_UByte *bitplaneRow = bitplaneRows[firstBitplane + i] + position / 8;
+
+        if(position % 8 == 0)
+            chunkRows[i] = bitplaneRow;
+        else
+        {
+            amiVideo_alignBitplaneRow(bitplaneRow, position % 8, numOfPixels, alignedRows[i]);
+            chunkRows[i] = alignedRows[i];
+        }
+    }
+}
+
+/*
+ * Composes a chunk of true color pixels. Each group of 8 bitplanes is
+ * transposed into the values of a color channel, after which every pixel is
+ * composed with a single write in the order of the target.
+ */
+static void composeTrueColorPixels(const amiVideo_ConversionJob *job, amiVideo_UByte **bitplaneRows, unsigned int x, amiVideo_ULong *pixels, unsigned int numOfPixels)
+{
+    const amiVideo_PlanarKernels *kernels = amiVideo_getPlanarKernels();
+    unsigned int numOfChannels = job->screen->bitplaneDepth / 8;
+    amiVideo_UByte channels[4][AMIVIDEO_ROW_CHUNK_SIZE];
+    amiVideo_UByte alignedRows[8][AMIVIDEO_ROW_CHUNK_SIZE / 8];
+    unsigned int i;
+
+    for(i = 0; i < numOfChannels; i++)
+    {
+        amiVideo_UByte *chunkRows[8];
+
+        getChunkRows(job, bitplaneRows, i * 8, 8, x, numOfPixels, alignedRows, chunkRows);
+        kernels->convertBitplaneRowToChunkyPixels(chunkRows, 8, channels[i], numOfPixels);
+    }
+
+    if(numOfChannels == 3)
+    {
+        for(i = 0; i < numOfPixels; i++)
+            pixels[i] = ((amiVideo_ULong)channels[0][i] << job->channelShifts[0]) | ((amiVideo_ULong)channels[1][i] << job->channelShifts[1]) | ((amiVideo_ULong)channels[2][i] << job->channelShifts[2]);
+    }
+    else
+    {
+        for(i = 0; i < numOfPixels; i++)
+            pixels[i] = ((amiVideo_ULong)channels[0][i] << job->channelShifts[0]) | ((amiVideo_ULong)channels[1][i] << job->channelShifts[1]) | ((amiVideo_ULong)channels[2][i] << job->channelShifts[2]) | ((amiVideo_ULong)channels[3][i] << job->channelShifts[3]);
+    }
+}
+
+/*
+ * Converts a scanline of a true color screen into pixels having the pixel
+ * format of the job that are horizontally repeated repeatHorizontal times. The
+ * scanline is processed in chunks, so that the channel values and pixels of a
+ * chunk stay in the cache.
+ */
+static void convertTrueColorScanLineToPixels(const amiVideo_ConversionJob *job, amiVideo_UByte **bitplaneRows, void *pixels, amiVideo_ReplicatePixelsKernel replicate)
+{
+    amiVideo_PixelFormat pixelFormat = job->settings.pixelFormat;
+    unsigned int bitsPerPixel = getBitsPerPixel(pixelFormat);
+    unsigned int repeatHorizontal = job->settings.repeatHorizontal;
+    amiVideo_ULong rgbBuffer[AMIVIDEO_ROW_CHUNK_SIZE];
+    amiVideo_UWord wordBuffer[AMIVIDEO_ROW_CHUNK_SIZE];
+    amiVideo_UByte *output = (amiVideo_UByte*)pixels;
+    unsigned int x;
+
+    for(x = job->firstColumn; x < job->lastColumn; x += AMIVIDEO_ROW_CHUNK_SIZE)
+    {
+        unsigned int numOfPixels = job->lastColumn - x < AMIVIDEO_ROW_CHUNK_SIZE ? job->lastColumn - x : AMIVIDEO_ROW_CHUNK_SIZE;
+
+        switch(pixelFormat)
+        {
+            case AMIVIDEO_PIXEL_FORMAT_RGB565:
+            case AMIVIDEO_PIXEL_FORMAT_XRGB1555:
+                composeTrueColorPixels(job, bitplaneRows, x, rgbBuffer, numOfPixels);
+
+                if(pixelFormat == AMIVIDEO_PIXEL_FORMAT_RGB565)
+                    amiVideo_convertRGBPixelsToRGB565(rgbBuffer, numOfPixels, repeatHorizontal == 1 ? (amiVideo_UWord*)output : wordBuffer);
+                else
+                    amiVideo_convertRGBPixelsToXRGB1555(rgbBuffer, numOfPixels, repeatHorizontal == 1 ? (amiVideo_UWord*)output : wordBuffer);
+
+                if(repeatHorizontal != 1)
+                    replicatePixels(replicate, (amiVideo_UByte*)wordBuffer, numOfPixels, 2, repeatHorizontal, output);
+                break;
+            case AMIVIDEO_PIXEL_FORMAT_RGB24:
+                composeTrueColorPixels(job, bitplaneRows, x, rgbBuffer, numOfPixels);
+                amiVideo_storeRGB24Pixels(rgbBuffer, numOfPixels, repeatHorizontal, output);
+                break;
+            default:
+                if(repeatHorizontal == 1)
+                    composeTrueColorPixels(job, bitplaneRows, x, (amiVideo_ULong*)output, numOfPixels); /* Compose straight into the output if nothing has to be repeated */
+                else
+                {
+                    composeTrueColorPixels(job, bitplaneRows, x, rgbBuffer, numOfPixels);
+                    replicatePixels(replicate, (amiVideo_UByte*)rgbBuffer, numOfPixels, 4, repeatHorizontal, output);
+                }
+        }
+
+        output += numOfPixels * repeatHorizontal * bitsPerPixel / 8;
+    }
+}
+
+/*
+ * Obtains the index values of a chunk of a scanline that starts at pixel x,
+ * either by decoding the bitplanes (when bitplaneRows is not NULL) into the
+ * given target or by referring to the chunky pixels.
+ */
+static const amiVideo_UByte *getChunkIndexes(const amiVideo_ConversionJob *job, amiVideo_UByte **bitplaneRows, const amiVideo_UByte *chunkyRow, unsigned int x, unsigned int numOfPixels, amiVideo_UByte *target)
+{
+    if(bitplaneRows == NULL)
+        return chunkyRow + x;
+    else
+    {
+        const amiVideo_PlanarKernels *kernels = amiVideo_getPlanarKernels();
+        unsigned int bitplaneDepth = job->screen->bitplaneDepth > 8 ? 8 : job->screen->bitplaneDepth; /* A chunky pixel can only hold the first 8 bitplanes */
+        amiVideo_UByte *chunkRows[8];
+        amiVideo_UByte alignedRows[8][AMIVIDEO_ROW_CHUNK_SIZE / 8];
+
+        getChunkRows(job, bitplaneRows, 0, bitplaneDepth, x, numOfPixels, alignedRows, chunkRows);
+        kernels->convertBitplaneRowToChunkyPixels(chunkRows, bitplaneDepth, target, numOfPixels);
+        return target;
+    }
+}
+
+/*
+ * Converts a single scanline, either from bitplanes (when bitplaneRows is not NULL)
+ * or from chunky pixels, into pixels having the pixel format of the job that
+ * are horizontally repeated repeatHorizontal times.
+ */
+static void convertScanLineToPixels(const amiVideo_ConversionJob *job, const amiVideo_ColorTables *tables, amiVideo_UByte **bitplaneRows, const amiVideo_UByte *chunkyRow, void *pixels, amiVideo_ReplicatePixelsKernel replicate)
+{
+    amiVideo_PixelFormat pixelFormat = job->settings.pixelFormat;
+    unsigned int bitsPerPixel = getBitsPerPixel(pixelFormat);
+    unsigned int repeatHorizontal = job->settings.repeatHorizontal;
+    amiVideo_UByte indexBuffer[AMIVIDEO_ROW_CHUNK_SIZE];
+    amiVideo_ULong rgbBuffer[AMIVIDEO_ROW_CHUNK_SIZE];
+    amiVideo_UWord wordBuffer[AMIVIDEO_ROW_CHUNK_SIZE];
+    amiVideo_ULong previousPixel = tables->colors[0]; /* HAM scanlines start with the background color */
+    amiVideo_UByte *output = (amiVideo_UByte*)pixels;
+    unsigned int x;
+
+    if(job->stage == AMIVIDEO_STAGE_TRUE_COLOR)
+    {
+        convertTrueColorScanLineToPixels(job, bitplaneRows, pixels, replicate); /* True color pixels are not composed from index values */
+        return;
+    }
+
+    /* A HAM pixel depends on the pixels to its left, so the colors of the columns in front of the region are composed first */
+    if(!checkChunkyPixelFormat(pixelFormat) && amiVideo_checkHoldAndModify(tables->viewportMode))
+    {
+        for(x = 0; x < job->firstColumn; x += AMIVIDEO_ROW_CHUNK_SIZE)
+        {
+            unsigned int numOfPixels = job->firstColumn - x < AMIVIDEO_ROW_CHUNK_SIZE ? job->firstColumn - x : AMIVIDEO_ROW_CHUNK_SIZE;
+            const amiVideo_UByte *indexes = getChunkIndexes(job, bitplaneRows, chunkyRow, x, numOfPixels, indexBuffer);
+
+            amiVideo_convertHAMIndexesToRGBPixels(&tables->hamTable, indexes, rgbBuffer, numOfPixels, &previousPixel);
+        }
+    }
+
+    for(x = job->firstColumn; x < job->lastColumn; x += AMIVIDEO_ROW_CHUNK_SIZE) /* Process the scanline in chunks that stay in the cache */
+    {
+        unsigned int numOfPixels = job->lastColumn - x < AMIVIDEO_ROW_CHUNK_SIZE ? job->lastColumn - x : AMIVIDEO_ROW_CHUNK_SIZE;
+        amiVideo_UByte *target = (pixelFormat == AMIVIDEO_PIXEL_FORMAT_CHUNKY8 && repeatHorizontal == 1) ? output : indexBuffer; /* Decode straight into the output if nothing has to be repeated */
+        const amiVideo_UByte *indexes = getChunkIndexes(job, bitplaneRows, chunkyRow, x, numOfPixels, target);
+
+        /* Write the chunk to the output in the pixel format of the target */
+        switch(pixelFormat)
+        {
+            case AMIVIDEO_PIXEL_FORMAT_CHUNKY8:
+                if(indexes != output)
+                    replicatePixels(replicate, indexes, numOfPixels, 1, repeatHorizontal, output);
+                break;
+            case AMIVIDEO_PIXEL_FORMAT_CHUNKY4:
+                amiVideo_storeChunky4Pixels(indexes, numOfPixels, repeatHorizontal, output);
+                break;
+            case AMIVIDEO_PIXEL_FORMAT_RGB565:
+            case AMIVIDEO_PIXEL_FORMAT_XRGB1555:
+                if(repeatHorizontal == 1)
+                    convertIndexesToWordPixels(tables, pixelFormat, indexes, rgbBuffer, (amiVideo_UWord*)output, numOfPixels, &previousPixel);
+                else
+                {
+                    convertIndexesToWordPixels(tables, pixelFormat, indexes, rgbBuffer, wordBuffer, numOfPixels, &previousPixel);
+                    replicatePixels(replicate, (amiVideo_UByte*)wordBuffer, numOfPixels, 2, repeatHorizontal, output);
+                }
+                break;
+            case AMIVIDEO_PIXEL_FORMAT_RGB24:
+                convertIndexesToRGBPixels(tables, indexes, rgbBuffer, numOfPixels, &previousPixel);
+                amiVideo_storeRGB24Pixels(rgbBuffer, numOfPixels, repeatHorizontal, output);
+                break;
+            default:
+                if(repeatHorizontal == 1)
+                    convertIndexesToRGBPixels(tables, indexes, (amiVideo_ULong*)output, numOfPixels, &previousPixel);
+                else
+                {
+                    convertIndexesToRGBPixels(tables, indexes, rgbBuffer, numOfPixels, &previousPixel);
+                    replicatePixels(replicate, (amiVideo_UByte*)rgbBuffer, numOfPixels, 4, repeatHorizontal, output);
+                }
+        }
+
+        output += numOfPixels * repeatHorizontal * bitsPerPixel / 8; /* A chunk has an even amount of pixels, unless it is the last */
+    }
+}
+
+/*
+ * Converts a range of scanlines, either from bitplanes or from chunky pixels,
+ * into the target surface of the job. Every scanline is decoded once,
+ * horizontally repeated while it is written and then duplicated
+ * repeatVertical - 1 times.
+ */
+static void convertPixelRows(const amiVideo_ConversionJob *job, unsigned int firstRow, unsigned int lastRow)
+{
+    amiVideo_Screen *screen = job->screen;
+    unsigned int bitsPerPixel = getBitsPerPixel(job->settings.pixelFormat);
+    amiVideo_ReplicatePixelsKernel replicate = amiVideo_getReplicatePixelsKernel(bitsPerPixel / 8, job->settings.repeatHorizontal);
+    amiVideo_DuplicateScanLineKernel duplicateScanLine = amiVideo_getDuplicateScanLineKernel(screen->height * job->settings.repeatVertical * job->settings.pitch);
+    const amiVideo_UByte *chunkyRow = screen->uncorrectedChunkyFormat.pixels + firstRow * screen->uncorrectedChunkyFormat.pitch;
+    amiVideo_UByte *output = (amiVideo_UByte*)job->settings.pixels + firstRow * job->settings.repeatVertical * job->settings.pitch + job->firstColumn * job->settings.repeatHorizontal * bitsPerPixel / 8;
+    unsigned int rowSize = ((job->lastColumn - job->firstColumn) * job->settings.repeatHorizontal * bitsPerPixel + 7) / 8;
+    const amiVideo_ColorTables *tables = &job->tables;
+    unsigned int nextTables = 0;
+    unsigned int i;
+
+    if(job->settings.repeatHorizontal == 0 || job->settings.repeatVertical == 0)
+        return; /* The scale factor is too small to display any pixel */
+
+    for(i = firstRow; i < lastRow; i++) /* Iterate over each scan line */
+    {
+        unsigned int j;
+
+        /* Switch to the lookup tables of the registers that have been changed up to this scanline */
+        while(nextTables < job->numOfLineTables && job->lineTables[nextTables].firstRow <= i)
+            tables = &job->lineTables[nextTables++];
+
+        if(job->fromBitplanes)
+        {
+            amiVideo_UByte *bitplaneRows[AMIVIDEO_MAX_NUM_OF_BITPLANES];
+
+            getBitplaneRows(screen, i, bitplaneRows);
+            convertScanLineToPixels(job, tables, bitplaneRows, NULL, output, replicate);
+        }
+        else
+        {
+            convertScanLineToPixels(job, tables, NULL, chunkyRow, output, replicate);
+            chunkyRow += screen->uncorrectedChunkyFormat.pitch;
+        }
+
+        /* Non-interlace screen scanlines must be doubled */
+        for(j = 1; j < job->settings.repeatVertical; j++)
+            duplicateScanLine(output + j * job->settings.pitch, output, rowSize);
+
+        output += job->settings.repeatVertical * job->settings.pitch;
+    }
+}
+
+static void initColorTables(amiVideo_ColorTables *tables, const amiVideo_Screen *screen, unsigned int firstRow, amiVideo_Long viewportMode, const amiVideo_ULong *colors, const amiVideo_ConversionSettings *settings)
+{
+    tables->firstRow = firstRow;
+    tables->viewportMode = viewportMode;
+    tables->pixelPairs = NULL;
+    tables->pairIndexBits = 0;
+    memcpy(tables->colors, colors, sizeof(tables->colors));
+
+    if(amiVideo_checkHoldAndModify(viewportMode))
+        amiVideo_initHAMTable(&tables->hamTable, screen->bitplaneDepth, tables->colors, settings->rshift, settings->gshift, settings->bshift);
+    else if(settings->pixelFormat == AMIVIDEO_PIXEL_FORMAT_RGB565)
+        amiVideo_convertRGBPixelsToRGB565(tables->colors, 256, tables->wordColors);
+    else if(settings->pixelFormat == AMIVIDEO_PIXEL_FORMAT_XRGB1555)
+        amiVideo_convertRGBPixelsToXRGB1555(tables->colors, 256, tables->wordColors);
+}
+
+static void applyRegisterChange(amiVideo_Palette *palette, amiVideo_Long *viewportMode, const amiVideo_RegisterChange *change)
+{
+    if(change->reg == AMIVIDEO_REGISTER_VIEWPORT_MODE)
+    {
+        /* Only the display modes that affect the color lookups can be switched within a frame */
+        amiVideo_Long mask = AMIVIDEO_VIDEOPORTMODE_HAM | AMIVIDEO_VIDEOPORTMODE_EHB;
+        *viewportMode = (*viewportMode & ~mask) | (change->viewportMode & mask);
+    }
+    else if(change->reg < palette->bitplaneFormat.numOfColors)
+        palette->bitplaneFormat.color[change->reg] = change->color;
+}
+
+static int initLineTables(amiVideo_ConversionJob *job)
+{
+    amiVideo_Screen *screen = job->screen;
+    struct amiVideo_RegisterState *state = screen->registerFormat.state;
+    const amiVideo_RegisterChange *changes = screen->registerFormat.changes;
+    unsigned int numOfChanges = screen->registerFormat.numOfChanges;
+    amiVideo_Long viewportMode = screen->viewportMode;
+    unsigned int i = 0;
+
+    /* The tables only have to be computed again when the registers, the colors or the pixel layout have changed */
+    if(state->valid
+        && state->version == screen->registerFormat.version
+        && state->paletteVersion == screen->palette.rgbFormat.version
+        && state->pixelFormat == job->settings.pixelFormat
+        && state->rshift == job->settings.rshift
+        && state->gshift == job->settings.gshift
+        && state->bshift == job->settings.bshift
+        && state->ashift == job->settings.ashift)
+    {
+        job->lineTables = state->tables;
+        job->numOfLineTables = state->numOfTables;
+        return TRUE;
+    }
+
+    /* Start from the registers of the screen */
+    amiVideo_reinitPalette(&state->palette, screen->bitplaneDepth, screen->palette.bitplaneFormat.bitsPerColorChannel, viewportMode);
+
+    if(state->palette.bitplaneFormat.color == NULL || state->palette.chunkyFormat.color == NULL)
+        return FALSE;
+
+    memcpy(state->palette.bitplaneFormat.color, screen->palette.bitplaneFormat.color, screen->palette.bitplaneFormat.numOfColors * sizeof(amiVideo_Color));
+    state->numOfTables = 0;
+
+    /* Every scanline on which registers change starts a new range that has its own tables */
+    do
+    {
+        unsigned int firstRow = state->numOfTables == 0 ? 0 : changes[i].row;
+        const amiVideo_ULong *colors;
+
+        while(i < numOfChanges && changes[i].row <= firstRow)
+            applyRegisterChange(&state->palette, &viewportMode, &changes[i++]);
+
+        amiVideo_reinitPalette(&state->palette, screen->bitplaneDepth, screen->palette.bitplaneFormat.bitsPerColorChannel, viewportMode);
+
+        if(state->palette.chunkyFormat.color == NULL)
+            return FALSE;
+
+        amiVideo_convertBitplaneColorsToChunkyFormat(&state->palette);
+        colors = amiVideo_getPaletteRGBPixels(&state->palette, job->settings.rshift, job->settings.gshift, job->settings.bshift, job->settings.ashift);
+        initColorTables(&state->tables[state->numOfTables++], screen, firstRow, viewportMode, colors, &job->settings);
+    }
+    while(i < numOfChanges);
+
+    state->valid = TRUE;
+    state->version = screen->registerFormat.version;
+    state->paletteVersion = screen->palette.rgbFormat.version;
+    state->pixelFormat = job->settings.pixelFormat;
+    state->rshift = job->settings.rshift;
+    state->gshift = job->settings.gshift;
+    state->bshift = job->settings.bshift;
+    state->ashift = job->settings.ashift;
+
+    job->lineTables = state->tables;
+    job->numOfLineTables = state->numOfTables;
+    return TRUE;
+}
+
+static void initPixelConversionJob(amiVideo_ConversionJob *job, amiVideo_Screen *screen, int conversion, int fromBitplanes, void *pixels, unsigned int pitch, amiVideo_PixelFormat pixelFormat, int corrected)
+{
+    AMIVIDEO_DECLARE_TIMESTAMP(start)
+
+    initConversionJob(job, screen, convertPixelRows, AMIVIDEO_STAGE_PLANAR_DECODE, conversion, corrected);
+    job->fromBitplanes = fromBitplanes;
+    job->settings.pixels = pixels;
+    job->settings.pitch = pitch;
+    job->settings.pixelFormat = pixelFormat;
+
+    /* The compact RGB formats are composed from pixels in a fixed layout */
+    if(!checkChunkyPixelFormat(pixelFormat) && pixelFormat != AMIVIDEO_PIXEL_FORMAT_RGB32)
+    {
+        job->settings.rshift = AMIVIDEO_COMPACT_RSHIFT;
+        job->settings.gshift = AMIVIDEO_COMPACT_GSHIFT;
+        job->settings.bshift = AMIVIDEO_COMPACT_BSHIFT;
+        job->settings.ashift = AMIVIDEO_COMPACT_ASHIFT;
+    }
+
+    if(fromBitplanes && !checkChunkyPixelFormat(pixelFormat) && (screen->bitplaneDepth == 24 || screen->bitplaneDepth == 32))
+    {
+        job->stage = AMIVIDEO_STAGE_TRUE_COLOR;
+
+        /* 24 bitplanes store the blue, green and red values, 32 bitplanes are preceded by the alpha values */
+        if(screen->bitplaneDepth == 24)
+        {
+            job->channelShifts[0] = job->settings.bshift;
+            job->channelShifts[1] = job->settings.gshift;
+            job->channelShifts[2] = job->settings.rshift;
+        }
+        else
+        {
+            job->channelShifts[0] = job->settings.ashift;
+            job->channelShifts[1] = job->settings.bshift;
+            job->channelShifts[2] = job->settings.gshift;
+            job->channelShifts[3] = job->settings.rshift;
+        }
+    }
+    else if(!checkChunkyPixelFormat(pixelFormat))
+    {
+        const amiVideo_ULong *colors;
+
+        AMIVIDEO_START_STAGE(start);
+        job->stage = amiVideo_checkHoldAndModify(screen->viewportMode) ? AMIVIDEO_STAGE_HAM_DECODE : AMIVIDEO_STAGE_COLOR_LOOKUP;
+
+        /* The bitplane colors may have been modified since the previous conversion */
+        if(fromBitplanes)
+            amiVideo_convertBitplaneColorsToChunkyFormat(&screen->palette);
+
+        /* The palette caches its RGB pixel values, so they only have to be recomputed when the colors have changed */
+        colors = amiVideo_getPaletteRGBPixels(&screen->palette, job->settings.rshift, job->settings.gshift, job->settings.bshift, job->settings.ashift);
+        memcpy(job->settings.colors, colors, sizeof(job->settings.colors));
+
+        initColorTables(&job->tables, screen, 0, screen->viewportMode, colors, &job->settings);
+
+        if(pixelFormat == AMIVIDEO_PIXEL_FORMAT_RGB32 && fromBitplanes && !amiVideo_checkHoldAndModify(screen->viewportMode))
+        {
+            /* Decoded bitplanes never exceed the bitplane depth, so two indexes can safely be combined into a pixel pair table index */
+            unsigned int pairIndexBits;
+            const amiVideo_ULong *pixelPairs = amiVideo_getPaletteRGBPixelPairs(&screen->palette, job->settings.rshift, job->settings.gshift, job->settings.bshift, job->settings.ashift, &pairIndexBits);
+
+            if(pixelPairs != NULL && pairIndexBits >= screen->bitplaneDepth)
+            {
+                job->tables.pixelPairs = pixelPairs;
+                job->tables.pairIndexBits = pairIndexBits;
+            }
+        }
+
+        /* Registers that change halfway the frame only affect the colors, so the index values of chunky pixels are never affected */
+        if(screen->registerFormat.numOfChanges > 0 && screen->bitplaneDepth <= 8 && !initLineTables(job))
+        {
+            job->lineTables = NULL; /* Fall back to the registers of the screen if the tables can not be allocated */
+            job->numOfLineTables = 0;
+        }
+
+        AMIVIDEO_FINISH_STAGE(screen, AMIVIDEO_STAGE_PALETTE, start, 0, 0);
+    }
+}
+
+void amiVideo_convertScreenBitplanesToChunkyPixelsParallel(amiVideo_Screen *screen, unsigned int numOfThreads, amiVideo_Executor executor, void *executorData)
+{
+    amiVideo_ConversionJob job;
+
+    if(screen->uncorrectedChunkyFormat.pixelFormat == AMIVIDEO_PIXEL_FORMAT_CHUNKY4 || screen->bitplaneFormat.bitOffset != 0 || screen->deltaFormat.valid)
+        initPixelConversionJob(&job, screen, CONVERSION_BITPLANES_TO_CHUNKY, TRUE, screen->uncorrectedChunkyFormat.pixels, screen->uncorrectedChunkyFormat.pitch, screen->uncorrectedChunkyFormat.pixelFormat, FALSE); /* Packed pixels, scanlines that do not start at a byte boundary and the columns modified by a delta are handled by the fused conversion */
+    else
+    {
+        initConversionJob(&job, screen, convertBitplanesToChunkyPixelRows, AMIVIDEO_STAGE_PLANAR_DECODE, CONVERSION_BITPLANES_TO_CHUNKY, FALSE);
+        job.settings.pixels = screen->uncorrectedChunkyFormat.pixels;
+        job.settings.pitch = screen->uncorrectedChunkyFormat.pitch;
+        job.settings.pixelFormat = AMIVIDEO_PIXEL_FORMAT_CHUNKY8;
+    }
+
+    runConversionJob(&job, NULL, numOfThreads, executor, executorData);
+}
+
+void amiVideo_convertScreenBitplanesToChunkyPixels(amiVideo_Screen *screen)
+{
+    amiVideo_convertScreenBitplanesToChunkyPixelsParallel(screen, 1, NULL, NULL);
+}
+
+void amiVideo_convertScreenBitplanesToChunkyPixelsRegion(amiVideo_Screen *screen, const amiVideo_Region *region)
+{
+    amiVideo_ConversionJob job;
+
+    initPixelConversionJob(&job, screen, CONVERSION_BITPLANES_TO_CHUNKY, TRUE, screen->uncorrectedChunkyFormat.pixels, screen->uncorrectedChunkyFormat.pitch, screen->uncorrectedChunkyFormat.pixelFormat, FALSE); /* The fused conversion decodes only the bytes of the bitplanes that overlap with the region */
+    runConversionJob(&job, region, 1, NULL, NULL);
+}
+
+void amiVideo_convertScreenChunkyPixelsToRGBPixelsParallel(amiVideo_Screen *screen, unsigned int numOfThreads, amiVideo_Executor executor, void *executorData)
+{
+    amiVideo_ConversionJob job;
+
+    initPixelConversionJob(&job, screen, CONVERSION_NONE, FALSE, screen->uncorrectedRGBFormat.pixels, screen->uncorrectedRGBFormat.pitch, screen->uncorrectedRGBFormat.pixelFormat, FALSE);
+    runConversionJob(&job, NULL, numOfThreads, executor, executorData);
+}
+
+void amiVideo_convertScreenChunkyPixelsToRGBPixels(amiVideo_Screen *screen)
+{
+    amiVideo_convertScreenChunkyPixelsToRGBPixelsParallel(screen, 1, NULL, NULL);
+}
+
+void amiVideo_convertScreenChunkyPixelsToRGBPixelsRegion(amiVideo_Screen *screen, const amiVideo_Region *region)
+{
+    amiVideo_ConversionJob job;
+
+    initPixelConversionJob(&job, screen, CONVERSION_NONE, FALSE, screen->uncorrectedRGBFormat.pixels, screen->uncorrectedRGBFormat.pitch, screen->uncorrectedRGBFormat.pixelFormat, FALSE);
+    runConversionJob(&job, region, 1, NULL, NULL);
+}
+
+static void convertChunkyPixelsToBitplaneRows(const amiVideo_ConversionJob *job, unsigned int firstRow, unsigned int lastRow)
+{
+    amiVideo_Screen *screen = job->screen;
+    const amiVideo_PlanarKernels *kernels = amiVideo_getPlanarKernels();
+    unsigned int bitplaneDepth = screen->bitplaneDepth > 8 ? 8 : screen->bitplaneDepth; /* A chunky pixel can only hold the first 8 bitplanes */
+    const amiVideo_UByte *pixels = screen->uncorrectedChunkyFormat.pixels + firstRow * screen->uncorrectedChunkyFormat.pitch;
+    unsigned int i;
+
+    for(i = firstRow; i < lastRow; i++) /* Iterate over each scan line */
+    {
+        amiVideo_UByte *bitplaneRows[AMIVIDEO_MAX_NUM_OF_BITPLANES];
+
+        getBitplaneRows(screen, i, bitplaneRows);
+
+        if(!screen->bitplaneFormat.playfield && !job->partial)
+            kernels->convertChunkyPixelsToBitplaneRow(pixels, screen->width, bitplaneRows, bitplaneDepth, screen->bitplaneFormat.pitch);
+        else
+        {
+            /* Encode the scanline in aligned chunks that are merged with the surrounding pixels, as the playfield or the region may not start at a byte boundary */
+            unsigned int x;
+
+            for(x = job->firstColumn; x < job->lastColumn; x += AMIVIDEO_ROW_CHUNK_SIZE)
+            {
+                amiVideo_UByte alignedRows[8][AMIVIDEO_ROW_CHUNK_SIZE / 8];
+                amiVideo_UByte *chunkRows[8];
+                unsigned int numOfPixels = job->lastColumn - x < AMIVIDEO_ROW_CHUNK_SIZE ? job->lastColumn - x : AMIVIDEO_ROW_CHUNK_SIZE;
+                unsigned int position = screen->bitplaneFormat.bitOffset + x;
+                unsigned int j;
+
+                for(j = 0; j < bitplaneDepth; j++)
+                    chunkRows[j] = alignedRows[j];
+
+                kernels->convertChunkyPixelsToBitplaneRow(pixels + x, numOfPixels, chunkRows, bitplaneDepth, AMIVIDEO_ROW_CHUNK_SIZE / 8);
+
+                for(j = 0; j < bitplaneDepth; j++)
+                    amiVideo_storeAlignedBitplaneRow(alignedRows[j], numOfPixels, position % 8, bitplaneRows[j] + position / 8);
+            }
+        }
+
+        pixels += screen->uncorrectedChunkyFormat.pitch;
+    }
+}
+
+void amiVideo_convertScreenChunkyPixelsToBitplanesParallel(amiVideo_Screen *screen, unsigned int numOfThreads, amiVideo_Executor executor, void *executorData)
+{
+    amiVideo_ConversionJob job;
+
+    initConversionJob(&job, screen, convertChunkyPixelsToBitplaneRows, AMIVIDEO_STAGE_PLANAR_ENCODE, CONVERSION_NONE, FALSE);
+    runConversionJob(&job, NULL, numOfThreads, executor, executorData);
+}
+
+void amiVideo_convertScreenChunkyPixelsToBitplanes(amiVideo_Screen *screen)
+{
+    amiVideo_convertScreenChunkyPixelsToBitplanesParallel(screen, 1, NULL, NULL);
+}
+
+void amiVideo_convertScreenChunkyPixelsToBitplanesRegion(amiVideo_Screen *screen, const amiVideo_Region *region)
+{
+    amiVideo_ConversionJob job;
+
+    initConversionJob(&job, screen, convertChunkyPixelsToBitplaneRows, AMIVIDEO_STAGE_PLANAR_ENCODE, CONVERSION_NONE, FALSE);
+    runConversionJob(&job, region, 1, NULL, NULL);
+}
+
+static void correctPixelRows(const amiVideo_ConversionJob *job, unsigned int firstRow, unsigned int lastRow)
+{
+    amiVideo_Screen *screen = job->screen;
+    amiVideo_ReplicatePixelsKernel replicate;
+    amiVideo_DuplicateScanLineKernel duplicateScanLine;
+    unsigned int repeatHorizontal, repeatVertical;
+    amiVideo_PixelFormat pixelFormat = screen->correctedFormat.pixelFormat;
+    unsigned int bitsPerPixel = getBitsPerPixel(pixelFormat);
+    unsigned int rowSize;
+    const amiVideo_UByte *pixels;
+    unsigned int pitch;
+    amiVideo_UByte *output;
+    unsigned int i;
+
+    /* The repeat factors of the viewport mode determine which kernel replicates the pixels */
+    computeRepeatFactors(screen, &repeatHorizontal, &repeatVertical);
+    replicate = amiVideo_getReplicatePixelsKernel(bitsPerPixel / 8, repeatHorizontal);
+    duplicateScanLine = amiVideo_getDuplicateScanLineKernel(screen->height * repeatVertical * screen->correctedFormat.pitch);
+    rowSize = ((job->lastColumn - job->firstColumn) * repeatHorizontal * bitsPerPixel + 7) / 8;
+
+    /* Check which pixels we have to correct. Chunky pixels are always read from 8-bit pixels, RGB pixels have the same format as the target */
+
+    if(checkChunkyPixelFormat(pixelFormat))
+    {
+        pixels = screen->uncorrectedChunkyFormat.pixels + job->firstColumn;
+        pitch = screen->uncorrectedChunkyFormat.pitch;
+    }
+    else
+    {
+        pixels = (amiVideo_UByte*)screen->uncorrectedRGBFormat.pixels + job->firstColumn * bitsPerPixel / 8;
+        pitch = screen->uncorrectedRGBFormat.pitch;
+    }
+
+    pixels += firstRow * pitch;
+    output = (amiVideo_UByte*)screen->correctedFormat.pixels + firstRow * repeatVertical * screen->correctedFormat.pitch + job->firstColumn * repeatHorizontal * bitsPerPixel / 8;
+
+    /* Do the correction */
+    for(i = firstRow; i < lastRow; i++)
+    {
+        unsigned int j;
+
+        /* Scale the scanline horizontally */
+        if(pixelFormat == AMIVIDEO_PIXEL_FORMAT_CHUNKY4)
+            amiVideo_storeChunky4Pixels(pixels, job->lastColumn - job->firstColumn, repeatHorizontal, output);
+        else
+            replicatePixels(replicate, pixels, job->lastColumn - job->firstColumn, bitsPerPixel / 8, repeatHorizontal, output);
+
+        /* Non-interlace screen scanlines must be doubled */
+        for(j = 1; j < repeatVertical; j++)
+            duplicateScanLine(output + j * screen->correctedFormat.pitch, output, rowSize);
+
+        pixels += pitch;
+        output += repeatVertical * screen->correctedFormat.pitch;
+    }
+}
+
+void amiVideo_correctScreenPixelsParallel(amiVideo_Screen *screen, unsigned int numOfThreads, amiVideo_Executor executor, void *executorData)
+{
+    amiVideo_ConversionJob job;
+
+    initConversionJob(&job, screen, correctPixelRows, AMIVIDEO_STAGE_CORRECTION, CONVERSION_NONE, TRUE);
+    job.settings.pixelFormat = screen->correctedFormat.pixelFormat;
+    runConversionJob(&job, NULL, numOfThreads, executor, executorData);
+}
+
+void amiVideo_correctScreenPixels(amiVideo_Screen *screen)
+{
+    amiVideo_correctScreenPixelsParallel(screen, 1, NULL, NULL);
+}
+
+void amiVideo_correctScreenPixelsRegion(amiVideo_Screen *screen, const amiVideo_Region *region)
+{
+    amiVideo_ConversionJob job;
+
+    initConversionJob(&job, screen, correctPixelRows, AMIVIDEO_STAGE_CORRECTION, CONVERSION_NONE, TRUE);
+    job.settings.pixelFormat = screen->correctedFormat.pixelFormat;
+    runConversionJob(&job, region, 1, NULL, NULL);
+}
+
+static void reorderRGBPixelRows(amiVideo_Screen *screen, unsigned int firstRow, unsigned int lastRow)
+{
+    amiVideo_SwizzleLayout layout;
+    amiVideo_ULong *pixels = screen->uncorrectedRGBFormat.pixels + firstRow * (screen->uncorrectedRGBFormat.pitch / 4);
+    unsigned int i;
+
+    /* 24 bitplanes represent 0RGB pixels, 32 bitplanes represent RGBA pixels */
+    if(screen->bitplaneDepth == 24)
+        amiVideo_compileSwizzleLayout(&layout, 16, 8, 0, 24, screen->uncorrectedRGBFormat.rshift, screen->uncorrectedRGBFormat.gshift, screen->uncorrectedRGBFormat.bshift, screen->uncorrectedRGBFormat.ashift);
+    else if(screen->bitplaneDepth == 32)
+        amiVideo_compileSwizzleLayout(&layout, 24, 16, 8, 0, screen->uncorrectedRGBFormat.rshift, screen->uncorrectedRGBFormat.gshift, screen->uncorrectedRGBFormat.bshift, screen->uncorrectedRGBFormat.ashift);
+    else
+        return;
+
+    if(layout.identity)
+        return; /* The display uses the same byte order */
+
+    for(i = firstRow; i < lastRow; i++)
+    {
+        amiVideo_swizzlePixels(&layout, pixels, screen->width, pixels);
+        pixels += screen->uncorrectedRGBFormat.pitch / 4;
+    }
+}
+
+void amiVideo_convertScreenBitplanesToRGBPixelsParallel(amiVideo_Screen *screen, unsigned int numOfThreads, amiVideo_Executor executor, void *executorData)
+{
+    amiVideo_ConversionJob job;
+
+    /* We decode the bitplanes straight into color values. HAM colors are composed while decoding and true color pixels are composed in the order of the target */
+    initPixelConversionJob(&job, screen, CONVERSION_BITPLANES_TO_RGB, TRUE, screen->uncorrectedRGBFormat.pixels, screen->uncorrectedRGBFormat.pitch, screen->uncorrectedRGBFormat.pixelFormat, FALSE);
+    runConversionJob(&job, NULL, numOfThreads, executor, executorData);
+}
+
+void amiVideo_convertScreenBitplanesToRGBPixels(amiVideo_Screen *screen)
+{
+    amiVideo_convertScreenBitplanesToRGBPixelsParallel(screen, 1, NULL, NULL);
+}
+
+void amiVideo_convertScreenBitplanesToRGBPixelsRegion(amiVideo_Screen *screen, const amiVideo_Region *region)
+{
+    amiVideo_ConversionJob job;
+
+    initPixelConversionJob(&job, screen, CONVERSION_BITPLANES_TO_RGB, TRUE, screen->uncorrectedRGBFormat.pixels, screen->uncorrectedRGBFormat.pitch, screen->uncorrectedRGBFormat.pixelFormat, FALSE);
+    runConversionJob(&job, region, 1, NULL, NULL);
+}
+
+void amiVideo_convertScreenBitplanesToCorrectedChunkyPixelsParallel(amiVideo_Screen *screen, unsigned int numOfThreads, amiVideo_Executor executor, void *executorData)
+{
+    amiVideo_ConversionJob job;
+
+    initPixelConversionJob(&job, screen, CONVERSION_BITPLANES_TO_CORRECTED_CHUNKY, TRUE, screen->correctedFormat.pixels, screen->correctedFormat.pitch, selectChunkyPixelFormat(screen->correctedFormat.pixelFormat), TRUE);
+    runConversionJob(&job, NULL, numOfThreads, executor, executorData);
+}
+
+void amiVideo_convertScreenBitplanesToCorrectedChunkyPixels(amiVideo_Screen *screen)
+{
+    amiVideo_convertScreenBitplanesToCorrectedChunkyPixelsParallel(screen, 1, NULL, NULL);
+}
+
+void amiVideo_convertScreenBitplanesToCorrectedChunkyPixelsRegion(amiVideo_Screen *screen, const amiVideo_Region *region)
+{
+    amiVideo_ConversionJob job;
+
+    initPixelConversionJob(&job, screen, CONVERSION_BITPLANES_TO_CORRECTED_CHUNKY, TRUE, screen->correctedFormat.pixels, screen->correctedFormat.pitch, selectChunkyPixelFormat(screen->correctedFormat.pixelFormat), TRUE);
+    runConversionJob(&job, region, 1, NULL, NULL);
+}
+
+void amiVideo_convertScreenBitplanesToCorrectedRGBPixelsParallel(amiVideo_Screen *screen, unsigned int numOfThreads, amiVideo_Executor executor, void *executorData)
+{
+    amiVideo_ConversionJob job;
+
+    initPixelConversionJob(&job, screen, CONVERSION_BITPLANES_TO_CORRECTED_RGB, TRUE, screen->correctedFormat.pixels, screen->correctedFormat.pitch, selectRGBPixelFormat(screen->correctedFormat.pixelFormat), TRUE);
+    runConversionJob(&job, NULL, numOfThreads, executor, executorData);
+}
+
+void amiVideo_convertScreenBitplanesToCorrectedRGBPixels(amiVideo_Screen *screen)
+{
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixelsParallel(screen, 1, NULL, NULL);
+}
+
+void amiVideo_convertScreenBitplanesToCorrectedRGBPixelsRegion(amiVideo_Screen *screen, const amiVideo_Region *region)
+{
+    amiVideo_ConversionJob job;
+
+    initPixelConversionJob(&job, screen, CONVERSION_BITPLANES_TO_CORRECTED_RGB, TRUE, screen->correctedFormat.pixels, screen->correctedFormat.pitch, selectRGBPixelFormat(screen->correctedFormat.pixelFormat), TRUE);
+    runConversionJob(&job, region, 1, NULL, NULL);
+}
+
+void amiVideo_convertScreenChunkyPixelsToCorrectedRGBPixelsParallel(amiVideo_Screen *screen, unsigned int numOfThreads, amiVideo_Executor executor, void *executorData)
+{
+    amiVideo_ConversionJob job;
+
+    initPixelConversionJob(&job, screen, CONVERSION_NONE, FALSE, screen->correctedFormat.pixels, screen->correctedFormat.pitch, selectRGBPixelFormat(screen->correctedFormat.pixelFormat), TRUE);
+    runConversionJob(&job, NULL, numOfThreads, executor, executorData);
+}
+
+void amiVideo_convertScreenChunkyPixelsToCorrectedRGBPixels(amiVideo_Screen *screen)
+{
+    amiVideo_convertScreenChunkyPixelsToCorrectedRGBPixelsParallel(screen, 1, NULL, NULL);
+}
+
+void amiVideo_convertScreenChunkyPixelsToCorrectedRGBPixelsRegion(amiVideo_Screen *screen, const amiVideo_Region *region)
+{
+    amiVideo_ConversionJob job;
+
+    initPixelConversionJob(&job, screen, CONVERSION_NONE, FALSE, screen->correctedFormat.pixels, screen->correctedFormat.pitch, selectRGBPixelFormat(screen->correctedFormat.pixelFormat), TRUE);
+    runConversionJob(&job, region, 1, NULL, NULL);
+}
+
+void amiVideo_calculateThumbnailSize(const amiVideo_Screen *screen, unsigned int maxWidth, unsigned int maxHeight, unsigned int *width, unsigned int *height)
+{
+    /* The displayed size takes the resolution and interlace bits of the viewport mode into account */
+    unsigned long displayWidth = amiVideo_calculateCorrectedWidth(4, screen->width, screen->viewportMode);
+    unsigned long displayHeight = amiVideo_calculateCorrectedHeight(4, screen->height, screen->viewportMode);
+
+    if(displayWidth == 0 || displayHeight == 0 || maxWidth == 0 || maxHeight == 0)
+    {
+        *width = 0;
+        *height = 0;
+    }
+    else if(displayWidth * maxHeight > displayHeight * maxWidth)
+    {
+        *width = maxWidth;
+        *height = displayHeight * maxWidth / displayWidth;
+    }
+    else
+    {
+        *width = displayWidth * maxHeight / displayHeight;
+        *height = maxHeight;
+    }
+
+    /* A thumbnail of an extremely wide or tall screen still has one pixel */
+    if(*width == 0 && maxWidth > 0 && displayWidth > 0)
+        *width = 1;
+
+    if(*height == 0 && maxHeight > 0 && displayHeight > 0)
+        *height = 1;
+}
+
+static const amiVideo_ColorTables *getRowTables(const amiVideo_ConversionJob *job, unsigned int row)
+{
+    const amiVideo_ColorTables *tables = &job->tables;
+    unsigned int i;
+
+    for(i = 0; i < job->numOfLineTables && job->lineTables[i].firstRow <= row; i++)
+        tables = &job->lineTables[i];
+
+    return tables;
+}
+
+/* Composes the pixel at column x of a scanline from its bits only, which is impossible for HAM pixels */
+static amiVideo_ULong samplePixel(const amiVideo_ConversionJob *job, const amiVideo_ColorTables *tables, amiVideo_UByte **bitplaneRows, unsigned int x)
+{
+    unsigned int position = job->settings.bitOffset + x;
+    unsigned int bitplaneDepth = job->stage == AMIVIDEO_STAGE_TRUE_COLOR || job->screen->bitplaneDepth <= 8 ? job->screen->bitplaneDepth : 8; /* A palette index can only hold the first 8 bitplanes */
+    amiVideo_ULong value = 0;
+    unsigned int i;
+
+    for(i = 0; i < bitplaneDepth; i++)
+        value |= (amiVideo_ULong)((bitplaneRows[i][position / 8] >> (7 - position % 8)) & 1) << i;
+
+    if(job->stage == AMIVIDEO_STAGE_TRUE_COLOR)
+    {
+        amiVideo_ULong pixel = 0;
+
+        for(i = 0; i < bitplaneDepth / 8; i++)
+            pixel |= ((value >> (i * 8)) & 0xff) << job->channelShifts[i];
+
+        return pixel;
+    }
+    else
+        return tables->colors[value];
+}
+
+int amiVideo_convertScreenBitplanesToThumbnail(amiVideo_Screen *screen, amiVideo_ULong *pixels, unsigned int width, unsigned int height, unsigned int pitch, amiVideo_ThumbnailFilter filter, amiVideo_UByte rshift, amiVideo_UByte gshift, amiVideo_UByte bshift, amiVideo_UByte ashift)
+{
+    amiVideo_ConversionJob job;
+    amiVideo_SwizzleLayout layout;
+    amiVideo_ULong *rowPixels, *columnSums;
+    unsigned long *sums = NULL;
+    unsigned long previousNumOfPixels = 0;
+    double reciprocal = 0.0, rounding = 0.0;
+    unsigned int screenWidth = screen->width;
+    unsigned int screenHeight = screen->height;
+    unsigned int boxWidth, boxFraction, numOfRowPixels;
+    int decodeRows = (unsigned long)screenWidth < 16 * (unsigned long)width; /* Decoding a scanline with the planar kernels is cheaper than gathering the bits of each pixel, unless the samples are far apart */
+    unsigned int i;
+    AMIVIDEO_DECLARE_TIMESTAMP(start)
+
+    if(width == 0 || height == 0 || screenWidth == 0 || screenHeight == 0)
+        return TRUE;
+
+    boxWidth = screenWidth / width;
+    boxFraction = screenWidth % width;
+    numOfRowPixels = filter == AMIVIDEO_THUMBNAIL_BOX ? 3 * screenWidth : screenWidth;
+
+    /* Decode into the compact RGB layout, from which the channels can be averaged. Decoded scanlines are written as a whole, without repeating pixels */
+    initPixelConversionJob(&job, screen, CONVERSION_NONE, TRUE, NULL, 0, AMIVIDEO_PIXEL_FORMAT_RGB24, FALSE);
+    job.settings.pixelFormat = AMIVIDEO_PIXEL_FORMAT_RGB32;
+    amiVideo_compileSwizzleLayout(&layout, AMIVIDEO_COMPACT_RSHIFT, AMIVIDEO_COMPACT_GSHIFT, AMIVIDEO_COMPACT_BSHIFT, AMIVIDEO_COMPACT_ASHIFT, rshift, gshift, bshift, ashift);
+
+    if(filter != AMIVIDEO_THUMBNAIL_BOX)
+        job.lastColumn = (unsigned long)(2 * width - 1) * screenWidth / (2 * width) + 1; /* HAM scanlines are decoded up to the last sampled pixel */
+
+    /* A scanline is decoded as a whole when most of its bytes contribute, or when its HAM pixels depend on the pixels to their left. The box filter also sums the pixels of each column behind the decoded scanline */
+    rowPixels = (amiVideo_ULong*)malloc(numOfRowPixels * sizeof(amiVideo_ULong));
+
+    if(rowPixels == NULL)
+        return FALSE;
+
+    AMIVIDEO_COUNT_ALLOCATION(screen, numOfRowPixels * sizeof(amiVideo_ULong));
+    columnSums = rowPixels + screenWidth;
+
+    if(filter == AMIVIDEO_THUMBNAIL_BOX)
+    {
+        sums = (unsigned long*)malloc(width * 4 * sizeof(unsigned long));
+
+        if(sums == NULL)
+        {
+            free(rowPixels);
+            return FALSE;
+        }
+
+        AMIVIDEO_COUNT_ALLOCATION(screen, width * 4 * sizeof(unsigned long));
+    }
+
+    amiVideo_getPlanarKernels();
+    AMIVIDEO_START_STAGE(start);
+
+    for(i = 0; i < height; i++)
+    {
+        amiVideo_ULong *output = (amiVideo_ULong*)((amiVideo_UByte*)pixels + i * pitch);
+        amiVideo_UByte *bitplaneRows[AMIVIDEO_MAX_NUM_OF_BITPLANES];
+        unsigned int j;
+
+        if(filter == AMIVIDEO_THUMBNAIL_BOX)
+        {
+            /* Average the screen pixels that are covered by each thumbnail pixel. When the thumbnail is larger than the screen, a box covers at least one pixel */
+            unsigned int firstRow = (unsigned long)i * screenHeight / height;
+            unsigned int lastRow = (unsigned long)(i + 1) * screenHeight / height;
+            unsigned int row, boundary, remainder;
+
+            if(lastRow <= firstRow)
+                lastRow = firstRow + 1;
+
+            memset(sums, '\0', width * 4 * sizeof(unsigned long));
+
+            /*
+             * Two channels are summed at once in the 16-bit halves of a 32-bit value, which holds the sum of up to 256 pixels.
+             * The pixels of up to 256 scanlines are first summed per column, which are then summed per box in runs of up to 256 pixels.
+             */
+            for(row = firstRow; row < lastRow; row += 256)
+            {
+                unsigned int lastGroupRow = lastRow - row > 256 ? row + 256 : lastRow;
+                unsigned int columnsPerRun = 256 / (lastGroupRow - row);
+                unsigned int groupRow, k;
+
+                memset(columnSums, '\0', 2 * screenWidth * sizeof(amiVideo_ULong));
+
+                for(groupRow = row; groupRow < lastGroupRow; groupRow++)
+                {
+                    getBitplaneRows(screen, groupRow, bitplaneRows);
+                    convertScanLineToPixels(&job, getRowTables(&job, groupRow), bitplaneRows, NULL, rowPixels, NULL);
+
+                    for(k = 0; k < screenWidth; k++)
+                    {
+                        columnSums[k] += rowPixels[k] & 0x00ff00ff;
+                        columnSums[screenWidth + k] += (rowPixels[k] >> 8) & 0x00ff00ff;
+                    }
+                }
+
+                /* Step through the box boundaries j * screenWidth / width, so that no division is needed for every box */
+                boundary = 0;
+                remainder = 0;
+
+                for(j = 0; j < width; j++)
+                {
+                    unsigned int firstColumn = boundary;
+                    unsigned int lastColumn;
+                    unsigned long *sum = sums + j * 4;
+
+                    boundary += boxWidth;
+                    remainder += boxFraction;
+
+                    if(remainder >= width)
+                    {
+                        remainder -= width;
+                        boundary++;
+                    }
+
+                    lastColumn = boundary > firstColumn ? boundary : firstColumn + 1;
+
+                    for(k = firstColumn; k < lastColumn; k += columnsPerRun)
+                    {
+                        unsigned int end = lastColumn - k > columnsPerRun ? k + columnsPerRun : lastColumn;
+                        amiVideo_ULong blueRed = 0, greenAlpha = 0;
+                        unsigned int l;
+
+                        for(l = k; l < end; l++)
+                        {
+                            blueRed += columnSums[l];
+                            greenAlpha += columnSums[screenWidth + l];
+                        }
+
+                        sum[0] += blueRed >> 16;
+                        sum[1] += greenAlpha & 0xffff;
+                        sum[2] += blueRed & 0xffff;
+                        sum[3] += greenAlpha >> 16;
+                    }
+                }
+            }
+
+            boundary = 0;
+            remainder = 0;
+
+            for(j = 0; j < width; j++)
+            {
+                unsigned int firstColumn = boundary;
+                const unsigned long *sum = sums + j * 4;
+                unsigned long numOfPixels;
+
+                boundary += boxWidth;
+                remainder += boxFraction;
+
+                if(remainder >= width)
+                {
+                    remainder -= width;
+                    boundary++;
+                }
+
+                numOfPixels = (unsigned long)(boundary > firstColumn ? boundary - firstColumn : 1) * (lastRow - firstRow);
+
+                /* The boxes of a row cover at most two amounts of pixels, so the reciprocal rarely changes. Adding a half before truncating rounds to the nearest value, and the extra quarter keeps the quotient away from the integers that a rounded reciprocal could fall short of */
+                if(numOfPixels != previousNumOfPixels)
+                {
+                    reciprocal = 1.0 / numOfPixels;
+                    rounding = numOfPixels / 2 + 0.25;
+                    previousNumOfPixels = numOfPixels;
+                }
+
+                output[j] = ((amiVideo_ULong)((sum[0] + rounding) * reciprocal) << AMIVIDEO_COMPACT_RSHIFT)
+                    | ((amiVideo_ULong)((sum[1] + rounding) * reciprocal) << AMIVIDEO_COMPACT_GSHIFT)
+                    | ((amiVideo_ULong)((sum[2] + rounding) * reciprocal) << AMIVIDEO_COMPACT_BSHIFT)
+                    | ((amiVideo_ULong)((sum[3] + rounding) * reciprocal) << AMIVIDEO_COMPACT_ASHIFT);
+            }
+        }
+        else
+        {
+            /* Sample the screen pixel at the center of each thumbnail pixel */
+            unsigned int row = (unsigned long)(2 * i + 1) * screenHeight / (2 * height);
+            const amiVideo_ColorTables *tables = getRowTables(&job, row);
+            int decodeRow = decodeRows || (job.stage != AMIVIDEO_STAGE_TRUE_COLOR && amiVideo_checkHoldAndModify(tables->viewportMode));
+
+            /* Step through the centers of the thumbnail pixels, so that no division is needed for every pixel */
+            unsigned int column = screenWidth / (2 * width);
+            unsigned int fraction = screenWidth % (2 * width);
+            unsigned int columnStep = screenWidth / width;
+            unsigned int fractionStep = 2 * (screenWidth % width);
+
+            getBitplaneRows(screen, row, bitplaneRows);
+
+            if(decodeRow)
+                convertScanLineToPixels(&job, tables, bitplaneRows, NULL, rowPixels, NULL);
+
+            for(j = 0; j < width; j++)
+            {
+                output[j] = decodeRow ? rowPixels[column] : samplePixel(&job, tables, bitplaneRows, column);
+
+                column += columnStep;
+                fraction += fractionStep;
+
+                if(fraction >= 2 * width)
+                {
+                    fraction -= 2 * width;
+                    column++;
+                }
+            }
+        }
+
+        /* The pixels are composed in the compact layout and reordered into the layout of the thumbnail afterwards */
+        amiVideo_swizzlePixels(&layout, output, width, output);
+    }
+
+    AMIVIDEO_FINISH_STAGE(screen, job.stage, start, (unsigned long)width * height, (unsigned long)width * height * 4);
+
+    free(rowPixels);
+    free(sums);
+
+    return TRUE;
+}
+
+int amiVideo_initScanLineStream(amiVideo_ScanLineStream *stream, amiVideo_Screen *screen, amiVideo_PixelFormat pixelFormat, int corrected, amiVideo_ScanLineCallback callback, void *data)
+{
+    amiVideo_ConversionJob *job;
+    unsigned int rowSize;
+
+    if((screen->bitplaneDepth == 24 || screen->bitplaneDepth == 32) && checkChunkyPixelFormat(pixelFormat))
+        return FALSE; /* A chunky pixel cannot hold the color channels of a true color screen */
+
+    job = (amiVideo_ConversionJob*)malloc(sizeof(amiVideo_ConversionJob));
+
+    if(job == NULL)
+        return FALSE;
+
+    initPixelConversionJob(job, screen, CONVERSION_NONE, TRUE, NULL, 0, pixelFormat, corrected);
+    job->settings.bitOffset = 0; /* The fed scanlines always start at a byte boundary */
+
+    /* A single scanline of the target surface is retained */
+    rowSize = (screen->width * job->settings.repeatHorizontal * getBitsPerPixel(pixelFormat) + 7) / 8;
+    stream->pixels = malloc(rowSize > 0 ? rowSize : 1);
+
+    if(stream->pixels == NULL)
+    {
+        free(job);
+        return FALSE;
+    }
+
+    job->settings.pixels = stream->pixels;
+    job->settings.pitch = rowSize;
+
+    AMIVIDEO_COUNT_ALLOCATION(screen, sizeof(amiVideo_ConversionJob));
+    AMIVIDEO_COUNT_ALLOCATION(screen, rowSize);
+
+    /* Select the kernels up front, as the other conversions do */
+    amiVideo_getPlanarKernels();
+    amiVideo_getCorrectionKernels();
+
+    stream->screen = screen;
+    stream->job = job;
+    stream->row = 0;
+    stream->nextTables = 0;
+    stream->callback = callback;
+    stream->data = data;
+
+    return TRUE;
+}
+
+int amiVideo_feedScanLineStream(amiVideo_ScanLineStream *stream, amiVideo_UByte **bitplaneRows)
+{
+    const amiVideo_ConversionJob *job = stream->job;
+    const amiVideo_ColorTables *tables = &job->tables;
+    unsigned int i;
+    AMIVIDEO_DECLARE_TIMESTAMP(start)
+
+    if(stream->row >= stream->screen->height)
+        return FALSE;
+
+    /* Switch to the lookup tables of the registers that have been changed up to this scanline */
+    while(stream->nextTables < job->numOfLineTables && job->lineTables[stream->nextTables].firstRow <= stream->row)
+        stream->nextTables++;
+
+    if(stream->nextTables > 0)
+        tables = &job->lineTables[stream->nextTables - 1];
+
+    if(job->settings.repeatHorizontal > 0)
+    {
+        amiVideo_ReplicatePixelsKernel replicate = amiVideo_getReplicatePixelsKernel(getBitsPerPixel(job->settings.pixelFormat) / 8, job->settings.repeatHorizontal);
+
+        AMIVIDEO_START_STAGE(start);
+        convertScanLineToPixels(job, tables, bitplaneRows, NULL, stream->pixels, replicate);
+        AMIVIDEO_FINISH_STAGE(stream->screen, job->stage, start, stream->screen->width * job->settings.repeatHorizontal, job->settings.pitch);
+
+        /* The scanline is emitted for each scanline of the target surface that it covers */
+        for(i = 0; i < job->settings.repeatVertical; i++)
+            stream->callback(stream->pixels, stream->row * job->settings.repeatVertical + i, stream->data);
+    }
+
+    stream->row++;
+    return TRUE;
+}
+
+int amiVideo_feedInterleavedScanLineStream(amiVideo_ScanLineStream *stream, amiVideo_UByte *scanLine)
+{
+    amiVideo_UByte *bitplaneRows[AMIVIDEO_MAX_NUM_OF_BITPLANES];
+    unsigned int i;
+
+    for(i = 0; i < stream->screen->bitplaneDepth; i++)
+        bitplaneRows[i] = scanLine + i * stream->screen->bitplaneFormat.pitch;
+
+    return amiVideo_feedScanLineStream(stream, bitplaneRows);
+}
+
+void amiVideo_cleanupScanLineStream(amiVideo_ScanLineStream *stream)
+{
+    free(stream->job);
+    free(stream->pixels);
+}
+
+amiVideo_ColorFormat amiVideo_autoSelectColorFormat(const amiVideo_Screen *screen)
+{
+    if(amiVideo_checkHoldAndModify(screen->viewportMode) || screen->bitplaneDepth == 24 || screen->bitplaneDepth == 32)
+        return AMIVIDEO_RGB_FORMAT;
+    else
+        return AMIVIDEO_CHUNKY_FORMAT;
+}
+
+void amiVideo_reorderRGBPixels(amiVideo_Screen *screen)
+{
+    AMIVIDEO_DECLARE_TIMESTAMP(start)
+
+    AMIVIDEO_START_STAGE(start);
+    reorderRGBPixelRows(screen, 0, screen->height);
+    AMIVIDEO_FINISH_STAGE(screen, AMIVIDEO_STAGE_REORDER, start, (unsigned long)screen->width * screen->height, (unsigned long)screen->width * screen->height * 4);
+}
+
+int amiVideo_checkInstrumentation(void)
+{
+#if defined(AMIVIDEO_INSTRUMENTATION)
+    return TRUE;
+#else
+    return FALSE;
+#endif
+}
+
+void amiVideo_resetScreenStats(amiVideo_Screen *screen)
+{
+    memset(&screen->stats, '\0', sizeof(amiVideo_ScreenStats));
+}
+
+void amiVideo_queryScreenStats(const amiVideo_Screen *screen, amiVideo_ScreenStats *stats)
 {
-    /* Reorder the bytes if the real display uses a different order */
-    if(screen->bitplaneDepth == 24 && (screen->uncorrectedRGBFormat.ashift != 24 || screen->uncorrectedRGBFormat.rshift != 16 || screen->uncorrectedRGBFormat.gshift != 8 || screen->uncorrectedRGBFormat.bshift != 0))
-        reorderPixelBytes(screen, 16, 8, 0, 24);
-    else if(screen->bitplaneDepth == 32 && (screen->uncorrectedRGBFormat.rshift != 24 || screen->uncorrectedRGBFormat.gshift != 16 || screen->uncorrectedRGBFormat.bshift != 8 || screen->uncorrectedRGBFormat.ashift != 0))
-        reorderPixelBytes(screen, 24, 16, 8, 0);
+    *stats = screen->stats;
 }
@@ -8,6 +8,248 @@
 
 typedef struct amiVideo_Screen amiVideo_Screen;
 
+/**
+ * Defines a range of scanlines.
+ */
+typedef struct
+{
+    /** Index of the first scanline of the range */
+    unsigned int firstRow;
+
+    /** Index of the scanline after the last scanline of the range */
+    unsigned int lastRow;
+}
+amiVideo_RowRange;
+
+/**
+ * Defines a rectangular region of a screen, in pixels of the uncorrected screen.
+ */
+typedef struct
+{
+    /** Horizontal position of the leftmost column of the region */
+    unsigned int x;
+
+    /** Vertical position of the topmost scanline of the region */
+    unsigned int y;
+
+    /** Width of the region in pixels */
+    unsigned int width;
+
+    /** Height of the region in scanlines */
+    unsigned int height;
+}
+amiVideo_Region;
+
+/**
+ * Specifies how the pixels of a thumbnail are computed from the pixels of a screen.
+ */
+typedef enum
+{
+    /** Every pixel of the thumbnail is the pixel of the screen at its center */
+    AMIVIDEO_THUMBNAIL_SAMPLE = 0,
+
+    /** Every pixel of the thumbnail is the average of the pixels of the screen that it covers */
+    AMIVIDEO_THUMBNAIL_BOX = 1
+}
+amiVideo_ThumbnailFilter;
+
+/** Identifies the register change that modifies the viewport mode instead of a color register */
+#define AMIVIDEO_REGISTER_VIEWPORT_MODE 0xffff
+
+/**
+ * Describes a change of a register that takes effect from a specific
+ * scanline, such as a change made by a copper list or stored in a PCHG chunk.
+ */
+typedef struct
+{
+    /** Scanline from which the new value applies */
+    unsigned int row;
+
+    /** Index of the color register that is changed or AMIVIDEO_REGISTER_VIEWPORT_MODE */
+    unsigned int reg;
+
+    /** New value of the color register */
+    amiVideo_Color color;
+
+    /** New viewport mode, of which only the HAM and extra halfbrite bits are used */
+    amiVideo_Long viewportMode;
+}
+amiVideo_RegisterChange;
+
+/**
+ * Describes the visible part of a playfield that is larger than the screen,
+ * similar to the bitplane pointers, modulos and scroll delay of the Amiga
+ * display hardware. The screen reads its scanlines straight from the
+ * playfield, so scrolling only requires the position to be changed.
+ */
+typedef struct
+{
+    /** Start of the first row of the first bitplane of the playfield */
+    amiVideo_UByte *bitplanes;
+
+    /** Amount of bytes between the start of two consecutive bitplanes */
+    unsigned int planeOffset;
+
+    /** Amount of bytes between the start of two consecutive rows of a bitplane, i.e. the fetched row size plus the modulo */
+    unsigned int rowStride;
+
+    /** Amount of rows of the playfield after which the rows wrap around to the first row, such as a ring buffer that scrolls vertically, or 0 to disable the wrap around */
+    unsigned int numOfRows;
+
+    /** Horizontal position in pixels of the first visible pixel. It does not need to be a multiple of 8 or 16, which corresponds to the fine scroll delay */
+    unsigned int x;
+
+    /** Vertical position of the first visible row */
+    unsigned int y;
+}
+amiVideo_Playfield;
+
+/**
+ * Defines the layout of the pixels of a target surface.
+ */
+typedef enum
+{
+    /** Every byte contains the palette index of a pixel */
+    AMIVIDEO_PIXEL_FORMAT_CHUNKY8 = 0,
+
+    /** Every byte contains the palette indexes of two pixels. The leftmost pixel is stored in the most significant nibble */
+    AMIVIDEO_PIXEL_FORMAT_CHUNKY4 = 1,
+
+    /** Every four bytes contain a pixel of which the color components are shifted by configurable amounts */
+    AMIVIDEO_PIXEL_FORMAT_RGB32 = 2,
+
+    /** Every 16-bit word contains a pixel with a 5-bit red, 6-bit green and 5-bit blue component, from the most significant bit */
+    AMIVIDEO_PIXEL_FORMAT_RGB565 = 3,
+
+    /** Every 16-bit word contains a pixel with an unused bit and 5-bit red, green and blue components, from the most significant bit */
+    AMIVIDEO_PIXEL_FORMAT_XRGB1555 = 4,
+
+    /** Every three bytes contain a pixel of which the bytes are the red, green and blue components in memory order */
+    AMIVIDEO_PIXEL_FORMAT_RGB24 = 5
+}
+amiVideo_PixelFormat;
+
+/**
+ * Captures the settings of a conversion that determine its output. An
+ * incremental conversion can only reuse the output of the previous conversion
+ * if all of these settings are identical.
+ */
+typedef struct
+{
+    /** Identifies the kind of conversion */
+    int conversion;
+
+    /** Contains the viewport mode settings */
+    amiVideo_Long viewportMode;
+
+    /** Surface that the conversion writes to */
+    void *pixels;
+
+    /** Padded width of the target surface in bytes */
+    unsigned int pitch;
+
+    /** Layout of the pixels of the target surface */
+    amiVideo_PixelFormat pixelFormat;
+
+    /** Amount of times each pixel is repeated horizontally */
+    unsigned int repeatHorizontal;
+
+    /** Amount of times each scanline is repeated vertically */
+    unsigned int repeatVertical;
+
+    /** Amount of bits that the red color component is left shifted */
+    amiVideo_UByte rshift;
+
+    /** Amount of bits that the green color component is left shifted */
+    amiVideo_UByte gshift;
+
+    /** Amount of bits that the blue color component is left shifted */
+    amiVideo_UByte bshift;
+
+    /** Amount of bits that the alpha color component is left shifted */
+    amiVideo_UByte ashift;
+
+    /** RGB pixel values of each possible index value */
+    amiVideo_ULong colors[256];
+
+    /** Version of the register changes that apply to the scanlines */
+    unsigned int registerVersion;
+
+    /** Amount of pixels that the scanlines start into the first byte of a bitplane row */
+    unsigned int bitOffset;
+}
+amiVideo_ConversionSettings;
+
+/** Amount of kinds of conversions from bitplanes, of which the delta conversion mode tracks the target surfaces */
+#define AMIVIDEO_NUM_OF_BITPLANE_CONVERSIONS 4
+
+/** Identifies the stage that computes the lookup tables of the palette */
+#define AMIVIDEO_STAGE_PALETTE 0
+
+/** Identifies the stage that converts bitplanes to chunky pixels */
+#define AMIVIDEO_STAGE_PLANAR_DECODE 1
+
+/** Identifies the stage that converts index values to RGB pixels, including the decoding of bitplanes */
+#define AMIVIDEO_STAGE_COLOR_LOOKUP 2
+
+/** Identifies the stage that converts HAM index values to RGB pixels, including the decoding of bitplanes */
+#define AMIVIDEO_STAGE_HAM_DECODE 3
+
+/** Identifies the stage that composes RGB pixels from 24 or 32 bitplanes */
+#define AMIVIDEO_STAGE_TRUE_COLOR 4
+
+/** Identifies the stage that converts chunky pixels to bitplanes or ILBM bodies */
+#define AMIVIDEO_STAGE_PLANAR_ENCODE 5
+
+/** Identifies the stage that corrects the aspect ratio of pixels */
+#define AMIVIDEO_STAGE_CORRECTION 6
+
+/** Identifies the stage that reorders the bytes of RGB pixels */
+#define AMIVIDEO_STAGE_REORDER 7
+
+/** Identifies the stage that applies ANIM deltas to the bitplanes */
+#define AMIVIDEO_STAGE_DELTA 8
+
+/** Amount of stages for which statistics are recorded */
+#define AMIVIDEO_NUM_OF_STAGES 9
+
+/**
+ * Contains the statistics of a conversion stage. The counters wrap around if
+ * they exceed the range of an unsigned long.
+ */
+typedef struct
+{
+    /** Amount of times the stage has been performed */
+    unsigned long numOfRuns;
+
+    /** Total time spent in the stage in nanoseconds */
+    double time;
+
+    /** Amount of pixels that the stage has produced */
+    unsigned long numOfPixels;
+
+    /** Amount of bytes that the stage has written, or read in case of AMIVIDEO_STAGE_DELTA */
+    unsigned long numOfBytes;
+}
+amiVideo_StageStats;
+
+/**
+ * Contains the statistics of the conversions of a screen. They are only
+ * recorded if the library has been built with instrumentation enabled.
+ */
+typedef struct
+{
+    /** Statistics of each AMIVIDEO_STAGE_* stage */
+    amiVideo_StageStats stage[AMIVIDEO_NUM_OF_STAGES];
+
+    /** Amount of memory blocks that the screen has allocated for its buffers and workspaces */
+    unsigned long numOfAllocations;
+
+    /** Total size of the memory blocks that the screen has allocated */
+    unsigned long allocatedBytes;
+}
+amiVideo_ScreenStats;
+
 /**
  * A data structure representing an Amiga screen (or viewport) containing
  * conversion sub structures that store the screen in a different displaying
@@ -55,6 +297,21 @@ struct amiVideo_Screen
         /** Contains the padded width in pixels that is rounded up to the nearest word boundary */
         unsigned int pitch;
 
+        /** Contains the amount of bytes between the start of two consecutive scanlines of a bitplane. It equals the pitch for separately stored bitplanes and pitch * bitplane depth for interleaved bitplanes */
+        unsigned int rowStride;
+
+        /** Contains the amount of pixels that each scanline starts into the first byte of a bitplane row, a value between 0-7. It is only non-zero for playfields that are scrolled horizontally */
+        unsigned int bitOffset;
+
+        /** Contains the amount of rows after which the scanlines wrap around to the first row of the bitplanes, or 0 if they never wrap around */
+        unsigned int numOfWrapRows;
+
+        /** Contains the row of the bitplanes that the first scanline is read from when the scanlines wrap around */
+        unsigned int firstRow;
+
+        /** Indicates whether the bitplanes are the visible part of a larger playfield, of which the pixels beyond the width of the screen must be preserved */
+        int playfield;
+
         /** Indicates whether the pixel memory is allocated and needs to be freed */
         int memoryAllocated;
     }
@@ -76,7 +333,10 @@ struct amiVideo_Screen
         /** Contains the pixel data in which each byte represents an index in the palette */
         amiVideo_UByte *pixels;
 
-        /** Indicates whether the pixel memory is allocated and needs to be freed */
+        /** Layout of the pixels (8-bit or 4-bit chunky). Only conversions from bitplanes can write 4-bit pixels, all other conversions require 8-bit pixels */
+        amiVideo_PixelFormat pixelFormat;
+
+        /** Obsolete and always FALSE, as the library no longer allocates the pixel memory. It is only kept to preserve the layout of the structure */
         int memoryAllocated;
     }
     uncorrectedChunkyFormat;
@@ -108,7 +368,10 @@ struct amiVideo_Screen
         /** Contains the pixel data in which each four bytes represent red, glue, blue values and a padding byte */
         amiVideo_ULong *pixels;
 
-        /** Indicates whether the pixel memory is allocated and needs to be freed */
+        /** Layout of the pixels. For the compact formats, the pixels member points to pixels of that format */
+        amiVideo_PixelFormat pixelFormat;
+
+        /** Obsolete and always FALSE, as the library no longer allocates the pixel memory. It is only kept to preserve the layout of the structure */
         int memoryAllocated;
     }
     uncorrectedRGBFormat;
@@ -132,9 +395,12 @@ struct amiVideo_Screen
         /** Contains the padded width of the corrected screen (usually rounded up to the nearest 4-byte boundary) */
         unsigned int pitch;
 
-        /** Contains the amount of bytes per pixel (1 = chunky, 4 = RGB) */
+        /** Contains the amount of bytes per pixel (1 = chunky, 2 = 16-bit RGB, 3 = packed 24-bit RGB, 4 = RGB, 0 = 4-bit chunky) */
         unsigned int bytesPerPixel;
 
+        /** Layout of the pixels */
+        amiVideo_PixelFormat pixelFormat;
+
         /* Specifies the width of a lowres pixel in real pixels. Usually 2 is sufficient. To support super hires displays, 4 is required. */
         unsigned int lowresPixelScaleFactor;
 
@@ -142,6 +408,120 @@ struct amiVideo_Screen
         void *pixels;
     }
     correctedFormat;
+
+    /**
+     * Contains the state of the incremental conversion mode. In this mode, the
+     * conversions from bitplanes only convert the scanlines that have changed
+     * since the previous conversion. To detect changes, a copy of the
+     * bitplanes of the previous conversion is retained.
+     *
+     * All scanlines are converted again if any other setting that determines
+     * the output has changed, such as the palette or the target surface. The
+     * target surface must not be modified by anything else between incremental
+     * conversions.
+     */
+    struct
+    {
+        /** Indicates whether incremental conversion is enabled */
+        int enabled;
+
+        /** Contains a copy of the bitplanes of the previous conversion */
+        amiVideo_UByte *previousBitplanes;
+
+        /** Contains the amount of bytes that previousBitplanes can hold */
+        amiVideo_ULong previousBitplanesSize;
+
+        /** Indicates whether the target surface contains the result of the previous conversion */
+        int previousValid;
+
+        /** Contains the settings of the previous conversion */
+        amiVideo_ConversionSettings previousSettings;
+
+        /** Contains the ranges of scanlines of the target surface that were written by the last conversion */
+        amiVideo_RowRange *dirtyRows;
+
+        /** Contains the amount of ranges in dirtyRows */
+        unsigned int numOfDirtyRows;
+
+        /** Contains the amount of ranges that dirtyRows can hold */
+        unsigned int maxNumOfDirtyRows;
+    }
+    incrementalFormat;
+
+    /**
+     * Contains the scanlines that the last applied ANIM delta has modified. In
+     * the delta conversion mode, the conversions from bitplanes only convert
+     * these scanlines into a target surface that contains the conversion of
+     * the frame to which the delta has been applied. For each kind of
+     * conversion, the settings of the previous conversion are retained, so
+     * that all scanlines are converted again if any other setting that
+     * determines the output has changed, such as the palette or the target
+     * surface, or if a delta has been applied without converting it.
+     */
+    struct
+    {
+        /** Indicates whether delta conversion is enabled */
+        int enabled;
+
+        /** Indicates whether a delta has been applied since delta conversion was enabled */
+        int valid;
+
+        /** Contains the amount of deltas that have been applied */
+        amiVideo_ULong numOfDeltas;
+
+        /** Indicates for each kind of conversion whether its target surface still contains the result of its previous conversion */
+        int previousValid[AMIVIDEO_NUM_OF_BITPLANE_CONVERSIONS];
+
+        /** Contains for each kind of conversion the amount of deltas that had been applied at its previous conversion */
+        amiVideo_ULong previousNumOfDeltas[AMIVIDEO_NUM_OF_BITPLANE_CONVERSIONS];
+
+        /** Contains the settings of the previous conversion of each kind */
+        amiVideo_ConversionSettings previousSettings[AMIVIDEO_NUM_OF_BITPLANE_CONVERSIONS];
+
+        /** Marks the scanlines that are modified while a delta is applied */
+        amiVideo_UByte *touchedRows;
+
+        /** Contains the ranges of scanlines of the bitplanes that were modified by the last delta */
+        amiVideo_RowRange *dirtyRows;
+
+        /** Contains the amount of scanlines that touchedRows and dirtyRows can cover */
+        unsigned int maxHeight;
+
+        /** Contains the amount of ranges in dirtyRows */
+        unsigned int numOfDirtyRows;
+
+        /** Contains the first byte column of the bitplanes that was modified by the last delta */
+        unsigned int firstColumn;
+
+        /** Contains the byte column after the last one that was modified by the last delta */
+        unsigned int lastColumn;
+    }
+    deltaFormat;
+
+    /**
+     * Contains the changes of the color registers and the viewport mode that
+     * take effect at specific scanlines. The conversions to RGB pixels switch
+     * between lookup tables that are precomputed for each range of scanlines
+     * with the same register values.
+     */
+    struct
+    {
+        /** Contains the changes sorted by scanline or NULL if the registers do not change */
+        const amiVideo_RegisterChange *changes;
+
+        /** Contains the amount of changes */
+        unsigned int numOfChanges;
+
+        /** Is incremented every time the changes are set, so that the lookup tables are computed again */
+        unsigned int version;
+
+        /** Contains the lookup tables derived from the changes */
+        struct amiVideo_RegisterState *state;
+    }
+    registerFormat;
+
+    /** Contains the statistics of the conversions, if instrumentation is enabled */
+    amiVideo_ScreenStats stats;
 };
 
 typedef enum
@@ -151,6 +531,67 @@ typedef enum
 }
 amiVideo_ColorFormat;
 
+/**
+ * Converts a band of scanlines of a parallel conversion.
+ *
+ * @param data Conversion state that must be passed to the function
+ * @param band Index of the band that must be converted, a value between 0 and the amount of bands - 1
+ */
+typedef void (*amiVideo_BandFunction)(void *data, unsigned int band);
+
+/**
+ * Executes a band function for every band of a parallel conversion, e.g. by
+ * submitting them to an existing thread pool. The bands may be converted in
+ * any order and at the same time, but the executor must not return before all
+ * of them have been converted.
+ *
+ * @param function Function that must be invoked for each band
+ * @param data Conversion state that must be passed to the function
+ * @param numOfBands Amount of bands the frame is split into
+ * @param executorData Arbitrary data that was passed to the parallel conversion function
+ */
+typedef void (*amiVideo_Executor)(amiVideo_BandFunction function, void *data, unsigned int numOfBands, void *executorData);
+
+/**
+ * Receives a converted scanline of a scanline stream.
+ *
+ * @param pixels Pixels of the scanline. The buffer is reused for the next scanline, so the pixels must be copied if they are needed afterwards.
+ * @param row Index of the scanline in the target surface
+ * @param data Arbitrary data that was passed to amiVideo_initScanLineStream()
+ */
+typedef void (*amiVideo_ScanLineCallback)(const void *pixels, unsigned int row, void *data);
+
+/**
+ * Converts bitplanes that are fed one scanline at a time, e.g. while they are
+ * decompressed, and emits every converted scanline through a callback. Only
+ * a single scanline of the target surface is kept in memory, so neither the
+ * planar frame nor the converted frame have to be resident.
+ */
+typedef struct
+{
+    /** Screen of which the scanlines are converted */
+    amiVideo_Screen *screen;
+
+    /** Conversion state of the stream */
+    struct amiVideo_ConversionJob *job;
+
+    /** Buffer that receives a converted scanline */
+    void *pixels;
+
+    /** Index of the next scanline that must be fed */
+    unsigned int row;
+
+    /** Index of the lookup tables of register changes that are checked for the next scanline */
+    unsigned int nextTables;
+
+    /** Function that receives the converted scanlines */
+    amiVideo_ScanLineCallback callback;
+
+    /** Arbitrary data that is passed to the callback */
+    void *data;
+}
+amiVideo_ScanLineStream;
+
 /**
  * Initializes a screen instance with the given dimensions, bitplane depth,
  * specific size of color components and viewport mode.
@@ -164,6 +605,27 @@ amiVideo_ColorFormat;
  */
 void amiVideo_initScreen(amiVideo_Screen *screen, amiVideo_Word width, amiVideo_Word height, unsigned int bitplaneDepth, unsigned int bitsPerColorChannel, amiVideo_Long viewportMode);
 
+/**
+ * Reconfigures an initialised screen for the next frame of a sequence, e.g.
+ * the next frame of an animation or the next image of a directory. Only the
+ * properties that differ are initialised again: the palette storage and the
+ * buffers of the incremental and delta conversions are reused and reallocated
+ * only when they no longer fit. The colors, the pixel formats and the scale
+ * factor are retained. The bitplane pointers must be set again and the pixel
+ * surfaces must be set again when the dimensions change. The next conversion
+ * converts all scanlines, because the target surfaces do not contain the new
+ * frame yet.
+ *
+ * @param screen Screen conversion structure
+ * @param width Width of the screen in pixels
+ * @param height Height of the screen in scanlines
+ * @param bitplaneDepth Bitplane depth, a value between 1-6 (OCS/ECS) and 1-8 (AGA)
+ * @param bitsPerColorChannel The amount of bits for used for a color component (4 = ECS/OCS, 8 = AGA)
+ * @param viewportMode The viewport mode value
+ * @return TRUE if the screen has been reconfigured, FALSE if the buffers of the incremental or delta conversion could not be allocated, which disables that mode
+ */
+int amiVideo_reinitScreen(amiVideo_Screen *screen, amiVideo_Word width, amiVideo_Word height, unsigned int bitplaneDepth, unsigned int bitsPerColorChannel, amiVideo_Long viewportMode);
+
 /**
  * Creates a screen conversion structure on the heap with the given dimensions,
  * bitplane depth, specific size of color components and viewport mode. The
@@ -222,7 +684,9 @@ void amiVideo_setLowresPixelScaleFactor(amiVideo_Screen *screen, unsigned int lo
  * Sets the bitplane pointers of the conversion structure to the appropriate
  * memory positions. On AmigaOS these may point to a real viewport's bitplane
  * pointers. On different platforms these may point to subsets of a
- * pre-allocated memory area containing planar graphics data.
+ * pre-allocated memory area containing planar graphics data. The scanlines of
+ * each bitplane are assumed to be the current row stride apart, which is the
+ * pitch unless a different layout has been set.
  *
  * @param screen Screen conversion structure
  * @param bitplanes Pointers to bitplane areas in memory
@@ -240,6 +704,48 @@ void amiVideo_setScreenBitplanePointers(amiVideo_Screen *screen, amiVideo_UByte
  */
 void amiVideo_setScreenBitplanes(amiVideo_Screen *screen, amiVideo_UByte *bitplanes);
 
+/**
+ * Sets the bitplane pointers of the conversion structure to the right subsets
+ * in a given memory area containing interleaved planar graphics data, such as
+ * the body of an ILBM file or an interleaved AmigaOS bitmap. In this layout,
+ * each scanline of the first bitplane is immediately followed by the same
+ * scanline of the other bitplanes. The conversions read the interleaved
+ * bitplanes directly.
+ *
+ * @param screen Screen conversion structure
+ * @param bitplanes A memory area containing interleaved planar graphics data
+ */
+void amiVideo_setScreenInterleavedBitplanes(amiVideo_Screen *screen, amiVideo_UByte *bitplanes);
+
+/**
+ * Sets the bitplane pointers of the conversion structure to subsets of a
+ * given memory area with an arbitrary layout. Bitplane i starts at
+ * bitplanes + i * planeOffset and the scanlines of a bitplane are rowStride
+ * bytes apart.
+ *
+ * @param screen Screen conversion structure
+ * @param bitplanes A memory area containing planar graphics data
+ * @param planeOffset Amount of bytes between the start of two consecutive bitplanes
+ * @param rowStride Amount of bytes between the start of two consecutive scanlines of a bitplane
+ */
+void amiVideo_setScreenBitplaneLayout(amiVideo_Screen *screen, amiVideo_UByte *bitplanes, unsigned int planeOffset, unsigned int rowStride);
+
+/**
+ * Sets the bitplane pointers of the conversion structure to the visible part
+ * of a playfield that may be larger than the screen. The first visible pixel
+ * does not need to be at a byte boundary and the rows of the playfield may wrap
+ * around, so a frame can be scrolled without copying the playfield. When the
+ * rows wrap around, the playfield must have at least as many rows as the
+ * screen. Converting chunky pixels to bitplanes only modifies the visible bits
+ * of the playfield. The ILBM body and ANIM delta functions are not aware of the
+ * view and must be used with a byte aligned playfield that does not wrap
+ * around.
+ *
+ * @param screen Screen conversion structure
+ * @param playfield Description of the playfield and its visible part
+ */
+void amiVideo_setScreenPlayfield(amiVideo_Screen *screen, const amiVideo_Playfield *playfield);
+
 /**
  * Sets the uncorrected chunky sub struct pointer to a memory area capable of
  * storing it.
@@ -257,7 +763,7 @@ void amiVideo_setScreenUncorrectedChunkyPixelsPointer(amiVideo_Screen *screen, a
  * @param screen Screen conversion structure
  * @param pixels Pointer to a memory area storing RGB pixels
  * @param pitch Padded width of the memory surface in bytes (usually 4 * width, but it may be padded)
- * @param allocateUncorrectedMemory Indicates whether we should allocate memory for a chunky pixels buffer that should be freed
+ * @param allocateUncorrectedMemory Obsolete. No memory is allocated anymore, as all screens (including HAM screens) are converted without intermediate chunky pixels.
  * @param rshift The amount of bits that we have to left shift the red color component
  * @param gshift The amount of bits that we have to left shift the green color component
  * @param bshift The amount of bits that we have to left shift the blue color component
@@ -272,8 +778,8 @@ void amiVideo_setScreenUncorrectedRGBPixelsPointer(amiVideo_Screen *screen, amiV
  * @param screen Screen conversion structure
  * @param pixels Pointer to a memory area storing the corrected pixels
  * @param pitch Padded width of the memory surface in bytes (equals witdth for chunky, 4 * width for RGB, but it may be padded)
- * @param bytesPerPixel Specifies of how many bytes a pixel consists (1 = chunky, 4 = RGB)
- * @param allocateUncorrectedMemory Indicates whether we should allocate memory for a chunky or RGB pixel buffer that should be freed
+ * @param bytesPerPixel Specifies of how many bytes a pixel consists (1 = chunky, 2 = RGB565, 3 = packed 24-bit RGB, 4 = RGB). Other compact formats can be selected with amiVideo_setScreenCorrectedPixelFormat().
+ * @param allocateUncorrectedMemory Obsolete. No memory is allocated anymore, as all screens (including 24 and 32 bitplane screens) are converted straight into the corrected surface.
  * @param rshift The amount of bits that we have to left shift the red color component
  * @param gshift The amount of bits that we have to left shift the green color component
  * @param bshift The amount of bits that we have to left shift the blue color component
@@ -281,6 +787,89 @@ void amiVideo_setScreenUncorrectedRGBPixelsPointer(amiVideo_Screen *screen, amiV
  */
 void amiVideo_setScreenCorrectedPixelsPointer(amiVideo_Screen *screen, void *pixels, unsigned int pitch, unsigned int bytesPerPixel, int allocateUncorrectedMemory, amiVideo_UByte rshift, amiVideo_UByte gshift, amiVideo_UByte bshift, amiVideo_UByte ashift);
 
+/**
+ * Changes the pixel layout of the uncorrected chunky surface, e.g. to 4-bit
+ * chunky pixels for screens with at most 16 colors. It must be invoked after
+ * amiVideo_setScreenUncorrectedChunkyPixelsPointer(), which selects 8-bit
+ * chunky pixels.
+ *
+ * @param screen Screen conversion structure
+ * @param pixelFormat AMIVIDEO_PIXEL_FORMAT_CHUNKY8 or AMIVIDEO_PIXEL_FORMAT_CHUNKY4
+ */
+void amiVideo_setScreenUncorrectedChunkyPixelFormat(amiVideo_Screen *screen, amiVideo_PixelFormat pixelFormat);
+
+/**
+ * Changes the pixel layout of the uncorrected RGB surface to one of the RGB
+ * formats, e.g. a compact 16-bit format that halves the required memory
+ * bandwidth. It must be invoked after amiVideo_setScreenUncorrectedRGBPixelsPointer(),
+ * which selects 32-bit pixels. The compact formats are only supported by
+ * screens with at most 8 bitplanes.
+ *
+ * @param screen Screen conversion structure
+ * @param pixelFormat AMIVIDEO_PIXEL_FORMAT_RGB32, AMIVIDEO_PIXEL_FORMAT_RGB565, AMIVIDEO_PIXEL_FORMAT_XRGB1555 or AMIVIDEO_PIXEL_FORMAT_RGB24
+ */
+void amiVideo_setScreenUncorrectedRGBPixelFormat(amiVideo_Screen *screen, amiVideo_PixelFormat pixelFormat);
+
+/**
+ * Changes the pixel layout of the corrected surface. It must be invoked after
+ * amiVideo_setScreenCorrectedPixelsPointer(), which derives the layout from
+ * the amount of bytes per pixel. The chunky conversions write the chunky
+ * formats and the RGB conversions the RGB formats. The compact formats are
+ * only supported by screens with at most 8 bitplanes.
+ *
+ * @param screen Screen conversion structure
+ * @param pixelFormat Layout of the pixels of the corrected surface
+ */
+void amiVideo_setScreenCorrectedPixelFormat(amiVideo_Screen *screen, amiVideo_PixelFormat pixelFormat);
+
+/**
+ * Enables or disables the incremental conversion mode. When enabled, the
+ * conversions from bitplanes only convert the scanlines of which the bitplanes
+ * differ from the previous conversion. After every conversion, the
+ * incrementalFormat sub struct reports the ranges of scanlines of the target
+ * surface that have been written, so that only those have to be displayed
+ * again. The first conversion after enabling converts all scanlines.
+ *
+ * @param screen Screen conversion structure
+ * @param enabled TRUE to enable incremental conversion, FALSE to disable it
+ * @return TRUE if the mode has been changed, FALSE if the memory for the bitplane copy could not be allocated
+ */
+int amiVideo_setScreenIncrementalConversion(amiVideo_Screen *screen, int enabled);
+
+/**
+ * Enables or disables the delta conversion mode. When enabled, the
+ * conversions from bitplanes only convert the scanlines that have been
+ * modified by the last ANIM delta that was applied to the screen, which are
+ * reported by the deltaFormat sub struct. Unlike the incremental mode, no
+ * copy of the bitplanes is compared and a target surface of each kind of
+ * conversion can be kept up to date, provided that it is converted after every
+ * delta. All scanlines are converted before the first delta, after a delta
+ * that was not converted and when a setting that determines the output, such
+ * as the palette or the target surface, has changed.
+ *
+ * @param screen Screen conversion structure
+ * @param enabled TRUE to enable delta conversion, FALSE to disable it
+ * @return TRUE if the mode has been changed, FALSE if the memory could not be allocated
+ */
+int amiVideo_setScreenDeltaConversion(amiVideo_Screen *screen, int enabled);
+
+/**
+ * Sets the changes of the color registers and the viewport mode that take
+ * effect at specific scanlines, e.g. to emulate a copper list or a PCHG
+ * chunk. The values of the registers at a scanline are the colors of the
+ * palette and the viewport mode of the screen, modified by all changes up to
+ * and including that scanline. Only the HAM and extra halfbrite bits of the
+ * viewport mode can be changed, because the resolution determines the layout
+ * of the bitplanes. The changes only affect conversions to RGB pixels. The
+ * array is not copied and must be set again when its contents are modified.
+ *
+ * @param screen Screen conversion structure
+ * @param changes Changes sorted by scanline or NULL to remove the changes
+ * @param numOfChanges Amount of changes
+ * @return TRUE if the changes have been set, FALSE if the memory could not be allocated
+ */
+int amiVideo_setScreenRegisterChanges(amiVideo_Screen *screen, const amiVideo_RegisterChange *changes, unsigned int numOfChanges);
+
 /**
  * Converts the bitplanes to chunky pixels in which every byte represents a
  * pixel and an index value from the palette.
@@ -289,6 +878,29 @@ void amiVideo_setScreenCorrectedPixelsPointer(amiVideo_Screen *screen, void *pix
  */
 void amiVideo_convertScreenBitplanesToChunkyPixels(amiVideo_Screen *screen);
 
+/**
+ * Performs the same conversion as amiVideo_convertScreenBitplanesToChunkyPixels(), but splits
+ * the frame into horizontal bands that are converted in parallel. The result is
+ * identical to the sequential conversion.
+ *
+ * @param screen Screen conversion structure
+ * @param numOfThreads Amount of bands the frame is split into. Without an executor, each band is converted by its own thread.
+ * @param executor Function that executes the bands, or NULL to use threads of the library itself
+ * @param executorData Arbitrary data that is passed to the executor
+ */
+void amiVideo_convertScreenBitplanesToChunkyPixelsParallel(amiVideo_Screen *screen, unsigned int numOfThreads, amiVideo_Executor executor, void *executorData);
+
+/**
+ * Performs the same conversion as amiVideo_convertScreenBitplanesToChunkyPixels(), but
+ * only converts the given region. Only the bytes of the bitplanes that overlap
+ * with the region are decoded, and only the same region of the chunky pixels
+ * is written. A region of 4-bit chunky pixels is widened to whole bytes.
+ *
+ * @param screen Screen conversion structure
+ * @param region Region of the screen that must be converted. It is clipped to the boundaries of the screen.
+ */
+void amiVideo_convertScreenBitplanesToChunkyPixelsRegion(amiVideo_Screen *screen, const amiVideo_Region *region);
+
 /**
  * Converts the chunky pixels to RGB pixels in which every four bytes represent
  * the color value of a pixel.
@@ -297,14 +909,58 @@ void amiVideo_convertScreenBitplanesToChunkyPixels(amiVideo_Screen *screen);
  */
 void amiVideo_convertScreenChunkyPixelsToRGBPixels(amiVideo_Screen *screen);
 
+/**
+ * Performs the same conversion as amiVideo_convertScreenChunkyPixelsToRGBPixels(), but splits
+ * the frame into horizontal bands that are converted in parallel. The result is
+ * identical to the sequential conversion.
+ *
+ * @param screen Screen conversion structure
+ * @param numOfThreads Amount of bands the frame is split into. Without an executor, each band is converted by its own thread.
+ * @param executor Function that executes the bands, or NULL to use threads of the library itself
+ * @param executorData Arbitrary data that is passed to the executor
+ */
+void amiVideo_convertScreenChunkyPixelsToRGBPixelsParallel(amiVideo_Screen *screen, unsigned int numOfThreads, amiVideo_Executor executor, void *executorData);
+
+/**
+ * Performs the same conversion as amiVideo_convertScreenChunkyPixelsToRGBPixels(), but
+ * only converts the given region into the same region of the RGB pixels.
+ *
+ * @param screen Screen conversion structure
+ * @param region Region of the screen that must be converted. It is clipped to the boundaries of the screen.
+ */
+void amiVideo_convertScreenChunkyPixelsToRGBPixelsRegion(amiVideo_Screen *screen, const amiVideo_Region *region);
+
 /**
  * Converts chunky pixels to bitplane format in which every bit represents a
- * part of an index value of the palette of a pixel.
+ * part of an index value of the palette of a pixel. Each scanline of the
+ * bitplanes is padded to the nearest word boundary with bits that are 0.
  *
  * @param screen Screen conversion structure
  */
 void amiVideo_convertScreenChunkyPixelsToBitplanes(amiVideo_Screen *screen);
 
+/**
+ * Performs the same conversion as amiVideo_convertScreenChunkyPixelsToBitplanes(), but splits
+ * the frame into horizontal bands that are converted in parallel. The result is
+ * identical to the sequential conversion.
+ *
+ * @param screen Screen conversion structure
+ * @param numOfThreads Amount of bands the frame is split into. Without an executor, each band is converted by its own thread.
+ * @param executor Function that executes the bands, or NULL to use threads of the library itself
+ * @param executorData Arbitrary data that is passed to the executor
+ */
+void amiVideo_convertScreenChunkyPixelsToBitplanesParallel(amiVideo_Screen *screen, unsigned int numOfThreads, amiVideo_Executor executor, void *executorData);
+
+/**
+ * Performs the same conversion as amiVideo_convertScreenChunkyPixelsToBitplanes(), but
+ * only converts the given region. The bits of the bitplanes outside the region,
+ * including the padding, are left untouched.
+ *
+ * @param screen Screen conversion structure
+ * @param region Region of the screen that must be converted. It is clipped to the boundaries of the screen.
+ */
+void amiVideo_convertScreenChunkyPixelsToBitplanesRegion(amiVideo_Screen *screen, const amiVideo_Region *region);
+
 /**
  * Corrects the chunky or RGB pixel surface into a surface having the correct
  * aspect ratio taking the resolution settings into account.
@@ -313,38 +969,240 @@ void amiVideo_convertScreenChunkyPixelsToBitplanes(amiVideo_Screen *screen);
  */
 void amiVideo_correctScreenPixels(amiVideo_Screen *screen);
 
+/**
+ * Performs the same conversion as amiVideo_correctScreenPixels(), but splits
+ * the frame into horizontal bands that are converted in parallel. The result is
+ * identical to the sequential conversion.
+ *
+ * @param screen Screen conversion structure
+ * @param numOfThreads Amount of bands the frame is split into. Without an executor, each band is converted by its own thread.
+ * @param executor Function that executes the bands, or NULL to use threads of the library itself
+ * @param executorData Arbitrary data that is passed to the executor
+ */
+void amiVideo_correctScreenPixelsParallel(amiVideo_Screen *screen, unsigned int numOfThreads, amiVideo_Executor executor, void *executorData);
+
+/**
+ * Performs the same conversion as amiVideo_correctScreenPixels(), but only
+ * corrects the given region of the uncorrected surface. It is written into the
+ * corresponding region of the corrected surface, which is scaled by the same
+ * factors as the screen.
+ *
+ * @param screen Screen conversion structure
+ * @param region Region of the uncorrected screen that must be corrected. It is clipped to the boundaries of the screen.
+ */
+void amiVideo_correctScreenPixelsRegion(amiVideo_Screen *screen, const amiVideo_Region *region);
+
 /**
  * Converts the screen bitplane surface to RGB pixel surface and performs all
- * the immediate steps.
+ * the immediate steps. The bitplanes are decoded straight into RGB pixels
+ * without using the uncorrected chunky pixels. The bitplanes of 24 and 32
+ * bitplane screens are transposed in cache sized chunks into pixels that have
+ * the byte order of the display, so no separate reordering step is needed.
  *
  * @param screen Screen conversion structure
  */
 void amiVideo_convertScreenBitplanesToRGBPixels(amiVideo_Screen *screen);
 
+/**
+ * Performs the same conversion as amiVideo_convertScreenBitplanesToRGBPixels(), but splits
+ * the frame into horizontal bands that are converted in parallel. The result is
+ * identical to the sequential conversion.
+ *
+ * @param screen Screen conversion structure
+ * @param numOfThreads Amount of bands the frame is split into. Without an executor, each band is converted by its own thread.
+ * @param executor Function that executes the bands, or NULL to use threads of the library itself
+ * @param executorData Arbitrary data that is passed to the executor
+ */
+void amiVideo_convertScreenBitplanesToRGBPixelsParallel(amiVideo_Screen *screen, unsigned int numOfThreads, amiVideo_Executor executor, void *executorData);
+
+/**
+ * Performs the same conversion as amiVideo_convertScreenBitplanesToRGBPixels(), but
+ * only converts the given region. Only the bytes of the bitplanes that overlap
+ * with the region are decoded, except for HAM screens, of which the scanlines
+ * are decoded from the left border of the screen up to the end of the region.
+ *
+ * @param screen Screen conversion structure
+ * @param region Region of the screen that must be converted. It is clipped to the boundaries of the screen.
+ */
+void amiVideo_convertScreenBitplanesToRGBPixelsRegion(amiVideo_Screen *screen, const amiVideo_Region *region);
+
 /**
  * Converts the screen bitplanes surface to a corrected chunky pixel surface and
- * performs all the immediate steps.
+ * performs all the immediate steps. Every scanline is decoded once and written
+ * straight into the corrected surface without using the uncorrected chunky
+ * pixels.
  *
  * @param screen Screen conversion structure
  */
 void amiVideo_convertScreenBitplanesToCorrectedChunkyPixels(amiVideo_Screen *screen);
 
+/**
+ * Performs the same conversion as amiVideo_convertScreenBitplanesToCorrectedChunkyPixels(), but splits
+ * the frame into horizontal bands that are converted in parallel. The result is
+ * identical to the sequential conversion.
+ *
+ * @param screen Screen conversion structure
+ * @param numOfThreads Amount of bands the frame is split into. Without an executor, each band is converted by its own thread.
+ * @param executor Function that executes the bands, or NULL to use threads of the library itself
+ * @param executorData Arbitrary data that is passed to the executor
+ */
+void amiVideo_convertScreenBitplanesToCorrectedChunkyPixelsParallel(amiVideo_Screen *screen, unsigned int numOfThreads, amiVideo_Executor executor, void *executorData);
+
+/**
+ * Performs the same conversion as amiVideo_convertScreenBitplanesToCorrectedChunkyPixels(), but
+ * only converts the given region into the corresponding region of the
+ * corrected surface. A region of 4-bit chunky pixels is widened to whole bytes.
+ *
+ * @param screen Screen conversion structure
+ * @param region Region of the uncorrected screen that must be converted. It is clipped to the boundaries of the screen.
+ */
+void amiVideo_convertScreenBitplanesToCorrectedChunkyPixelsRegion(amiVideo_Screen *screen, const amiVideo_Region *region);
+
 /**
  * Converts the screen bitplanes surface to a corrected RGB pixel surface and
- * performs all the immediate steps.
+ * performs all the immediate steps. Every scanline is decoded once and written
+ * straight into the corrected surface, including the scanlines of 24 and 32
+ * bitplane screens.
  *
  * @param screen Screen conversion structure
  */
 void amiVideo_convertScreenBitplanesToCorrectedRGBPixels(amiVideo_Screen *screen);
 
+/**
+ * Performs the same conversion as amiVideo_convertScreenBitplanesToCorrectedRGBPixels(), but splits
+ * the frame into horizontal bands that are converted in parallel. The result is
+ * identical to the sequential conversion.
+ *
+ * @param screen Screen conversion structure
+ * @param numOfThreads Amount of bands the frame is split into. Without an executor, each band is converted by its own thread.
+ * @param executor Function that executes the bands, or NULL to use threads of the library itself
+ * @param executorData Arbitrary data that is passed to the executor
+ */
+void amiVideo_convertScreenBitplanesToCorrectedRGBPixelsParallel(amiVideo_Screen *screen, unsigned int numOfThreads, amiVideo_Executor executor, void *executorData);
+
+/**
+ * Performs the same conversion as amiVideo_convertScreenBitplanesToCorrectedRGBPixels(), but
+ * only converts the given region into the corresponding region of the
+ * corrected surface, which is scaled by the same factors as the screen.
+ *
+ * @param screen Screen conversion structure
+ * @param region Region of the uncorrected screen that must be converted. It is clipped to the boundaries of the screen.
+ */
+void amiVideo_convertScreenBitplanesToCorrectedRGBPixelsRegion(amiVideo_Screen *screen, const amiVideo_Region *region);
+
 /**
  * Converts the uncorrected chunky pixel surface to a corrected RGB pixel surface
- * and performs all the immediate steps.
+ * and performs all the immediate steps. The uncorrected RGB surface is not used.
  *
  * @param screen Screen conversion structure
  */
 void amiVideo_convertScreenChunkyPixelsToCorrectedRGBPixels(amiVideo_Screen *screen);
 
+/**
+ * Performs the same conversion as amiVideo_convertScreenChunkyPixelsToCorrectedRGBPixels(), but splits
+ * the frame into horizontal bands that are converted in parallel. The result is
+ * identical to the sequential conversion.
+ *
+ * @param screen Screen conversion structure
+ * @param numOfThreads Amount of bands the frame is split into. Without an executor, each band is converted by its own thread.
+ * @param executor Function that executes the bands, or NULL to use threads of the library itself
+ * @param executorData Arbitrary data that is passed to the executor
+ */
+void amiVideo_convertScreenChunkyPixelsToCorrectedRGBPixelsParallel(amiVideo_Screen *screen, unsigned int numOfThreads, amiVideo_Executor executor, void *executorData);
+
+/**
+ * Performs the same conversion as amiVideo_convertScreenChunkyPixelsToCorrectedRGBPixels(), but
+ * only converts the given region into the corresponding region of the
+ * corrected surface.
+ *
+ * @param screen Screen conversion structure
+ * @param region Region of the uncorrected screen that must be converted. It is clipped to the boundaries of the screen.
+ */
+void amiVideo_convertScreenChunkyPixelsToCorrectedRGBPixelsRegion(amiVideo_Screen *screen, const amiVideo_Region *region);
+
+/**
+ * Calculates the largest size of a thumbnail that fits in the given bounds and
+ * has the aspect ratio of the screen as it is displayed, taking the resolution
+ * and interlace bits of the viewport mode into account.
+ *
+ * @param screen Screen conversion structure
+ * @param maxWidth Maximum width of the thumbnail
+ * @param maxHeight Maximum height of the thumbnail
+ * @param width Returns the width of the thumbnail
+ * @param height Returns the height of the thumbnail
+ */
+void amiVideo_calculateThumbnailSize(const amiVideo_Screen *screen, unsigned int maxWidth, unsigned int maxHeight, unsigned int *width, unsigned int *height);
+
+/**
+ * Converts the screen bitplanes directly into a thumbnail of RGB pixels of an
+ * arbitrary size, without an intermediate surface of the size of the screen.
+ * The thumbnail covers the whole screen, so its aspect ratio is corrected when
+ * its size is computed with amiVideo_calculateThumbnailSize(). When sampling,
+ * only the scanlines that contain sampled pixels are read. Of these, only the
+ * bytes that contain the sampled pixels are read when the samples are far
+ * apart, otherwise the scanline is decoded up to the last sampled pixel, as
+ * are HAM scanlines. The cost of a sampled thumbnail scales with its size
+ * rather than the size of the screen.
+ *
+ * @param screen Screen conversion structure
+ * @param pixels Pixels of the thumbnail, in which every four bytes represent the color value of a pixel
+ * @param width Width of the thumbnail
+ * @param height Height of the thumbnail
+ * @param pitch Padded width of a scanline of the thumbnail in bytes
+ * @param filter Specifies how the pixels of the thumbnail are computed
+ * @param rshift Shift of the red color component of a thumbnail pixel
+ * @param gshift Shift of the green color component of a thumbnail pixel
+ * @param bshift Shift of the blue color component of a thumbnail pixel
+ * @param ashift Shift of the alpha color component of a thumbnail pixel
+ * @return TRUE if the thumbnail has been converted, FALSE if the memory for a scanline could not be allocated
+ */
+int amiVideo_convertScreenBitplanesToThumbnail(amiVideo_Screen *screen, amiVideo_ULong *pixels, unsigned int width, unsigned int height, unsigned int pitch, amiVideo_ThumbnailFilter filter, amiVideo_UByte rshift, amiVideo_UByte gshift, amiVideo_UByte bshift, amiVideo_UByte ashift);
+
+/**
+ * Initializes a stream that converts the bitplanes of the given screen one
+ * scanline at a time into the given pixel format. When the output is
+ * corrected, every fed scanline is horizontally scaled and emitted as many
+ * times as it must be vertically repeated. The palette, viewport mode and
+ * scale factor of the screen must not change while the stream is in use.
+ * Screens with 24 or 32 bitplanes can only be streamed into RGB pixel formats.
+ *
+ * @param stream Scanline stream structure
+ * @param screen Screen conversion structure that provides the properties of the bitplanes
+ * @param pixelFormat Pixel format of the emitted scanlines
+ * @param corrected TRUE to correct the aspect ratio of the emitted scanlines, FALSE to emit uncorrected scanlines
+ * @param callback Function that receives each converted scanline
+ * @param data Arbitrary data that is passed to the callback
+ * @return TRUE if the stream has been initialized, FALSE if the screen is not supported or the memory could not be allocated
+ */
+int amiVideo_initScanLineStream(amiVideo_ScanLineStream *stream, amiVideo_Screen *screen, amiVideo_PixelFormat pixelFormat, int corrected, amiVideo_ScanLineCallback callback, void *data);
+
+/**
+ * Converts the next scanline of the stream and emits the result.
+ *
+ * @param stream Scanline stream structure
+ * @param bitplaneRows Pointers to the scanline of each bitplane
+ * @return TRUE if the scanline has been converted, FALSE if all scanlines of the screen have already been fed
+ */
+int amiVideo_feedScanLineStream(amiVideo_ScanLineStream *stream, amiVideo_UByte **bitplaneRows);
+
+/**
+ * Converts the next scanline of the stream from interleaved planar data, in
+ * which the rows of all bitplanes follow each other, such as a decompressed
+ * scanline of an ILBM body.
+ *
+ * @param stream Scanline stream structure
+ * @param scanLine Rows of all bitplanes, each having the pitch of the bitplanes
+ * @return TRUE if the scanline has been converted, FALSE if all scanlines of the screen have already been fed
+ */
+int amiVideo_feedInterleavedScanLineStream(amiVideo_ScanLineStream *stream, amiVideo_UByte *scanLine);
+
+/**
+ * Frees the heap allocated members of the given scanline stream.
+ *
+ * @param stream Scanline stream structure
+ */
+void amiVideo_cleanupScanLineStream(amiVideo_ScanLineStream *stream);
+
 /**
  * Auto selects the most efficient display format for displaying the converted
  * screen. It picks RGB format for HAM displays and when 24 or 32 bitplanes are
@@ -358,10 +1216,39 @@ amiVideo_ColorFormat amiVideo_autoSelectColorFormat(const amiVideo_Screen *scree
 /**
  * Reorders the RGB pixels from the 0RGB (for 24 bitplanes) or RGBA (for 32
  * bitplanes) representation to the byte order that is actually used for the
- * display screen.
+ * display screen. The conversions of 24 and 32 bitplane screens already
+ * produce pixels in the byte order of the display, so this is only needed for
+ * pixels that have been stored in the uncorrected RGB surface by other means.
+ * Byte orders that only permute the color components, such as RGBA, ARGB and
+ * BGRA, are applied with vectorized byte shuffles.
  *
  * @param screen Screen conversion structure
  */
 void amiVideo_reorderRGBPixels(amiVideo_Screen *screen);
 
+/**
+ * Checks whether the library has been built with instrumentation enabled
+ * (configure --enable-instrumentation). Otherwise the statistics of the
+ * screens remain 0.
+ *
+ * @return TRUE if the conversions record statistics, else FALSE
+ */
+int amiVideo_checkInstrumentation(void);
+
+/**
+ * Resets all statistics of the given screen to 0.
+ *
+ * @param screen Screen conversion structure
+ */
+void amiVideo_resetScreenStats(amiVideo_Screen *screen);
+
+/**
+ * Copies the statistics of the conversions that have been performed with the
+ * given screen since it was initialized or since its statistics were reset.
+ *
+ * @param screen Screen conversion structure
+ * @param stats Statistics structure that receives a copy of the statistics
+ */
+void amiVideo_queryScreenStats(const amiVideo_Screen *screen, amiVideo_ScreenStats *stats);
+
 #endif
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __AMIVIDEO_SIMD_H
+#define __AMIVIDEO_SIMD_H
+
+/*
+ * Determines which vectorized kernels can be compiled. The x86 kernels are
+ * compiled for their specific instruction set regardless of the compiler
+ * flags, so that they can be selected at runtime. NEON kernels are only
+ * available if the compiler targets a processor that always has them.
+ */
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define AMIVIDEO_HAVE_X86_SIMD
+#define AMIVIDEO_TARGET_SSE2 __attribute__((target("sse2")))
+#define AMIVIDEO_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define AMIVIDEO_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#define AMIVIDEO_HAVE_X86_SIMD
+#define AMIVIDEO_TARGET_SSE2
+#define AMIVIDEO_TARGET_SSSE3
+#define AMIVIDEO_TARGET_AVX2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define AMIVIDEO_HAVE_NEON_SIMD
+#endif
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string.h>
+#include "swizzle.h"
+#include "cpufeatures.h"
+
+/* Returns the position in memory of the byte of a 32-bit pixel that is shifted the given amount of bits */
+static unsigned int getBytePosition(amiVideo_UByte shift)
+{
+    amiVideo_ULong probe = 1;
+
+    if(*((amiVideo_UByte*)&probe) == 1)
+        return shift / 8; /* Little endian */
+    else
+        return 3 - shift / 8; /* Big endian */
+}
+
+void amiVideo_compileSwizzleLayout(amiVideo_SwizzleLayout *layout, amiVideo_UByte sourceRshift, amiVideo_UByte sourceGshift, amiVideo_UByte sourceBshift, amiVideo_UByte sourceAshift, amiVideo_UByte targetRshift, amiVideo_UByte targetGshift, amiVideo_UByte targetBshift, amiVideo_UByte targetAshift)
+{
+    amiVideo_UByte pixelShuffle[4];
+    unsigned int i;
+
+    layout->sourceShifts[0] = sourceRshift;
+    layout->sourceShifts[1] = sourceGshift;
+    layout->sourceShifts[2] = sourceBshift;
+    layout->sourceShifts[3] = sourceAshift;
+    layout->targetShifts[0] = targetRshift;
+    layout->targetShifts[1] = targetGshift;
+    layout->targetShifts[2] = targetBshift;
+    layout->targetShifts[3] = targetAshift;
+
+    layout->identity = memcmp(layout->sourceShifts, layout->targetShifts, 4) == 0;
+    layout->permutation = 1;
+    memset(pixelShuffle, 0x80, sizeof(pixelShuffle));
+
+    /* Determine from which source byte each target byte of a pixel is taken */
+    for(i = 0; i < 4; i++)
+    {
+        amiVideo_UByte sourceShift = layout->sourceShifts[i];
+        amiVideo_UByte targetShift = layout->targetShifts[i];
+
+        if(sourceShift % 8 != 0 || sourceShift > 24 || targetShift % 8 != 0 || targetShift > 24 || pixelShuffle[getBytePosition(targetShift)] != 0x80)
+            layout->permutation = 0; /* Components that are not byte aligned or that overlap must be combined with shifts */
+        else
+            pixelShuffle[getBytePosition(targetShift)] = (amiVideo_UByte)getBytePosition(sourceShift);
+    }
+
+    /* Repeat the shuffle of a single pixel for each pixel of a vector */
+    for(i = 0; i < 16; i++)
+        layout->shuffle[i] = pixelShuffle[i % 4] == 0x80 ? 0x80 : (amiVideo_UByte)(pixelShuffle[i % 4] + (i / 4) * 4);
+}
+
+void amiVideo_swizzlePixelsScalar(const amiVideo_SwizzleLayout *layout, const amiVideo_ULong *source, unsigned int numOfPixels, amiVideo_ULong *target)
+{
+    unsigned int i;
+
+    for(i = 0; i < numOfPixels; i++)
+    {
+        amiVideo_ULong pixel = source[i];
+
+        target[i] = (((pixel >> layout->sourceShifts[0]) & 0xff) << layout->targetShifts[0])
+            | (((pixel >> layout->sourceShifts[1]) & 0xff) << layout->targetShifts[1])
+            | (((pixel >> layout->sourceShifts[2]) & 0xff) << layout->targetShifts[2])
+            | (((pixel >> layout->sourceShifts[3]) & 0xff) << layout->targetShifts[3]);
+    }
+}
+
+static amiVideo_SwizzlePixelsKernel kernel;
+static int kernelSelected = 0;
+
+static void selectSwizzleKernels(amiVideo_ULong features)
+{
+    kernel = amiVideo_swizzlePixelsScalar;
+
+#if defined(AMIVIDEO_HAVE_X86_SIMD)
+    if(features & AMIVIDEO_CPU_AVX2)
+        kernel = amiVideo_swizzlePixelsAVX2;
+    else if(features & AMIVIDEO_CPU_SSSE3)
+        kernel = amiVideo_swizzlePixelsSSSE3;
+#elif defined(AMIVIDEO_HAVE_NEON_SIMD)
+    if(features & AMIVIDEO_CPU_NEON)
+        kernel = amiVideo_swizzlePixelsNEON;
+#endif
+}
+
+amiVideo_SwizzlePixelsKernel amiVideo_getSwizzlePixelsKernel(void)
+{
+    if(!kernelSelected)
+    {
+        selectSwizzleKernels(amiVideo_getCPUFeatures());
+        kernelSelected = 1;
+    }
+
+    return kernel;
+}
+
+void amiVideo_resetSwizzleKernels(void)
+{
+    kernelSelected = 0;
+}
+
+void amiVideo_swizzlePixels(const amiVideo_SwizzleLayout *layout, const amiVideo_ULong *source, unsigned int numOfPixels, amiVideo_ULong *target)
+{
+    if(layout->identity)
+    {
+        if(source != target)
+            memmove(target, source, numOfPixels * sizeof(amiVideo_ULong));
+    }
+    else if(layout->permutation)
+        amiVideo_getSwizzlePixelsKernel()(layout, source, numOfPixels, target);
+    else
+        amiVideo_swizzlePixelsScalar(layout, source, numOfPixels, target);
+}
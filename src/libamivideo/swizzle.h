@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __AMIVIDEO_SWIZZLE_H
+#define __AMIVIDEO_SWIZZLE_H
+#include "amivideotypes.h"
+#include "simd.h"
+
+/**
+ * A compiled layout that moves the color components of 32-bit RGB pixels from
+ * the shifts of the source pixels to the shifts of the target pixels. When all
+ * shifts are multiples of 8 and no two components end up in the same byte, the
+ * layout is a permutation of the bytes of each pixel, which the vectorized
+ * kernels apply with a single byte shuffle.
+ */
+typedef struct
+{
+    /** Shifts of the red, green, blue and alpha components in the source pixels */
+    amiVideo_UByte sourceShifts[4];
+
+    /** Shifts of the red, green, blue and alpha components in the target pixels */
+    amiVideo_UByte targetShifts[4];
+
+    /** Byte shuffle mask that composes 4 target pixels from 4 source pixels in memory order. Bytes that do not receive a component are 0x80, which clears them */
+    amiVideo_UByte shuffle[16];
+
+    /** Indicates whether the layout can be applied with the shuffle mask */
+    int permutation;
+
+    /** Indicates whether the source and target pixels have the same layout */
+    int identity;
+}
+amiVideo_SwizzleLayout;
+
+/**
+ * Moves the color components of RGB pixels to the positions of the target
+ * layout. The source and target may refer to the same pixels.
+ *
+ * @param layout A compiled swizzle layout
+ * @param source RGB pixels in the source layout
+ * @param numOfPixels Amount of pixels that must be swizzled
+ * @param target RGB pixels that receive the result
+ */
+typedef void (*amiVideo_SwizzlePixelsKernel)(const amiVideo_SwizzleLayout *layout, const amiVideo_ULong *source, unsigned int numOfPixels, amiVideo_ULong *target);
+
+/**
+ * Compiles the shifts of a source and target layout into a swizzle layout.
+ *
+ * @param layout Swizzle layout that receives the result
+ * @param sourceRshift The amount of bits that the red color component is shifted in the source pixels
+ * @param sourceGshift The amount of bits that the green color component is shifted in the source pixels
+ * @param sourceBshift The amount of bits that the blue color component is shifted in the source pixels
+ * @param sourceAshift The amount of bits that the alpha color component is shifted in the source pixels
+ * @param targetRshift The amount of bits that the red color component is shifted in the target pixels
+ * @param targetGshift The amount of bits that the green color component is shifted in the target pixels
+ * @param targetBshift The amount of bits that the blue color component is shifted in the target pixels
+ * @param targetAshift The amount of bits that the alpha color component is shifted in the target pixels
+ */
+void amiVideo_compileSwizzleLayout(amiVideo_SwizzleLayout *layout, amiVideo_UByte sourceRshift, amiVideo_UByte sourceGshift, amiVideo_UByte sourceBshift, amiVideo_UByte sourceAshift, amiVideo_UByte targetRshift, amiVideo_UByte targetGshift, amiVideo_UByte targetBshift, amiVideo_UByte targetAshift);
+
+/**
+ * Portable swizzle kernel that extracts and shifts every component
+ * separately. It supports every layout, including layouts that are no
+ * permutation.
+ */
+void amiVideo_swizzlePixelsScalar(const amiVideo_SwizzleLayout *layout, const amiVideo_ULong *source, unsigned int numOfPixels, amiVideo_ULong *target);
+
+#if defined(AMIVIDEO_HAVE_X86_SIMD)
+/**
+ * Swizzle kernels that apply the shuffle mask of a permutation to 4 (SSSE3)
+ * or 8 (AVX2) pixels at once.
+ */
+void amiVideo_swizzlePixelsSSSE3(const amiVideo_SwizzleLayout *layout, const amiVideo_ULong *source, unsigned int numOfPixels, amiVideo_ULong *target);
+void amiVideo_swizzlePixelsAVX2(const amiVideo_SwizzleLayout *layout, const amiVideo_ULong *source, unsigned int numOfPixels, amiVideo_ULong *target);
+#endif
+
+#if defined(AMIVIDEO_HAVE_NEON_SIMD)
+/**
+ * Swizzle kernel that applies the shuffle mask of a permutation to 4 pixels
+ * at once with a NEON table lookup.
+ */
+void amiVideo_swizzlePixelsNEON(const amiVideo_SwizzleLayout *layout, const amiVideo_ULong *source, unsigned int numOfPixels, amiVideo_ULong *target);
+#endif
+
+/**
+ * Returns the most efficient kernel for the current processor that applies
+ * permutations. The kernel is selected the first time this function is
+ * invoked.
+ *
+ * @return A swizzle kernel that supports layouts that are permutations
+ */
+amiVideo_SwizzlePixelsKernel amiVideo_getSwizzlePixelsKernel(void);
+
+/**
+ * Discards the selected kernel so that it is selected again on the next
+ * request, e.g. after the usable processor features have been restricted.
+ */
+void amiVideo_resetSwizzleKernels(void);
+
+/**
+ * Swizzles RGB pixels with the most efficient kernel for the given layout.
+ * Pixels that already have the target layout are copied, or left alone if the
+ * source and target are the same.
+ *
+ * @param layout A compiled swizzle layout
+ * @param source RGB pixels in the source layout
+ * @param numOfPixels Amount of pixels that must be swizzled
+ * @param target RGB pixels that receive the result
+ */
+void amiVideo_swizzlePixels(const amiVideo_SwizzleLayout *layout, const amiVideo_ULong *source, unsigned int numOfPixels, amiVideo_ULong *target);
+
+#endif
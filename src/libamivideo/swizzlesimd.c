@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "swizzle.h"
+
+/*
+ * The vectorized swizzle kernels permute the bytes of a vector of pixels with
+ * the shuffle mask of the layout, which repeats the permutation of a single
+ * pixel for every pixel of the vector. Remaining pixels that do not fill a
+ * vector are swizzled by the scalar kernel.
+ */
+
+#if defined(AMIVIDEO_HAVE_X86_SIMD) || defined(AMIVIDEO_HAVE_NEON_SIMD)
+
+#if defined(AMIVIDEO_HAVE_X86_SIMD)
+#include <immintrin.h>
+#else
+#include <arm_neon.h>
+#endif
+
+#if defined(AMIVIDEO_HAVE_X86_SIMD)
+
+AMIVIDEO_TARGET_SSSE3 void amiVideo_swizzlePixelsSSSE3(const amiVideo_SwizzleLayout *layout, const amiVideo_ULong *source, unsigned int numOfPixels, amiVideo_ULong *target)
+{
+    __m128i shuffle = _mm_loadu_si128((const __m128i*)layout->shuffle);
+    unsigned int i;
+
+    for(i = 0; i + 4 <= numOfPixels; i += 4)
+        _mm_storeu_si128((__m128i*)(target + i), _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(source + i)), shuffle));
+
+    amiVideo_swizzlePixelsScalar(layout, source + i, numOfPixels - i, target + i);
+}
+
+/* AVX2 byte shuffles operate within each 128-bit lane, so both lanes use the same mask */
+
+AMIVIDEO_TARGET_AVX2 void amiVideo_swizzlePixelsAVX2(const amiVideo_SwizzleLayout *layout, const amiVideo_ULong *source, unsigned int numOfPixels, amiVideo_ULong *target)
+{
+    __m256i shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)layout->shuffle));
+    unsigned int i;
+
+    for(i = 0; i + 8 <= numOfPixels; i += 8)
+        _mm256_storeu_si256((__m256i*)(target + i), _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(source + i)), shuffle));
+
+    amiVideo_swizzlePixelsSSSE3(layout, source + i, numOfPixels - i, target + i);
+}
+
+#else
+
+void amiVideo_swizzlePixelsNEON(const amiVideo_SwizzleLayout *layout, const amiVideo_ULong *source, unsigned int numOfPixels, amiVideo_ULong *target)
+{
+    uint8x16_t shuffle = vld1q_u8(layout->shuffle);
+    unsigned int i;
+
+    for(i = 0; i + 4 <= numOfPixels; i += 4)
+    {
+        uint8x16_t v = vld1q_u8((const amiVideo_UByte*)(source + i));
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+        vst1q_u8((amiVideo_UByte*)(target + i), vqtbl1q_u8(v, shuffle)); /* Out of range indexes, such as 0x80, yield zero */
+#else
+        uint8x8x2_t table;
+
+        table.val[0] = vget_low_u8(v);
+        table.val[1] = vget_high_u8(v);
+        vst1q_u8((amiVideo_UByte*)(target + i), vcombine_u8(vtbl2_u8(table, vget_low_u8(shuffle)), vtbl2_u8(table, vget_high_u8(shuffle))));
+#endif
+    }
+
+    amiVideo_swizzlePixelsScalar(layout, source + i, numOfPixels - i, target + i);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "threads.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#define AMIVIDEO_HAVE_THREADS
+#elif defined(HAVE_PTHREAD_H)
+#include <pthread.h>
+#define AMIVIDEO_HAVE_THREADS
+#endif
+
+#if defined(AMIVIDEO_HAVE_THREADS)
+
+typedef struct
+{
+    amiVideo_BandFunction function;
+    void *data;
+    unsigned int band;
+
+    /** Indicates whether a thread processes the band */
+    int started;
+
+#if defined(_WIN32)
+    HANDLE thread;
+#else
+    pthread_t thread;
+#endif
+}
+amiVideo_BandTask;
+
+#if defined(_WIN32)
+static DWORD WINAPI runBandTask(LPVOID parameter)
+#else
+static void *runBandTask(void *parameter)
+#endif
+{
+    amiVideo_BandTask *task = (amiVideo_BandTask*)parameter;
+    task->function(task->data, task->band);
+    return 0;
+}
+
+static int startBandTask(amiVideo_BandTask *task)
+{
+#if defined(_WIN32)
+    task->thread = CreateThread(NULL, 0, runBandTask, task, 0, NULL);
+    return task->thread != NULL;
+#else
+    return pthread_create(&task->thread, NULL, runBandTask, task) == 0;
+#endif
+}
+
+static void joinBandTask(amiVideo_BandTask *task)
+{
+#if defined(_WIN32)
+    WaitForSingleObject(task->thread, INFINITE);
+    CloseHandle(task->thread);
+#else
+    pthread_join(task->thread, NULL);
+#endif
+}
+
+#endif
+
+void amiVideo_runBandsInThreads(amiVideo_BandFunction function, void *data, unsigned int numOfBands)
+{
+#if defined(AMIVIDEO_HAVE_THREADS)
+    amiVideo_BandTask *tasks = (amiVideo_BandTask*)malloc(numOfBands * sizeof(amiVideo_BandTask));
+#else
+    void *tasks = NULL;
+#endif
+    unsigned int i;
+
+    if(tasks == NULL)
+    {
+        /* Without threads, we process all bands in the calling thread */
+        for(i = 0; i < numOfBands; i++)
+            function(data, i);
+    }
+#if defined(AMIVIDEO_HAVE_THREADS)
+    else
+    {
+        /* Start a thread for every band but the first */
+        for(i = 1; i < numOfBands; i++)
+        {
+            tasks[i].function = function;
+            tasks[i].data = data;
+            tasks[i].band = i;
+            tasks[i].started = startBandTask(&tasks[i]);
+
+            if(!tasks[i].started)
+                function(data, i); /* If a thread cannot be created, process the band ourselves */
+        }
+
+        /* The calling thread processes the first band */
+        function(data, 0);
+
+        /* Wait for all other bands to complete */
+        for(i = 1; i < numOfBands; i++)
+        {
+            if(tasks[i].started)
+                joinBandTask(&tasks[i]);
+        }
+
+        free(tasks);
+    }
+#endif
+}
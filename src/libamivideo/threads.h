@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2012 Sander van der Burg
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __AMIVIDEO_THREADS_H
+#define __AMIVIDEO_THREADS_H
+#include "screen.h"
+
+/**
+ * Invokes the given function for every band of a frame, each in a separate
+ * thread. The calling thread processes the first band itself. This function
+ * returns after all bands have been processed. If the platform has no thread
+ * support, the bands are processed one after another.
+ *
+ * @param function Function that must be invoked for each band
+ * @param data Conversion state that must be passed to the function
+ * @param numOfBands Amount of bands the frame is split into
+ */
+void amiVideo_runBandsInThreads(amiVideo_BandFunction function, void *data, unsigned int numOfBands);
+
+#endif
@@ -0,0 +1,529 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <screen.h>
+#include <anim.h>
+
+#define WIDTH 48
+#define HEIGHT 16
+#define BITPLANE_DEPTH 4
+#define PITCH 6
+#define LOWRES_PIXEL_SCALE_FACTOR 2
+#define BITPLANES_SIZE (PITCH * HEIGHT * BITPLANE_DEPTH)
+#define MAX_DELTA_SIZE 8192
+#define NUM_OF_WRAP_ROWS 8
+#define WRAP_Y 6
+#define WRAP_PLAYFIELD_SIZE (PITCH * NUM_OF_WRAP_ROWS * BITPLANE_DEPTH)
+
+static amiVideo_Color colors[16];
+
+static void putValue(amiVideo_UByte *buffer, unsigned int *pos, amiVideo_ULong value, unsigned int size)
+{
+    unsigned int i;
+
+    for(i = 0; i < size; i++)
+        buffer[(*pos)++] = (amiVideo_UByte)(value >> (8 * (size - 1 - i)));
+}
+
+static void getItem(const amiVideo_UByte *from, const amiVideo_UByte *to, unsigned int offset, unsigned int size, int xorMode, amiVideo_UByte *item)
+{
+    unsigned int i;
+
+    for(i = 0; i < size; i++)
+        item[i] = xorMode ? from[offset + i] ^ to[offset + i] : to[offset + i];
+}
+
+/* Straight forward encoder that emits skip, same and unique opcodes for every column */
+static unsigned int encodeDelta(const amiVideo_UByte *from, const amiVideo_UByte *to, unsigned int operation, amiVideo_ULong bits, amiVideo_UByte *delta)
+{
+    unsigned int itemSize = operation == AMIVIDEO_ANIM_OPERATION_BYTE_VERTICAL_DELTA ? 1 : ((bits & AMIVIDEO_ANIM_BITS_LONG_DATA) ? 4 : 2);
+    unsigned int opcodeSize = operation == AMIVIDEO_ANIM_OPERATION_SHORT_LONG_VERTICAL_DELTA_INLINE ? itemSize : 1;
+    amiVideo_ULong maxCount = opcodeSize == 1 ? 127 : 0x7fff;
+    int xorMode = (bits & AMIVIDEO_ANIM_BITS_XOR) != 0;
+    unsigned int pos = 64;
+    unsigned int i;
+
+    memset(delta, '\0', pos);
+
+    for(i = 0; i < BITPLANE_DEPTH; i++)
+    {
+        const amiVideo_UByte *fromPlane = from + i * HEIGHT * PITCH;
+        const amiVideo_UByte *toPlane = to + i * HEIGHT * PITCH;
+        amiVideo_UByte data[MAX_DELTA_SIZE];
+        unsigned int dataSize = 0;
+        unsigned int opcodePos = pos;
+        unsigned int offsetPos;
+        unsigned int x;
+
+        if(memcmp(fromPlane, toPlane, HEIGHT * PITCH) == 0)
+            continue; /* Leave the offset 0 */
+
+        for(x = 0; x < PITCH; x += itemSize)
+        {
+            unsigned int columnSize = PITCH - x < itemSize ? PITCH - x : itemSize;
+            amiVideo_UByte ops[MAX_DELTA_SIZE];
+            unsigned int opsSize = 0, numOfOps = 0, row = 0;
+
+            while(row < HEIGHT)
+            {
+                unsigned int count = 0;
+
+                if(memcmp(fromPlane + row * PITCH + x, toPlane + row * PITCH + x, columnSize) == 0)
+                {
+                    while(row + count < HEIGHT && count < maxCount && memcmp(fromPlane + (row + count) * PITCH + x, toPlane + (row + count) * PITCH + x, columnSize) == 0)
+                        count++;
+
+                    putValue(ops, &opsSize, count, opcodeSize);
+                }
+                else if(row + 1 < HEIGHT && memcmp(toPlane + row * PITCH + x, toPlane + (row + 1) * PITCH + x, columnSize) == 0 && memcmp(fromPlane + row * PITCH + x, fromPlane + (row + 1) * PITCH + x, columnSize) == 0)
+                {
+                    amiVideo_UByte item[4];
+
+                    /* Repeat an item for as long as it, and the item that it modifies, are the same */
+                    while(row + count < HEIGHT && count < maxCount && memcmp(toPlane + row * PITCH + x, toPlane + (row + count) * PITCH + x, columnSize) == 0 && memcmp(fromPlane + row * PITCH + x, fromPlane + (row + count) * PITCH + x, columnSize) == 0)
+                        count++;
+
+                    getItem(fromPlane, toPlane, row * PITCH + x, columnSize, xorMode, item);
+                    putValue(ops, &opsSize, 0, opcodeSize);
+                    putValue(ops, &opsSize, count, opcodeSize);
+
+                    if(operation == AMIVIDEO_ANIM_OPERATION_SHORT_LONG_VERTICAL_DELTA)
+                    {
+                        memcpy(data + dataSize, item, columnSize);
+                        dataSize += columnSize;
+                    }
+                    else
+                    {
+                        memcpy(ops + opsSize, item, columnSize);
+                        opsSize += columnSize;
+                    }
+                }
+                else
+                {
+                    amiVideo_UByte items[HEIGHT * 4];
+
+                    while(row + count < HEIGHT && count < maxCount && memcmp(fromPlane + (row + count) * PITCH + x, toPlane + (row + count) * PITCH + x, columnSize) != 0)
+                    {
+                        getItem(fromPlane, toPlane, (row + count) * PITCH + x, columnSize, xorMode, items + count * columnSize);
+                        count++;
+                    }
+
+                    putValue(ops, &opsSize, ((amiVideo_ULong)1 << (opcodeSize * 8 - 1)) | count, opcodeSize);
+
+                    if(operation == AMIVIDEO_ANIM_OPERATION_SHORT_LONG_VERTICAL_DELTA)
+                    {
+                        memcpy(data + dataSize, items, count * columnSize);
+                        dataSize += count * columnSize;
+                    }
+                    else
+                    {
+                        memcpy(ops + opsSize, items, count * columnSize);
+                        opsSize += count * columnSize;
+                    }
+                }
+
+                row += count;
+                numOfOps++;
+            }
+
+            putValue(delta, &pos, numOfOps, opcodeSize);
+            memcpy(delta + pos, ops, opsSize);
+            pos += opsSize;
+        }
+
+        offsetPos = i * 4;
+        putValue(delta, &offsetPos, opcodePos, 4);
+
+        if(operation == AMIVIDEO_ANIM_OPERATION_SHORT_LONG_VERTICAL_DELTA)
+        {
+            /* The data list of the bitplane succeeds its opcode list */
+            offsetPos = (i + 8) * 4;
+            putValue(delta, &offsetPos, pos, 4);
+            memcpy(delta + pos, data, dataSize);
+            pos += dataSize;
+        }
+    }
+
+    return pos;
+}
+
+static void convertFrame(amiVideo_UByte *bitplanes, amiVideo_UByte *chunkyPixels, amiVideo_ULong *pixels)
+{
+    amiVideo_Screen screen;
+
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, BITPLANE_DEPTH, 8, 0);
+    amiVideo_setLowresPixelScaleFactor(&screen, LOWRES_PIXEL_SCALE_FACTOR);
+    amiVideo_setBitplanePaletteColors(&screen.palette, colors, 16);
+    amiVideo_setScreenBitplanes(&screen, bitplanes);
+    amiVideo_setScreenUncorrectedChunkyPixelsPointer(&screen, chunkyPixels, WIDTH);
+    amiVideo_setScreenCorrectedPixelsPointer(&screen, pixels, screen.correctedFormat.width * 4, 4, 0, 16, 8, 0, 24);
+    amiVideo_convertScreenBitplanesToChunkyPixels(&screen);
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixels(&screen);
+    amiVideo_cleanupScreen(&screen);
+}
+
+static int checkDelta(const amiVideo_UByte *from, amiVideo_UByte *to, unsigned int operation, amiVideo_ULong bits, unsigned int firstRow, unsigned int lastRow)
+{
+    amiVideo_UByte delta[MAX_DELTA_SIZE];
+    amiVideo_UByte bitplanes[BITPLANES_SIZE];
+    amiVideo_UByte chunkyPixels[WIDTH * HEIGHT];
+    amiVideo_UByte expectedChunkyPixels[WIDTH * HEIGHT];
+    amiVideo_ULong pixels[WIDTH * HEIGHT * LOWRES_PIXEL_SCALE_FACTOR * LOWRES_PIXEL_SCALE_FACTOR];
+    amiVideo_ULong expectedPixels[WIDTH * HEIGHT * LOWRES_PIXEL_SCALE_FACTOR * LOWRES_PIXEL_SCALE_FACTOR];
+    unsigned int deltaSize = encodeDelta(from, to, operation, bits, delta);
+    amiVideo_Screen screen;
+    int status = 0;
+
+    /* Convert the frame to which the delta refers */
+    memcpy(bitplanes, from, BITPLANES_SIZE);
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, BITPLANE_DEPTH, 8, 0);
+    amiVideo_setLowresPixelScaleFactor(&screen, LOWRES_PIXEL_SCALE_FACTOR);
+    amiVideo_setBitplanePaletteColors(&screen.palette, colors, 16);
+    amiVideo_setScreenBitplanes(&screen, bitplanes);
+    amiVideo_setScreenUncorrectedChunkyPixelsPointer(&screen, chunkyPixels, WIDTH);
+    amiVideo_setScreenCorrectedPixelsPointer(&screen, pixels, screen.correctedFormat.width * 4, 4, 0, 16, 8, 0, 24);
+    amiVideo_setScreenDeltaConversion(&screen, 1);
+    amiVideo_convertScreenBitplanesToChunkyPixels(&screen);
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixels(&screen);
+
+    /* Apply the delta and only convert the modified scanlines of both surfaces */
+    if(!amiVideo_applyScreenDelta(&screen, operation, bits, delta, deltaSize))
+    {
+        fprintf(stderr, "Cannot apply delta with operation: %u and bits: %x!\n", operation, bits);
+        status = 1;
+    }
+
+    chunkyPixels[0] ^= 0xff; /* Scanlines that have not been modified must not be converted again */
+    amiVideo_convertScreenBitplanesToChunkyPixels(&screen);
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixels(&screen);
+    convertFrame(to, expectedChunkyPixels, expectedPixels);
+    expectedChunkyPixels[0] ^= 0xff;
+
+    if(memcmp(bitplanes, to, BITPLANES_SIZE) != 0 || memcmp(chunkyPixels, expectedChunkyPixels, sizeof(chunkyPixels)) != 0 || memcmp(pixels, expectedPixels, sizeof(pixels)) != 0)
+    {
+        fprintf(stderr, "The frame produced by the delta with operation: %u and bits: %x is incorrect!\n", operation, bits);
+        status = 1;
+    }
+
+    if(screen.deltaFormat.numOfDirtyRows != 1 || screen.deltaFormat.dirtyRows[0].firstRow != firstRow || screen.deltaFormat.dirtyRows[0].lastRow != lastRow)
+    {
+        fprintf(stderr, "The modified scanlines of the delta with operation: %u and bits: %x are incorrect!\n", operation, bits);
+        status = 1;
+    }
+
+    /* Truncated deltas must be rejected */
+    if(amiVideo_applyScreenDelta(&screen, operation, bits, delta, deltaSize - 1))
+    {
+        fprintf(stderr, "A truncated delta with operation: %u and bits: %x should be rejected!\n", operation, bits);
+        status = 1;
+    }
+
+    amiVideo_cleanupScreen(&screen);
+
+    return status;
+}
+
+static int checkConvertedFrame(const amiVideo_ULong *pixels, const amiVideo_UByte *bitplanes, const char *message)
+{
+    amiVideo_UByte chunkyPixels[WIDTH * HEIGHT];
+    amiVideo_ULong expectedPixels[WIDTH * HEIGHT * LOWRES_PIXEL_SCALE_FACTOR * LOWRES_PIXEL_SCALE_FACTOR];
+
+    convertFrame((amiVideo_UByte*)bitplanes, chunkyPixels, expectedPixels);
+
+    if(memcmp(pixels, expectedPixels, sizeof(expectedPixels)) != 0)
+    {
+        fprintf(stderr, "%s\n", message);
+        return 1;
+    }
+
+    return 0;
+}
+
+/* A delta may only restrict the conversion to its scanlines if the target surface contains the previous frame, converted with the same settings */
+static int checkOutdatedTargets(const amiVideo_UByte *from, const amiVideo_UByte *to)
+{
+    amiVideo_UByte delta[MAX_DELTA_SIZE];
+    amiVideo_UByte bitplanes[BITPLANES_SIZE];
+    amiVideo_UByte other[BITPLANES_SIZE];
+    amiVideo_ULong pixels[WIDTH * HEIGHT * LOWRES_PIXEL_SCALE_FACTOR * LOWRES_PIXEL_SCALE_FACTOR];
+    amiVideo_ULong otherPixels[WIDTH * HEIGHT * LOWRES_PIXEL_SCALE_FACTOR * LOWRES_PIXEL_SCALE_FACTOR];
+    amiVideo_Color color = colors[0];
+    unsigned int deltaSize, i;
+    amiVideo_Screen screen;
+    int status = 0;
+
+    memcpy(bitplanes, from, BITPLANES_SIZE);
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, BITPLANE_DEPTH, 8, 0);
+    amiVideo_setLowresPixelScaleFactor(&screen, LOWRES_PIXEL_SCALE_FACTOR);
+    amiVideo_setBitplanePaletteColors(&screen.palette, colors, 16);
+    amiVideo_setScreenBitplanes(&screen, bitplanes);
+    amiVideo_setScreenCorrectedPixelsPointer(&screen, pixels, screen.correctedFormat.width * 4, 4, 0, 16, 8, 0, 24);
+    amiVideo_setScreenDeltaConversion(&screen, 1);
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixels(&screen);
+
+    /* Change the background color along with the delta, as the CMAP chunk of an ANIM frame does */
+    deltaSize = encodeDelta(from, to, AMIVIDEO_ANIM_OPERATION_BYTE_VERTICAL_DELTA, 0, delta);
+    amiVideo_applyScreenDelta(&screen, AMIVIDEO_ANIM_OPERATION_BYTE_VERTICAL_DELTA, 0, delta, deltaSize);
+    colors[0].r ^= 0xff;
+    amiVideo_setBitplanePaletteColors(&screen.palette, colors, 16);
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixels(&screen);
+    status |= checkConvertedFrame(pixels, to, "The palette change along with a delta is not converted!");
+
+    /* Convert a delta that only modifies the first scanline into another surface */
+    memcpy(other, to, BITPLANES_SIZE);
+
+    for(i = 0; i < BITPLANE_DEPTH; i++)
+        other[i * HEIGHT * PITCH] ^= 0xff;
+
+    deltaSize = encodeDelta(to, other, AMIVIDEO_ANIM_OPERATION_BYTE_VERTICAL_DELTA, 0, delta);
+    amiVideo_applyScreenDelta(&screen, AMIVIDEO_ANIM_OPERATION_BYTE_VERTICAL_DELTA, 0, delta, deltaSize);
+    memset(otherPixels, '\0', sizeof(otherPixels));
+    amiVideo_setScreenCorrectedPixelsPointer(&screen, otherPixels, screen.correctedFormat.width * 4, 4, 0, 16, 8, 0, 24);
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixels(&screen);
+    status |= checkConvertedFrame(otherPixels, other, "A delta converted into a new surface is incomplete!");
+
+    /* Skip the conversion of a delta, so that the scanlines that it has modified are out of date */
+    deltaSize = encodeDelta(other, to, AMIVIDEO_ANIM_OPERATION_BYTE_VERTICAL_DELTA, 0, delta);
+    amiVideo_applyScreenDelta(&screen, AMIVIDEO_ANIM_OPERATION_BYTE_VERTICAL_DELTA, 0, delta, deltaSize);
+    deltaSize = encodeDelta(to, from, AMIVIDEO_ANIM_OPERATION_BYTE_VERTICAL_DELTA, 0, delta);
+    amiVideo_applyScreenDelta(&screen, AMIVIDEO_ANIM_OPERATION_BYTE_VERTICAL_DELTA, 0, delta, deltaSize);
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixels(&screen);
+    status |= checkConvertedFrame(otherPixels, from, "The scanlines of a delta that was not converted are out of date!");
+
+    colors[0] = color;
+    amiVideo_cleanupScreen(&screen);
+
+    return status;
+}
+
+/* A delta conversion only converts the columns that the delta has modified */
+static int checkDeltaColumns(const amiVideo_UByte *from)
+{
+    amiVideo_UByte delta[MAX_DELTA_SIZE];
+    amiVideo_UByte bitplanes[BITPLANES_SIZE];
+    amiVideo_UByte to[BITPLANES_SIZE];
+    amiVideo_UByte chunkyPixels[WIDTH * HEIGHT];
+    amiVideo_UByte expectedChunkyPixels[WIDTH * HEIGHT];
+    amiVideo_ULong pixels[WIDTH * HEIGHT * LOWRES_PIXEL_SCALE_FACTOR * LOWRES_PIXEL_SCALE_FACTOR];
+    amiVideo_ULong expectedPixels[WIDTH * HEIGHT * LOWRES_PIXEL_SCALE_FACTOR * LOWRES_PIXEL_SCALE_FACTOR];
+    unsigned int deltaSize, outsidePixel, i;
+    amiVideo_Screen screen;
+    int status = 0;
+
+    /* Only modify the third byte column of the second bitplane */
+    memcpy(to, from, BITPLANES_SIZE);
+
+    for(i = 5; i < 11; i++)
+        to[(HEIGHT + i) * PITCH + 2] ^= 0xff;
+
+    memcpy(bitplanes, from, BITPLANES_SIZE);
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, BITPLANE_DEPTH, 8, 0);
+    amiVideo_setLowresPixelScaleFactor(&screen, LOWRES_PIXEL_SCALE_FACTOR);
+    amiVideo_setBitplanePaletteColors(&screen.palette, colors, 16);
+    amiVideo_setScreenBitplanes(&screen, bitplanes);
+    amiVideo_setScreenUncorrectedChunkyPixelsPointer(&screen, chunkyPixels, WIDTH);
+    amiVideo_setScreenCorrectedPixelsPointer(&screen, pixels, screen.correctedFormat.width * 4, 4, 0, 16, 8, 0, 24);
+    amiVideo_setScreenDeltaConversion(&screen, 1);
+    amiVideo_convertScreenBitplanesToChunkyPixels(&screen);
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixels(&screen);
+
+    deltaSize = encodeDelta(from, to, AMIVIDEO_ANIM_OPERATION_BYTE_VERTICAL_DELTA, 0, delta);
+    amiVideo_applyScreenDelta(&screen, AMIVIDEO_ANIM_OPERATION_BYTE_VERTICAL_DELTA, 0, delta, deltaSize);
+
+    /* The first pixel of a modified scanline is outside the modified columns, so it must not be converted again */
+    outsidePixel = 6 * LOWRES_PIXEL_SCALE_FACTOR * screen.correctedFormat.width;
+    chunkyPixels[6 * WIDTH] ^= 0xff;
+    pixels[outsidePixel] ^= 0xff;
+    amiVideo_convertScreenBitplanesToChunkyPixels(&screen);
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixels(&screen);
+    convertFrame(to, expectedChunkyPixels, expectedPixels);
+    expectedChunkyPixels[6 * WIDTH] ^= 0xff;
+    expectedPixels[outsidePixel] ^= 0xff;
+
+    if(screen.deltaFormat.firstColumn != 2 || screen.deltaFormat.lastColumn != 3
+      || memcmp(chunkyPixels, expectedChunkyPixels, sizeof(chunkyPixels)) != 0 || memcmp(pixels, expectedPixels, sizeof(pixels)) != 0)
+    {
+        fprintf(stderr, "The columns modified by a delta are not converted correctly!\n");
+        status = 1;
+    }
+
+    amiVideo_cleanupScreen(&screen);
+
+    return status;
+}
+
+/* A corrupt column must stop the delta, instead of patching the bitplanes that follow */
+static int checkCorruptDelta(const amiVideo_UByte *from, const amiVideo_UByte *to)
+{
+    amiVideo_UByte delta[MAX_DELTA_SIZE];
+    amiVideo_UByte bitplanes[BITPLANES_SIZE];
+    unsigned int deltaSize = encodeDelta(from, to, AMIVIDEO_ANIM_OPERATION_BYTE_VERTICAL_DELTA, 0, delta);
+    unsigned int offset = (delta[0] << 24) | (delta[1] << 16) | (delta[2] << 8) | delta[3];
+    amiVideo_Screen screen;
+    int status = 0;
+
+    /* The first opcode of the first bitplane skips beyond the last scanline */
+    delta[offset + 1] = 0x7f;
+
+    memcpy(bitplanes, from, BITPLANES_SIZE);
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, BITPLANE_DEPTH, 8, 0);
+    amiVideo_setScreenBitplanes(&screen, bitplanes);
+
+    if(amiVideo_applyScreenDelta(&screen, AMIVIDEO_ANIM_OPERATION_BYTE_VERTICAL_DELTA, 0, delta, deltaSize) || memcmp(bitplanes, from, BITPLANES_SIZE) != 0)
+    {
+        fprintf(stderr, "A corrupt delta must be rejected without modifying any bitplane!\n");
+        status = 1;
+    }
+
+    amiVideo_cleanupScreen(&screen);
+
+    return status;
+}
+
+/* Copies the scanlines of a playfield that wraps around after NUM_OF_WRAP_ROWS rows, starting at row WRAP_Y, into separately stored bitplanes */
+static void copyWrappedBitplanes(const amiVideo_UByte *playfield, amiVideo_UByte *bitplanes)
+{
+    unsigned int i, y;
+
+    for(i = 0; i < BITPLANE_DEPTH; i++)
+    {
+        for(y = 0; y < HEIGHT; y++)
+            memcpy(bitplanes + (i * HEIGHT + y) * PITCH, playfield + (i * NUM_OF_WRAP_ROWS + (WRAP_Y + y) % NUM_OF_WRAP_ROWS) * PITCH, PITCH);
+    }
+}
+
+/* A delta of a playfield that wraps around modifies the rows that the scanlines are read from */
+static int checkWrappedDelta(void)
+{
+    amiVideo_UByte delta[MAX_DELTA_SIZE];
+    amiVideo_UByte *playfield = (amiVideo_UByte*)malloc(WRAP_PLAYFIELD_SIZE); /* On the heap, so that writes beyond the playfield are detected */
+    amiVideo_UByte expectedPlayfield[WRAP_PLAYFIELD_SIZE];
+    amiVideo_UByte from[BITPLANES_SIZE], to[BITPLANES_SIZE], expected[BITPLANES_SIZE];
+    amiVideo_ULong pixels[WIDTH * HEIGHT * LOWRES_PIXEL_SCALE_FACTOR * LOWRES_PIXEL_SCALE_FACTOR];
+    amiVideo_Playfield view;
+    amiVideo_Screen screen;
+    unsigned int deltaSize, i;
+    int status = 0;
+
+    for(i = 0; i < WRAP_PLAYFIELD_SIZE; i++)
+        playfield[i] = rand();
+
+    /* Modify the first and last scanline, which are read from rows 6 and 5 of the playfield */
+    memcpy(expectedPlayfield, playfield, WRAP_PLAYFIELD_SIZE);
+    copyWrappedBitplanes(playfield, from);
+    memcpy(to, from, BITPLANES_SIZE);
+
+    for(i = 0; i < BITPLANE_DEPTH; i++)
+    {
+        to[i * HEIGHT * PITCH + 1] ^= 0xff;
+        to[((i + 1) * HEIGHT - 1) * PITCH + 3] ^= 0xff;
+        expectedPlayfield[(i * NUM_OF_WRAP_ROWS + WRAP_Y) * PITCH + 1] ^= 0xff;
+        expectedPlayfield[(i * NUM_OF_WRAP_ROWS + (WRAP_Y + HEIGHT - 1) % NUM_OF_WRAP_ROWS) * PITCH + 3] ^= 0xff;
+    }
+
+    deltaSize = encodeDelta(from, to, AMIVIDEO_ANIM_OPERATION_BYTE_VERTICAL_DELTA, 0, delta);
+
+    view.bitplanes = playfield;
+    view.planeOffset = PITCH * NUM_OF_WRAP_ROWS;
+    view.rowStride = PITCH;
+    view.numOfRows = NUM_OF_WRAP_ROWS;
+    view.x = 0;
+    view.y = WRAP_Y;
+
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, BITPLANE_DEPTH, 8, 0);
+    amiVideo_setLowresPixelScaleFactor(&screen, LOWRES_PIXEL_SCALE_FACTOR);
+    amiVideo_setBitplanePaletteColors(&screen.palette, colors, 16);
+    amiVideo_setScreenPlayfield(&screen, &view);
+    amiVideo_setScreenCorrectedPixelsPointer(&screen, pixels, screen.correctedFormat.width * 4, 4, 0, 16, 8, 0, 24);
+    amiVideo_setScreenDeltaConversion(&screen, 1);
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixels(&screen);
+
+    if(!amiVideo_applyScreenDelta(&screen, AMIVIDEO_ANIM_OPERATION_BYTE_VERTICAL_DELTA, 0, delta, deltaSize) || memcmp(playfield, expectedPlayfield, WRAP_PLAYFIELD_SIZE) != 0)
+    {
+        fprintf(stderr, "A delta must modify the rows of a playfield that wraps around!\n");
+        status = 1;
+    }
+
+    /* The scanlines that wrap around to the modified rows show the modifications as well */
+    if(screen.deltaFormat.numOfDirtyRows != 3 || screen.deltaFormat.dirtyRows[0].firstRow != 0 || screen.deltaFormat.dirtyRows[0].lastRow != 1
+        || screen.deltaFormat.dirtyRows[1].firstRow != 7 || screen.deltaFormat.dirtyRows[1].lastRow != 9
+        || screen.deltaFormat.dirtyRows[2].firstRow != 15 || screen.deltaFormat.dirtyRows[2].lastRow != 16)
+    {
+        fprintf(stderr, "The modified scanlines of a playfield that wraps around are incorrect!\n");
+        status = 1;
+    }
+
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixels(&screen);
+    copyWrappedBitplanes(expectedPlayfield, expected);
+    status |= checkConvertedFrame(pixels, expected, "The delta of a playfield that wraps around is not converted correctly!");
+
+    amiVideo_cleanupScreen(&screen);
+    free(playfield);
+
+    return status;
+}
+
+int main(int argc, char *argv[])
+{
+    static const unsigned int operations[] = {
+        AMIVIDEO_ANIM_OPERATION_BYTE_VERTICAL_DELTA,
+        AMIVIDEO_ANIM_OPERATION_BYTE_VERTICAL_DELTA,
+        AMIVIDEO_ANIM_OPERATION_SHORT_LONG_VERTICAL_DELTA,
+        AMIVIDEO_ANIM_OPERATION_SHORT_LONG_VERTICAL_DELTA,
+        AMIVIDEO_ANIM_OPERATION_SHORT_LONG_VERTICAL_DELTA_INLINE,
+        AMIVIDEO_ANIM_OPERATION_SHORT_LONG_VERTICAL_DELTA_INLINE
+    };
+    static const amiVideo_ULong bits[] = {
+        0,
+        AMIVIDEO_ANIM_BITS_XOR,
+        0,
+        AMIVIDEO_ANIM_BITS_LONG_DATA,
+        0,
+        AMIVIDEO_ANIM_BITS_LONG_DATA
+    };
+    amiVideo_UByte from[BITPLANES_SIZE];
+    amiVideo_UByte to[BITPLANES_SIZE];
+    unsigned int i, j;
+    int status = 0;
+
+    srand(1);
+
+    for(i = 0; i < BITPLANES_SIZE; i++)
+        from[i] = rand();
+
+    for(i = 0; i < 16; i++)
+    {
+        colors[i].r = rand();
+        colors[i].g = rand();
+        colors[i].b = rand();
+    }
+
+    /* Modify scanlines 5-11, including a repeated value and the last word of a scanline */
+    memcpy(to, from, BITPLANES_SIZE);
+
+    for(i = 5; i < 11; i++)
+    {
+        for(j = 0; j < BITPLANE_DEPTH; j++)
+        {
+            to[(j * HEIGHT + i) * PITCH + 1] = rand();
+            to[(j * HEIGHT + i) * PITCH + 5] = rand();
+        }
+    }
+
+    for(i = 6; i < 10; i++)
+    {
+        memset(from + (2 * HEIGHT + i) * PITCH, 0x11, PITCH);
+        memset(to + (2 * HEIGHT + i) * PITCH, 0x22, 4);
+    }
+
+    for(i = 0; i < sizeof(operations) / sizeof(unsigned int); i++)
+    {
+        if(checkDelta(from, to, operations[i], bits[i], 5, 11) != 0)
+            status = 1;
+    }
+
+    if(checkOutdatedTargets(from, to) != 0 || checkDeltaColumns(from) != 0 || checkCorruptDelta(from, to) != 0 || checkWrappedDelta() != 0)
+        status = 1;
+
+    return status;
+}
@@ -0,0 +1,318 @@
+#if defined(HAVE_CLOCK_GETTIME)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include <screen.h>
+#include <byterun1.h>
+#include <cpufeatures.h>
+#include <viewportmode.h>
+
+#define DEFAULT_NUM_OF_THREADS 4
+#define DEFAULT_MIN_TIME 0.1
+
+/* Synthetic screen that is converted with every conversion path */
+typedef struct
+{
+    const char *name;
+    amiVideo_Word width;
+    amiVideo_Word height;
+    unsigned int bitplaneDepth;
+    amiVideo_Long viewportMode;
+    unsigned int lowresPixelScaleFactor;
+}
+Configuration;
+
+static const Configuration configurations[] =
+{
+    { "lowres-1", 320, 256, 1, 0, 2 },
+    { "lowres-2", 320, 256, 2, 0, 2 },
+    { "lowres-3", 320, 256, 3, 0, 2 },
+    { "lowres-4", 320, 256, 4, 0, 2 },
+    { "lowres-5", 320, 256, 5, 0, 2 },
+    { "lowres-6", 320, 256, 6, 0, 2 },
+    { "lowres-7", 320, 256, 7, 0, 2 },
+    { "lowres-8", 320, 256, 8, 0, 2 },
+    { "lowres-ehb", 320, 256, 6, AMIVIDEO_VIDEOPORTMODE_EHB, 2 },
+    { "lowres-ham6", 320, 256, 6, AMIVIDEO_VIDEOPORTMODE_HAM, 2 },
+    { "lowres-ham8", 320, 256, 8, AMIVIDEO_VIDEOPORTMODE_HAM, 2 },
+    { "lowres-laced-5", 320, 512, 5, AMIVIDEO_VIDEOPORTMODE_LACE, 2 },
+    { "hires-4", 640, 256, 4, AMIVIDEO_VIDEOPORTMODE_HIRES, 2 },
+    { "hires-laced-4", 640, 512, 4, AMIVIDEO_VIDEOPORTMODE_HIRES | AMIVIDEO_VIDEOPORTMODE_LACE, 2 },
+    { "hires-laced-8", 640, 512, 8, AMIVIDEO_VIDEOPORTMODE_HIRES | AMIVIDEO_VIDEOPORTMODE_LACE, 2 },
+    { "hires-laced-ham8", 640, 512, 8, AMIVIDEO_VIDEOPORTMODE_HAM | AMIVIDEO_VIDEOPORTMODE_HIRES | AMIVIDEO_VIDEOPORTMODE_LACE, 2 },
+    { "superhires-2", 1280, 256, 2, AMIVIDEO_VIDEOPORTMODE_SUPERHIRES, 4 },
+    { "superhires-laced-4", 1280, 512, 4, AMIVIDEO_VIDEOPORTMODE_SUPERHIRES | AMIVIDEO_VIDEOPORTMODE_LACE, 4 },
+    { "truecolor-24", 320, 256, 24, 0, 2 },
+    { "truecolor-32", 320, 256, 32, 0, 2 }
+};
+
+#define NUM_OF_CONFIGURATIONS (sizeof(configurations) / sizeof(Configuration))
+
+static amiVideo_UByte *body;
+
+static void convertScreenChunkyPixelsToBody(amiVideo_Screen *screen)
+{
+    amiVideo_convertScreenChunkyPixelsToBody(screen, body, AMIVIDEO_COMPRESSION_BYTERUN1, 1);
+}
+
+#define THUMBNAIL_WIDTH 160
+#define THUMBNAIL_HEIGHT 128
+
+static amiVideo_ULong thumbnail[THUMBNAIL_WIDTH * THUMBNAIL_HEIGHT];
+
+static void convertScreenBitplanesToSampledThumbnail(amiVideo_Screen *screen)
+{
+    amiVideo_convertScreenBitplanesToThumbnail(screen, thumbnail, THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT, THUMBNAIL_WIDTH * 4, AMIVIDEO_THUMBNAIL_SAMPLE, 16, 8, 0, 24);
+}
+
+static void convertScreenBitplanesToBoxFilteredThumbnail(amiVideo_Screen *screen)
+{
+    amiVideo_convertScreenBitplanesToThumbnail(screen, thumbnail, THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT, THUMBNAIL_WIDTH * 4, AMIVIDEO_THUMBNAIL_BOX, 16, 8, 0, 24);
+}
+
+/* Conversion path of the library */
+typedef struct
+{
+    const char *name;
+
+    /** Indicates whether the path can convert true color screens */
+    int trueColor;
+
+    void (*convert)(amiVideo_Screen *screen);
+
+    /** Parallel variant of the conversion or NULL if there is none */
+    void (*convertParallel)(amiVideo_Screen *screen, unsigned int numOfThreads, amiVideo_Executor executor, void *executorData);
+}
+Path;
+
+static const Path paths[] =
+{
+    { "bitplanes-to-chunky", 0, amiVideo_convertScreenBitplanesToChunkyPixels, amiVideo_convertScreenBitplanesToChunkyPixelsParallel },
+    { "chunky-to-rgb", 0, amiVideo_convertScreenChunkyPixelsToRGBPixels, amiVideo_convertScreenChunkyPixelsToRGBPixelsParallel },
+    { "chunky-to-bitplanes", 0, amiVideo_convertScreenChunkyPixelsToBitplanes, amiVideo_convertScreenChunkyPixelsToBitplanesParallel },
+    { "chunky-to-body", 0, convertScreenChunkyPixelsToBody, NULL },
+    { "bitplanes-to-rgb", 1, amiVideo_convertScreenBitplanesToRGBPixels, amiVideo_convertScreenBitplanesToRGBPixelsParallel },
+    { "bitplanes-to-corrected-chunky", 0, amiVideo_convertScreenBitplanesToCorrectedChunkyPixels, amiVideo_convertScreenBitplanesToCorrectedChunkyPixelsParallel },
+    { "bitplanes-to-corrected-rgb", 1, amiVideo_convertScreenBitplanesToCorrectedRGBPixels, amiVideo_convertScreenBitplanesToCorrectedRGBPixelsParallel },
+    { "chunky-to-corrected-rgb", 0, amiVideo_convertScreenChunkyPixelsToCorrectedRGBPixels, amiVideo_convertScreenChunkyPixelsToCorrectedRGBPixelsParallel },
+    { "correct-rgb", 1, amiVideo_correctScreenPixels, amiVideo_correctScreenPixelsParallel },
+    { "bitplanes-to-sampled-thumbnail", 1, convertScreenBitplanesToSampledThumbnail, NULL },
+    { "bitplanes-to-box-thumbnail", 1, convertScreenBitplanesToBoxFilteredThumbnail, NULL }
+};
+
+#define NUM_OF_PATHS (sizeof(paths) / sizeof(Path))
+
+/* Returns a wall clock time stamp in seconds */
+static double getTime(void)
+{
+#if defined(HAVE_CLOCK_GETTIME)
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+/* Converts the screen until at least minTime seconds have elapsed and returns the amount of seconds per frame */
+static double measurePath(const Path *path, amiVideo_Screen *screen, unsigned int numOfThreads, double minTime, unsigned long *numOfFrames)
+{
+    unsigned long count = 1;
+    double elapsed;
+
+    /* Run the conversion once, so that the kernels are selected and the memory is paged in */
+    if(numOfThreads == 0)
+        path->convert(screen);
+    else
+        path->convertParallel(screen, numOfThreads, NULL, NULL);
+
+    do
+    {
+        double start = getTime();
+        unsigned long i;
+
+        for(i = 0; i < count; i++)
+        {
+            if(numOfThreads == 0)
+                path->convert(screen);
+            else
+                path->convertParallel(screen, numOfThreads, NULL, NULL);
+        }
+
+        elapsed = getTime() - start;
+        *numOfFrames = count;
+        count *= 2;
+    }
+    while(elapsed < minTime);
+
+    return elapsed / *numOfFrames;
+}
+
+static int checkFilter(const char *filter, const Configuration *configuration, const Path *path)
+{
+    return filter == NULL || strstr(configuration->name, filter) != NULL || strstr(path->name, filter) != NULL;
+}
+
+static void printUsage(const char *command)
+{
+    fprintf(stderr, "Usage: %s [-t threads] [-m seconds] [-f filter] [-o file.csv]\n\n", command);
+    fprintf(stderr, "  -t  Amount of threads of the parallel conversions, 0 skips them (default: %d)\n", DEFAULT_NUM_OF_THREADS);
+    fprintf(stderr, "  -m  Minimum amount of seconds that each path is measured (default: %g)\n", DEFAULT_MIN_TIME);
+    fprintf(stderr, "  -f  Only measure the screens and paths whose name contains the filter\n");
+    fprintf(stderr, "  -o  Also write the results as comma separated values to a file\n");
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int numOfThreads = DEFAULT_NUM_OF_THREADS;
+    double minTime = DEFAULT_MIN_TIME;
+    const char *filter = NULL;
+    const char *outputFile = NULL;
+    FILE *output = NULL;
+    amiVideo_ULong features;
+    amiVideo_Color colors[256];
+    unsigned int i;
+
+    for(i = 1; i < (unsigned int)argc; i++)
+    {
+        if(strcmp(argv[i], "-t") == 0 && i + 1 < (unsigned int)argc)
+            numOfThreads = atoi(argv[++i]);
+        else if(strcmp(argv[i], "-m") == 0 && i + 1 < (unsigned int)argc)
+            minTime = atof(argv[++i]);
+        else if(strcmp(argv[i], "-f") == 0 && i + 1 < (unsigned int)argc)
+            filter = argv[++i];
+        else if(strcmp(argv[i], "-o") == 0 && i + 1 < (unsigned int)argc)
+            outputFile = argv[++i];
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if(outputFile != NULL)
+    {
+        output = fopen(outputFile, "w");
+
+        if(output == NULL)
+        {
+            fprintf(stderr, "Cannot open output file: %s\n", outputFile);
+            return 1;
+        }
+
+        fprintf(output, "screen,width,height,depth,viewport_mode,path,threads,frames,ns_per_frame,mpix_per_s\n");
+    }
+
+    /* Report the kernels that may be selected */
+    features = amiVideo_getCPUFeatures();
+    printf("CPU features:%s%s%s%s%s\n\n",
+        features & AMIVIDEO_CPU_SSE2 ? " SSE2" : "",
+        features & AMIVIDEO_CPU_SSSE3 ? " SSSE3" : "",
+        features & AMIVIDEO_CPU_AVX2 ? " AVX2" : "",
+        features & AMIVIDEO_CPU_NEON ? " NEON" : "",
+        features == 0 ? " none" : "");
+    printf("%-20s %-30s %7s %12s %10s\n", "Screen", "Path", "Threads", "ns/frame", "MPix/s");
+
+    srand(1);
+
+    for(i = 0; i < 256; i++)
+    {
+        colors[i].r = rand();
+        colors[i].g = rand();
+        colors[i].b = rand();
+    }
+
+    for(i = 0; i < NUM_OF_CONFIGURATIONS; i++)
+    {
+        const Configuration *configuration = &configurations[i];
+        int trueColor = configuration->bitplaneDepth == 24 || configuration->bitplaneDepth == 32;
+        amiVideo_Screen screen;
+        amiVideo_UByte *bitplanes;
+        amiVideo_UByte *chunkyPixels;
+        amiVideo_ULong *rgbPixels;
+        amiVideo_ULong *correctedPixels;
+        unsigned int bitplanesSize;
+        unsigned int j;
+
+        amiVideo_initScreen(&screen, configuration->width, configuration->height, configuration->bitplaneDepth, 8, configuration->viewportMode);
+        amiVideo_setLowresPixelScaleFactor(&screen, configuration->lowresPixelScaleFactor);
+
+        /* Generate a screen with random contents */
+        bitplanesSize = screen.bitplaneFormat.pitch * screen.height * screen.bitplaneDepth;
+        bitplanes = (amiVideo_UByte*)malloc(bitplanesSize);
+        chunkyPixels = (amiVideo_UByte*)malloc(screen.width * screen.height);
+        rgbPixels = (amiVideo_ULong*)malloc(screen.width * screen.height * sizeof(amiVideo_ULong));
+        correctedPixels = (amiVideo_ULong*)malloc(screen.correctedFormat.width * screen.correctedFormat.height * sizeof(amiVideo_ULong));
+        body = (amiVideo_UByte*)malloc(trueColor ? 1 : amiVideo_getScreenBodyBound(&screen, AMIVIDEO_COMPRESSION_BYTERUN1));
+
+        if(bitplanes == NULL || chunkyPixels == NULL || rgbPixels == NULL || correctedPixels == NULL || body == NULL)
+        {
+            fprintf(stderr, "Cannot allocate the surfaces of screen: %s\n", configuration->name);
+            return 1;
+        }
+
+        for(j = 0; j < bitplanesSize; j++)
+            bitplanes[j] = rand();
+
+        if(!trueColor)
+            amiVideo_setBitplanePaletteColors(&screen.palette, colors, screen.palette.bitplaneFormat.numOfColors);
+
+        amiVideo_setScreenBitplanes(&screen, bitplanes);
+        amiVideo_setScreenCorrectedPixelsPointer(&screen, correctedPixels, screen.correctedFormat.width * 4, 4, 0, 16, 8, 0, 24);
+        amiVideo_setScreenUncorrectedChunkyPixelsPointer(&screen, chunkyPixels, screen.width);
+        amiVideo_setScreenUncorrectedRGBPixelsPointer(&screen, rgbPixels, screen.width * 4, 0, 16, 8, 0, 24);
+
+        /* The paths that start from chunky or RGB pixels need the output of the other paths */
+        if(!trueColor)
+            amiVideo_convertScreenBitplanesToChunkyPixels(&screen);
+
+        amiVideo_convertScreenBitplanesToRGBPixels(&screen);
+
+        for(j = 0; j < NUM_OF_PATHS; j++)
+        {
+            const Path *path = &paths[j];
+            unsigned int k;
+
+            if((trueColor && !path->trueColor) || !checkFilter(filter, configuration, path))
+                continue;
+
+            /* Measure the sequential conversion and the parallel variant */
+            for(k = 0; k < 2; k++)
+            {
+                unsigned int threads = k == 0 ? 0 : numOfThreads;
+                unsigned long numOfFrames;
+                double seconds;
+                double mpix;
+
+                if(k == 1 && (threads == 0 || path->convertParallel == NULL))
+                    continue;
+
+                seconds = measurePath(path, &screen, threads, minTime, &numOfFrames);
+                mpix = screen.width * screen.height / seconds / 1e6;
+
+                printf("%-20s %-30s %7u %12.0f %10.1f\n", configuration->name, path->name, threads > 0 ? threads : 1, seconds * 1e9, mpix);
+                fflush(stdout);
+
+                if(output != NULL)
+                    fprintf(output, "%s,%d,%d,%u,0x%lx,%s,%u,%lu,%.0f,%.2f\n", configuration->name, screen.width, screen.height, screen.bitplaneDepth, (unsigned long)screen.viewportMode, path->name, threads > 0 ? threads : 1, numOfFrames, seconds * 1e9, mpix);
+            }
+        }
+
+        amiVideo_cleanupScreen(&screen);
+        free(bitplanes);
+        free(chunkyPixels);
+        free(rgbPixels);
+        free(correctedPixels);
+        free(body);
+    }
+
+    if(output != NULL)
+        fclose(output);
+
+    return 0;
+}
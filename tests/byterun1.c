@@ -0,0 +1,269 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <screen.h>
+#include <byterun1.h>
+
+#define WIDTH 40
+#define HEIGHT 10
+#define BITPLANE_DEPTH 5
+#define PITCH 6
+#define NUM_OF_COLORS 32
+#define BODY_PLANES (BITPLANE_DEPTH + 1)
+
+typedef struct
+{
+    amiVideo_UByte *pixels;
+    unsigned int numOfRows;
+}
+Frame;
+
+static void storeScanLine(const void *pixels, unsigned int row, void *data)
+{
+    Frame *frame = (Frame*)data;
+
+    memcpy(frame->pixels + row * WIDTH, pixels, WIDTH);
+    frame->numOfRows++;
+}
+
+/* Straight forward encoder that replicates runs of at least 3 bytes and stores everything else literally */
+static unsigned int packRow(const amiVideo_UByte *row, unsigned int size, amiVideo_UByte *target)
+{
+    unsigned int pos = 0;
+    unsigned int targetPos = 0;
+
+    /* Start with a no-op, which decoders must skip */
+    target[targetPos++] = 0x80;
+
+    while(pos < size)
+    {
+        unsigned int run = 1;
+
+        while(pos + run < size && run < 128 && row[pos + run] == row[pos])
+            run++;
+
+        if(run >= 3)
+        {
+            target[targetPos++] = (amiVideo_UByte)(1 - (int)run);
+            target[targetPos++] = row[pos];
+            pos += run;
+        }
+        else
+        {
+            unsigned int count = 0;
+
+            while(pos + count < size && count < 128 && !(pos + count + 2 < size && row[pos + count] == row[pos + count + 1] && row[pos + count] == row[pos + count + 2]))
+                count++;
+
+            target[targetPos++] = (amiVideo_UByte)(count - 1);
+            memcpy(target + targetPos, row + pos, count);
+            targetPos += count;
+            pos += count;
+        }
+    }
+
+    return targetPos;
+}
+
+static int decodeBody(amiVideo_Screen *screen, const amiVideo_UByte *body, amiVideo_ULong bodySize, unsigned int masking, unsigned int compression, amiVideo_UByte *pixels, unsigned int *numOfRows)
+{
+    amiVideo_ScanLineStream stream;
+    Frame frame;
+    int status;
+
+    frame.pixels = pixels;
+    frame.numOfRows = 0;
+
+    if(!amiVideo_initScanLineStream(&stream, screen, AMIVIDEO_PIXEL_FORMAT_CHUNKY8, 0, storeScanLine, &frame))
+    {
+        fprintf(stderr, "Cannot initialize the scanline stream!\n");
+        return 0;
+    }
+
+    status = amiVideo_feedBodyToScanLineStream(&stream, body, bodySize, masking, compression);
+    amiVideo_cleanupScanLineStream(&stream);
+
+    *numOfRows = frame.numOfRows;
+    return status;
+}
+
+static int checkPacking(const amiVideo_UByte *data, amiVideo_ULong size)
+{
+    amiVideo_UByte packed[1024];
+    amiVideo_UByte unpacked[512];
+    amiVideo_ULong packedSize = amiVideo_packByteRun1(data, size, packed);
+
+    if(packedSize > amiVideo_getByteRun1Bound(size))
+    {
+        fprintf(stderr, "The packed data exceeds the worst-case bound!\n");
+        return 1;
+    }
+
+    if(amiVideo_unpackByteRun1(packed, packedSize, unpacked, size) != packedSize || memcmp(unpacked, data, size) != 0)
+    {
+        fprintf(stderr, "The packed data cannot be unpacked to the original data!\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+static int checkBody(amiVideo_Screen *screen, const amiVideo_UByte *expectedBody, unsigned int compression, int interleaved)
+{
+    amiVideo_UByte body[2 * PITCH * HEIGHT * BITPLANE_DEPTH];
+    amiVideo_UByte unpackedBody[PITCH * HEIGHT * BITPLANE_DEPTH];
+    amiVideo_ULong bodySize = amiVideo_convertScreenChunkyPixelsToBody(screen, body, compression, interleaved);
+
+    if(bodySize == 0 || bodySize > amiVideo_getScreenBodyBound(screen, compression))
+    {
+        fprintf(stderr, "The size of the body is incorrect!\n");
+        return 1;
+    }
+
+    if(compression == AMIVIDEO_COMPRESSION_NONE)
+        memcpy(unpackedBody, body, sizeof(unpackedBody));
+    else if(amiVideo_unpackByteRun1(body, bodySize, unpackedBody, sizeof(unpackedBody)) != bodySize)
+    {
+        fprintf(stderr, "The packed body cannot be unpacked!\n");
+        return 1;
+    }
+
+    if(memcmp(unpackedBody, expectedBody, sizeof(unpackedBody)) != 0)
+    {
+        fprintf(stderr, "The body with compression: %u and interleaved: %d is incorrect!\n", compression, interleaved);
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    amiVideo_UByte bitplanes[PITCH * HEIGHT * BITPLANE_DEPTH];
+    amiVideo_UByte body[PITCH * HEIGHT * BODY_PLANES];
+    amiVideo_UByte packedBody[2 * PITCH * HEIGHT * BODY_PLANES];
+    amiVideo_UByte expectedPixels[WIDTH * HEIGHT];
+    amiVideo_UByte pixels[WIDTH * HEIGHT];
+    amiVideo_UByte interleavedBody[PITCH * HEIGHT * BITPLANE_DEPTH];
+    amiVideo_UByte convertedBitplanes[PITCH * HEIGHT * BITPLANE_DEPTH];
+    amiVideo_UByte data[300];
+    amiVideo_UByte overflow[] = { 0xfb, 0x00 };
+    amiVideo_Color colors[NUM_OF_COLORS];
+    amiVideo_Screen screen;
+    unsigned int i, j, packedBodySize = 0, numOfRows;
+    int status = 0;
+
+    srand(1);
+
+    /* Generate bitplanes that contain both runs and noise */
+    for(i = 0; i < PITCH * HEIGHT * BITPLANE_DEPTH; i++)
+        bitplanes[i] = (rand() % 3 == 0) ? rand() : (i / 4) % 2 * 0xff;
+
+    for(i = 0; i < NUM_OF_COLORS; i++)
+    {
+        colors[i].r = rand();
+        colors[i].g = rand();
+        colors[i].b = rand();
+    }
+
+    /* Compose a body having a mask row after the bitplane rows of each scanline */
+    for(i = 0; i < HEIGHT; i++)
+    {
+        for(j = 0; j < BITPLANE_DEPTH; j++)
+            memcpy(body + (i * BODY_PLANES + j) * PITCH, bitplanes + (j * HEIGHT + i) * PITCH, PITCH);
+
+        memset(body + (i * BODY_PLANES + BITPLANE_DEPTH) * PITCH, 0xff, PITCH);
+    }
+
+    for(i = 0; i < HEIGHT * BODY_PLANES; i++)
+        packedBodySize += packRow(body + i * PITCH, PITCH, packedBody + packedBodySize);
+
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, BITPLANE_DEPTH, 8, 0);
+    amiVideo_setBitplanePaletteColors(&screen.palette, colors, NUM_OF_COLORS);
+    amiVideo_setScreenBitplanes(&screen, bitplanes);
+    amiVideo_setScreenUncorrectedChunkyPixelsPointer(&screen, expectedPixels, WIDTH);
+    amiVideo_convertScreenBitplanesToChunkyPixels(&screen);
+
+    /* Check the decompressed body */
+    memset(pixels, 0, sizeof(pixels));
+
+    if(!decodeBody(&screen, packedBody, packedBodySize, AMIVIDEO_MASKING_HAS_MASK, AMIVIDEO_COMPRESSION_BYTERUN1, pixels, &numOfRows)
+      || numOfRows != HEIGHT || memcmp(pixels, expectedPixels, sizeof(pixels)) != 0)
+    {
+        fprintf(stderr, "The pixels of the compressed body are incorrect!\n");
+        status = 1;
+    }
+
+    /* Check the uncompressed body */
+    memset(pixels, 0, sizeof(pixels));
+
+    if(!decodeBody(&screen, body, sizeof(body), AMIVIDEO_MASKING_HAS_MASK, AMIVIDEO_COMPRESSION_NONE, pixels, &numOfRows)
+      || numOfRows != HEIGHT || memcmp(pixels, expectedPixels, sizeof(pixels)) != 0)
+    {
+        fprintf(stderr, "The pixels of the uncompressed body are incorrect!\n");
+        status = 1;
+    }
+
+    /* Truncated bodies must be rejected */
+    if(decodeBody(&screen, packedBody, packedBodySize - 1, AMIVIDEO_MASKING_HAS_MASK, AMIVIDEO_COMPRESSION_BYTERUN1, pixels, &numOfRows)
+      || numOfRows != HEIGHT - 1)
+    {
+        fprintf(stderr, "A truncated compressed body should be rejected after the last complete scanline!\n");
+        status = 1;
+    }
+
+    if(decodeBody(&screen, body, sizeof(body) - 1, AMIVIDEO_MASKING_HAS_MASK, AMIVIDEO_COMPRESSION_NONE, pixels, &numOfRows))
+    {
+        fprintf(stderr, "A truncated uncompressed body should be rejected!\n");
+        status = 1;
+    }
+
+    /* Runs that exceed the target buffer must be rejected */
+    if(amiVideo_unpackByteRun1(overflow, sizeof(overflow), pixels, 5) != 0
+      || amiVideo_unpackByteRun1(overflow, sizeof(overflow), pixels, 6) != 2)
+    {
+        fprintf(stderr, "The bounds of the runs are not checked correctly!\n");
+        status = 1;
+    }
+
+    /* Check whether the packer round trips runs crossing the maximum run length and data without runs */
+    memset(data, 0x55, sizeof(data));
+
+    if(checkPacking(data, sizeof(data)) != 0 || checkPacking(data, 130) != 0 || checkPacking(data, 1) != 0)
+        status = 1;
+
+    for(i = 0; i < sizeof(data); i++)
+        data[i] = (i % 7 < 2) ? 0 : i;
+
+    if(checkPacking(data, sizeof(data)) != 0)
+        status = 1;
+
+    for(i = 0; i < sizeof(data); i++)
+        data[i] = i;
+
+    if(checkPacking(data, sizeof(data)) != 0 || amiVideo_packByteRun1(data, sizeof(data), packedBody) != amiVideo_getByteRun1Bound(sizeof(data)))
+        status = 1;
+
+    /* Check the bodies produced from the chunky pixels against the planar conversion */
+    amiVideo_cleanupScreen(&screen);
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, BITPLANE_DEPTH, 8, 0);
+    amiVideo_setScreenUncorrectedChunkyPixelsPointer(&screen, expectedPixels, WIDTH);
+    amiVideo_setScreenBitplanes(&screen, convertedBitplanes);
+    amiVideo_convertScreenChunkyPixelsToBitplanes(&screen);
+
+    for(i = 0; i < HEIGHT; i++)
+    {
+        for(j = 0; j < BITPLANE_DEPTH; j++)
+            memcpy(interleavedBody + (i * BITPLANE_DEPTH + j) * PITCH, convertedBitplanes + (j * HEIGHT + i) * PITCH, PITCH);
+    }
+
+    if(checkBody(&screen, interleavedBody, AMIVIDEO_COMPRESSION_BYTERUN1, 1) != 0
+      || checkBody(&screen, convertedBitplanes, AMIVIDEO_COMPRESSION_BYTERUN1, 0) != 0
+      || checkBody(&screen, interleavedBody, AMIVIDEO_COMPRESSION_NONE, 1) != 0
+      || checkBody(&screen, convertedBitplanes, AMIVIDEO_COMPRESSION_NONE, 0) != 0)
+        status = 1;
+
+    amiVideo_cleanupScreen(&screen);
+
+    return status;
+}
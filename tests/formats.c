@@ -0,0 +1,241 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <screen.h>
+#include <viewportmode.h>
+
+#define WIDTH 37
+#define HEIGHT 6
+#define PITCH 6
+#define MAX_SCALE_FACTOR 4
+
+static amiVideo_Color colors[256];
+
+static void initScreen(amiVideo_Screen *screen, amiVideo_UByte *bitplanes, unsigned int bitplaneDepth, amiVideo_Long viewportMode, unsigned int lowresPixelScaleFactor)
+{
+    amiVideo_initScreen(screen, WIDTH, HEIGHT, bitplaneDepth, 8, viewportMode);
+    amiVideo_setLowresPixelScaleFactor(screen, lowresPixelScaleFactor);
+    amiVideo_setBitplanePaletteColors(&screen->palette, colors, screen->palette.bitplaneFormat.numOfColors);
+    amiVideo_setScreenBitplanes(screen, bitplanes);
+}
+
+static unsigned int getExpectedPixel(amiVideo_PixelFormat pixelFormat, amiVideo_ULong pixel, amiVideo_UByte *bytes)
+{
+    switch(pixelFormat)
+    {
+        case AMIVIDEO_PIXEL_FORMAT_RGB565:
+        {
+            amiVideo_UWord word = (amiVideo_UWord)((((pixel >> 16) & 0xf8) << 8) | (((pixel >> 8) & 0xfc) << 3) | ((pixel & 0xf8) >> 3));
+            memcpy(bytes, &word, 2);
+            return 2;
+        }
+        case AMIVIDEO_PIXEL_FORMAT_XRGB1555:
+        {
+            amiVideo_UWord word = (amiVideo_UWord)((((pixel >> 16) & 0xf8) << 7) | (((pixel >> 8) & 0xf8) << 2) | ((pixel & 0xf8) >> 3));
+            memcpy(bytes, &word, 2);
+            return 2;
+        }
+        default:
+            bytes[0] = (amiVideo_UByte)(pixel >> 16);
+            bytes[1] = (amiVideo_UByte)(pixel >> 8);
+            bytes[2] = (amiVideo_UByte)pixel;
+            return 3;
+    }
+}
+
+/* Checks whether the pixels of a compact RGB surface correspond to the pixels of a 32-bit surface */
+static int checkRGBPixels(const amiVideo_ULong *expectedPixels, unsigned int width, unsigned int height, amiVideo_PixelFormat pixelFormat, const amiVideo_UByte *pixels, unsigned int pitch)
+{
+    unsigned int i;
+
+    for(i = 0; i < height; i++)
+    {
+        const amiVideo_UByte *pixel = pixels + i * pitch;
+        unsigned int j;
+
+        for(j = 0; j < width; j++)
+        {
+            amiVideo_UByte expectedBytes[3];
+            unsigned int size = getExpectedPixel(pixelFormat, expectedPixels[i * width + j], expectedBytes);
+
+            if(memcmp(pixel, expectedBytes, size) != 0)
+            {
+                fprintf(stderr, "Pixel: %u, %u in format: %d is incorrect\n", j, i, pixelFormat);
+                return 1;
+            }
+
+            pixel += size;
+        }
+    }
+
+    return 0;
+}
+
+/* Checks whether the pixels of a 4-bit chunky surface correspond to the pixels of an 8-bit surface */
+static int checkChunky4Pixels(const amiVideo_UByte *expectedPixels, unsigned int width, unsigned int height, const amiVideo_UByte *pixels, unsigned int pitch)
+{
+    unsigned int i;
+
+    for(i = 0; i < height; i++)
+    {
+        unsigned int j;
+
+        for(j = 0; j < width; j++)
+        {
+            amiVideo_UByte byte = pixels[i * pitch + j / 2];
+            amiVideo_UByte index = (j % 2 == 0) ? byte >> 4 : byte & 0xf;
+
+            if(index != expectedPixels[i * width + j])
+            {
+                fprintf(stderr, "4-bit chunky pixel: %u, %u has index: %u, expected: %u\n", j, i, index, expectedPixels[i * width + j]);
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+static int checkRGBFormats(amiVideo_UByte *bitplanes, unsigned int bitplaneDepth, amiVideo_Long viewportMode, unsigned int lowresPixelScaleFactor)
+{
+    amiVideo_PixelFormat pixelFormats[] = { AMIVIDEO_PIXEL_FORMAT_RGB565, AMIVIDEO_PIXEL_FORMAT_XRGB1555, AMIVIDEO_PIXEL_FORMAT_RGB24 };
+    amiVideo_ULong expectedPixels[WIDTH * HEIGHT * MAX_SCALE_FACTOR * MAX_SCALE_FACTOR];
+    amiVideo_ULong expectedUncorrectedPixels[WIDTH * HEIGHT];
+    amiVideo_UByte pixels[WIDTH * HEIGHT * MAX_SCALE_FACTOR * MAX_SCALE_FACTOR * 3];
+    amiVideo_UByte uncorrectedPixels[WIDTH * HEIGHT * 3];
+    amiVideo_UByte correctedPixels[WIDTH * HEIGHT * MAX_SCALE_FACTOR * MAX_SCALE_FACTOR * 3];
+    amiVideo_Screen screen;
+    unsigned int correctedWidth, correctedHeight;
+    unsigned int i;
+    int status = 0;
+
+    /* Compose the expected pixels in 32-bit format */
+    initScreen(&screen, bitplanes, bitplaneDepth, viewportMode, lowresPixelScaleFactor);
+    correctedWidth = screen.correctedFormat.width;
+    correctedHeight = screen.correctedFormat.height;
+    amiVideo_setScreenUncorrectedRGBPixelsPointer(&screen, expectedUncorrectedPixels, WIDTH * 4, 0, 16, 8, 0, 24);
+    amiVideo_setScreenCorrectedPixelsPointer(&screen, expectedPixels, correctedWidth * 4, 4, 0, 16, 8, 0, 24);
+    amiVideo_convertScreenBitplanesToRGBPixels(&screen);
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixels(&screen);
+    amiVideo_cleanupScreen(&screen);
+
+    for(i = 0; i < sizeof(pixelFormats) / sizeof(amiVideo_PixelFormat); i++)
+    {
+        unsigned int bytesPerPixel = pixelFormats[i] == AMIVIDEO_PIXEL_FORMAT_RGB24 ? 3 : 2;
+
+        initScreen(&screen, bitplanes, bitplaneDepth, viewportMode, lowresPixelScaleFactor);
+        amiVideo_setScreenUncorrectedRGBPixelsPointer(&screen, (amiVideo_ULong*)uncorrectedPixels, WIDTH * bytesPerPixel, 0, 16, 8, 0, 24);
+        amiVideo_setScreenUncorrectedRGBPixelFormat(&screen, pixelFormats[i]);
+        amiVideo_setScreenCorrectedPixelsPointer(&screen, pixels, correctedWidth * bytesPerPixel, bytesPerPixel, 0, 16, 8, 0, 24);
+        amiVideo_setScreenCorrectedPixelFormat(&screen, pixelFormats[i]);
+
+        /* Fused conversions */
+        amiVideo_convertScreenBitplanesToRGBPixels(&screen);
+        amiVideo_convertScreenBitplanesToCorrectedRGBPixels(&screen);
+
+        if(checkRGBPixels(expectedUncorrectedPixels, WIDTH, HEIGHT, pixelFormats[i], uncorrectedPixels, WIDTH * bytesPerPixel) != 0
+          || checkRGBPixels(expectedPixels, correctedWidth, correctedHeight, pixelFormats[i], pixels, correctedWidth * bytesPerPixel) != 0)
+        {
+            fprintf(stderr, "Conversion from bitplanes with depth: %u, viewport mode: %x and scale factor: %u is incorrect\n", bitplaneDepth, viewportMode, lowresPixelScaleFactor);
+            status = 1;
+        }
+
+        /* Correcting the uncorrected compact pixels must give the same result */
+        amiVideo_setScreenCorrectedPixelsPointer(&screen, correctedPixels, correctedWidth * bytesPerPixel, bytesPerPixel, 0, 16, 8, 0, 24);
+        amiVideo_setScreenCorrectedPixelFormat(&screen, pixelFormats[i]);
+        amiVideo_correctScreenPixels(&screen);
+
+        if(memcmp(pixels, correctedPixels, correctedWidth * correctedHeight * bytesPerPixel) != 0)
+        {
+            fprintf(stderr, "Correction of pixels in format: %d is incorrect\n", pixelFormats[i]);
+            status = 1;
+        }
+
+        amiVideo_cleanupScreen(&screen);
+    }
+
+    return status;
+}
+
+static int checkChunky4Format(amiVideo_UByte *bitplanes, unsigned int bitplaneDepth, amiVideo_Long viewportMode, unsigned int lowresPixelScaleFactor)
+{
+    amiVideo_UByte expectedPixels[WIDTH * HEIGHT * MAX_SCALE_FACTOR * MAX_SCALE_FACTOR];
+    amiVideo_UByte expectedUncorrectedPixels[WIDTH * HEIGHT];
+    amiVideo_UByte pixels[WIDTH * HEIGHT * MAX_SCALE_FACTOR * MAX_SCALE_FACTOR / 2 + HEIGHT * MAX_SCALE_FACTOR];
+    amiVideo_UByte uncorrectedPixels[(WIDTH + 1) / 2 * HEIGHT];
+    amiVideo_Screen screen;
+    unsigned int correctedWidth, correctedHeight, correctedPitch;
+    int status = 0;
+
+    initScreen(&screen, bitplanes, bitplaneDepth, viewportMode, lowresPixelScaleFactor);
+    correctedWidth = screen.correctedFormat.width;
+    correctedHeight = screen.correctedFormat.height;
+    correctedPitch = (correctedWidth + 1) / 2;
+    amiVideo_setScreenUncorrectedChunkyPixelsPointer(&screen, expectedUncorrectedPixels, WIDTH);
+    amiVideo_setScreenCorrectedPixelsPointer(&screen, expectedPixels, correctedWidth, 1, 0, 0, 0, 0, 0);
+    amiVideo_convertScreenBitplanesToChunkyPixels(&screen);
+    amiVideo_convertScreenBitplanesToCorrectedChunkyPixels(&screen);
+
+    /* Correct the 8-bit chunky pixels into 4-bit chunky pixels */
+    amiVideo_setScreenCorrectedPixelsPointer(&screen, pixels, correctedPitch, 1, 0, 0, 0, 0, 0);
+    amiVideo_setScreenCorrectedPixelFormat(&screen, AMIVIDEO_PIXEL_FORMAT_CHUNKY4);
+    amiVideo_correctScreenPixels(&screen);
+
+    if(checkChunky4Pixels(expectedPixels, correctedWidth, correctedHeight, pixels, correctedPitch) != 0)
+    {
+        fprintf(stderr, "Correction to 4-bit chunky pixels with scale factor: %u is incorrect\n", lowresPixelScaleFactor);
+        status = 1;
+    }
+
+    /* Fused conversions */
+    memset(pixels, '\0', sizeof(pixels));
+    amiVideo_setScreenUncorrectedChunkyPixelsPointer(&screen, uncorrectedPixels, (WIDTH + 1) / 2);
+    amiVideo_setScreenUncorrectedChunkyPixelFormat(&screen, AMIVIDEO_PIXEL_FORMAT_CHUNKY4);
+    amiVideo_convertScreenBitplanesToChunkyPixels(&screen);
+    amiVideo_convertScreenBitplanesToCorrectedChunkyPixels(&screen);
+
+    if(checkChunky4Pixels(expectedUncorrectedPixels, WIDTH, HEIGHT, uncorrectedPixels, (WIDTH + 1) / 2) != 0
+      || checkChunky4Pixels(expectedPixels, correctedWidth, correctedHeight, pixels, correctedPitch) != 0)
+    {
+        fprintf(stderr, "Conversion to 4-bit chunky pixels with scale factor: %u is incorrect\n", lowresPixelScaleFactor);
+        status = 1;
+    }
+
+    amiVideo_cleanupScreen(&screen);
+    return status;
+}
+
+int main(int argc, char *argv[])
+{
+    amiVideo_UByte *bitplanes = (amiVideo_UByte*)malloc(PITCH * HEIGHT * 8);
+    unsigned int i;
+    int status = 0;
+
+    srand(1);
+
+    for(i = 0; i < PITCH * HEIGHT * 8; i++)
+        bitplanes[i] = rand();
+
+    for(i = 0; i < 256; i++)
+    {
+        colors[i].r = rand();
+        colors[i].g = rand();
+        colors[i].b = rand();
+    }
+
+    if(checkRGBFormats(bitplanes, 5, 0, 2) != 0
+      || checkRGBFormats(bitplanes, 5, 0, 4) != 0
+      || checkRGBFormats(bitplanes, 4, AMIVIDEO_VIDEOPORTMODE_HIRES | AMIVIDEO_VIDEOPORTMODE_LACE, 2) != 0
+      || checkRGBFormats(bitplanes, 6, AMIVIDEO_VIDEOPORTMODE_HAM, 2) != 0
+      || checkRGBFormats(bitplanes, 8, AMIVIDEO_VIDEOPORTMODE_HAM | AMIVIDEO_VIDEOPORTMODE_HIRES, 2) != 0
+      || checkRGBFormats(bitplanes, 3, 0, 3) != 0)
+        status = 1;
+
+    if(checkChunky4Format(bitplanes, 4, AMIVIDEO_VIDEOPORTMODE_HIRES | AMIVIDEO_VIDEOPORTMODE_LACE, 2) != 0
+      || checkChunky4Format(bitplanes, 4, 0, 2) != 0
+      || checkChunky4Format(bitplanes, 3, 0, 3) != 0)
+        status = 1;
+
+    free(bitplanes);
+    return status;
+}
@@ -0,0 +1,115 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <screen.h>
+
+#define WIDTH 40
+#define HEIGHT 10
+#define BITPLANE_DEPTH 5
+#define PITCH 6
+#define LOWRES_PIXEL_SCALE_FACTOR 2
+
+static amiVideo_Color colors[32];
+
+static void convertFully(amiVideo_UByte *bitplanes, amiVideo_ULong *pixels)
+{
+    amiVideo_Screen screen;
+
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, BITPLANE_DEPTH, 8, 0);
+    amiVideo_setLowresPixelScaleFactor(&screen, LOWRES_PIXEL_SCALE_FACTOR);
+    amiVideo_setBitplanePaletteColors(&screen.palette, colors, 32);
+    amiVideo_setScreenBitplanes(&screen, bitplanes);
+    amiVideo_setScreenCorrectedPixelsPointer(&screen, pixels, screen.correctedFormat.width * 4, 4, 0, 16, 8, 0, 24);
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixels(&screen);
+    amiVideo_cleanupScreen(&screen);
+}
+
+static int checkConversion(amiVideo_Screen *screen, amiVideo_UByte *bitplanes, amiVideo_ULong *pixels, unsigned int firstRow, unsigned int lastRow)
+{
+    amiVideo_ULong expectedPixels[WIDTH * LOWRES_PIXEL_SCALE_FACTOR * HEIGHT * LOWRES_PIXEL_SCALE_FACTOR];
+
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixels(screen);
+    convertFully(bitplanes, expectedPixels);
+
+    if(memcmp(pixels, expectedPixels, sizeof(expectedPixels)) != 0)
+        return 1;
+
+    /* The reported range must cover exactly the scanlines of the target surface that have changed */
+    if(firstRow == lastRow)
+        return screen->incrementalFormat.numOfDirtyRows != 0;
+    else
+        return screen->incrementalFormat.numOfDirtyRows != 1 || screen->incrementalFormat.dirtyRows[0].firstRow != firstRow * LOWRES_PIXEL_SCALE_FACTOR || screen->incrementalFormat.dirtyRows[0].lastRow != lastRow * LOWRES_PIXEL_SCALE_FACTOR;
+}
+
+int main(int argc, char *argv[])
+{
+    amiVideo_UByte *bitplanes = (amiVideo_UByte*)malloc(PITCH * HEIGHT * BITPLANE_DEPTH);
+    amiVideo_ULong *pixels = (amiVideo_ULong*)calloc(WIDTH * LOWRES_PIXEL_SCALE_FACTOR * HEIGHT * LOWRES_PIXEL_SCALE_FACTOR, sizeof(amiVideo_ULong));
+    amiVideo_Screen screen;
+    unsigned int i;
+    int status = 0;
+
+    srand(1);
+
+    for(i = 0; i < PITCH * HEIGHT * BITPLANE_DEPTH; i++)
+        bitplanes[i] = rand();
+
+    for(i = 0; i < 32; i++)
+    {
+        colors[i].r = rand();
+        colors[i].g = rand();
+        colors[i].b = rand();
+    }
+
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, BITPLANE_DEPTH, 8, 0);
+    amiVideo_setLowresPixelScaleFactor(&screen, LOWRES_PIXEL_SCALE_FACTOR);
+    amiVideo_setBitplanePaletteColors(&screen.palette, colors, 32);
+    amiVideo_setScreenBitplanes(&screen, bitplanes);
+    amiVideo_setScreenCorrectedPixelsPointer(&screen, pixels, screen.correctedFormat.width * 4, 4, 0, 16, 8, 0, 24);
+
+    if(!amiVideo_setScreenIncrementalConversion(&screen, 1))
+    {
+        fprintf(stderr, "Cannot enable incremental conversion!\n");
+        return 1;
+    }
+
+    /* The first conversion converts everything */
+    if(checkConversion(&screen, bitplanes, pixels, 0, HEIGHT) != 0)
+    {
+        fprintf(stderr, "The initial conversion is incorrect!\n");
+        status = 1;
+    }
+
+    /* Without changes, nothing is converted */
+    if(checkConversion(&screen, bitplanes, pixels, 0, 0) != 0)
+    {
+        fprintf(stderr, "The conversion without changes is incorrect!\n");
+        status = 1;
+    }
+
+    /* Changing the last bitplane of two adjacent scanlines only converts those */
+    bitplanes[PITCH * HEIGHT * (BITPLANE_DEPTH - 1) + 3 * PITCH + 2] ^= 0x10;
+    bitplanes[PITCH * HEIGHT * (BITPLANE_DEPTH - 1) + 4 * PITCH + 5] ^= 0x01;
+
+    if(checkConversion(&screen, bitplanes, pixels, 3, 5) != 0)
+    {
+        fprintf(stderr, "The conversion of changed scanlines is incorrect!\n");
+        status = 1;
+    }
+
+    /* Changing the palette converts everything */
+    colors[0].r ^= 0xff;
+    amiVideo_setBitplanePaletteColors(&screen.palette, colors, 32);
+
+    if(checkConversion(&screen, bitplanes, pixels, 0, HEIGHT) != 0)
+    {
+        fprintf(stderr, "The conversion after changing the palette is incorrect!\n");
+        status = 1;
+    }
+
+    amiVideo_cleanupScreen(&screen);
+    free(pixels);
+    free(bitplanes);
+
+    return status;
+}
@@ -0,0 +1,106 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <screen.h>
+
+#define WIDTH 40
+#define HEIGHT 10
+#define BITPLANE_DEPTH 5
+#define PITCH 6
+#define LOWRES_PIXEL_SCALE_FACTOR 2
+
+static amiVideo_Color colors[32];
+
+static void initScreen(amiVideo_Screen *screen)
+{
+    amiVideo_initScreen(screen, WIDTH, HEIGHT, BITPLANE_DEPTH, 8, 0);
+    amiVideo_setLowresPixelScaleFactor(screen, LOWRES_PIXEL_SCALE_FACTOR);
+    amiVideo_setBitplanePaletteColors(&screen->palette, colors, 32);
+}
+
+static void convertScreen(amiVideo_Screen *screen, amiVideo_UByte *chunkyPixels, amiVideo_ULong *rgbPixels)
+{
+    amiVideo_setScreenUncorrectedChunkyPixelsPointer(screen, chunkyPixels, WIDTH);
+    amiVideo_setScreenCorrectedPixelsPointer(screen, rgbPixels, screen->correctedFormat.width * 4, 4, 0, 16, 8, 0, 24);
+    amiVideo_convertScreenBitplanesToChunkyPixels(screen);
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixels(screen);
+}
+
+int main(int argc, char *argv[])
+{
+    amiVideo_UByte bitplanes[PITCH * HEIGHT * BITPLANE_DEPTH];
+    amiVideo_UByte interleavedBitplanes[PITCH * HEIGHT * BITPLANE_DEPTH];
+    amiVideo_UByte expectedChunkyPixels[WIDTH * HEIGHT];
+    amiVideo_UByte chunkyPixels[WIDTH * HEIGHT];
+    amiVideo_ULong expectedRGBPixels[WIDTH * HEIGHT * LOWRES_PIXEL_SCALE_FACTOR * LOWRES_PIXEL_SCALE_FACTOR];
+    amiVideo_ULong rgbPixels[WIDTH * HEIGHT * LOWRES_PIXEL_SCALE_FACTOR * LOWRES_PIXEL_SCALE_FACTOR];
+    amiVideo_Screen screen;
+    unsigned int i;
+    int status = 0;
+
+    srand(1);
+
+    for(i = 0; i < PITCH * HEIGHT * BITPLANE_DEPTH; i++)
+        bitplanes[i] = rand();
+
+    for(i = 0; i < 32; i++)
+    {
+        colors[i].r = rand();
+        colors[i].g = rand();
+        colors[i].b = rand();
+    }
+
+    /* Interleave the bitplanes, so that every scanline contains the rows of all bitplanes */
+    for(i = 0; i < HEIGHT; i++)
+    {
+        unsigned int j;
+
+        for(j = 0; j < BITPLANE_DEPTH; j++)
+            memcpy(interleavedBitplanes + (i * BITPLANE_DEPTH + j) * PITCH, bitplanes + (j * HEIGHT + i) * PITCH, PITCH);
+    }
+
+    /* Convert the separate bitplanes */
+    initScreen(&screen);
+    amiVideo_setScreenBitplanes(&screen, bitplanes);
+    convertScreen(&screen, expectedChunkyPixels, expectedRGBPixels);
+    amiVideo_cleanupScreen(&screen);
+
+    /* Convert the interleaved bitplanes, which must give the same result */
+    initScreen(&screen);
+    amiVideo_setScreenInterleavedBitplanes(&screen, interleavedBitplanes);
+    convertScreen(&screen, chunkyPixels, rgbPixels);
+
+    if(memcmp(chunkyPixels, expectedChunkyPixels, sizeof(chunkyPixels)) != 0)
+    {
+        fprintf(stderr, "The chunky pixels of the interleaved bitplanes are incorrect!\n");
+        status = 1;
+    }
+
+    if(memcmp(rgbPixels, expectedRGBPixels, sizeof(rgbPixels)) != 0)
+    {
+        fprintf(stderr, "The RGB pixels of the interleaved bitplanes are incorrect!\n");
+        status = 1;
+    }
+
+    /* Converting the chunky pixels back must reproduce the interleaved bitplanes */
+    memset(interleavedBitplanes, '\0', sizeof(interleavedBitplanes));
+    amiVideo_convertScreenChunkyPixelsToBitplanes(&screen);
+
+    for(i = 0; i < HEIGHT; i++)
+    {
+        unsigned int j;
+
+        for(j = 0; j < BITPLANE_DEPTH; j++)
+        {
+            if(memcmp(interleavedBitplanes + (i * BITPLANE_DEPTH + j) * PITCH, bitplanes + (j * HEIGHT + i) * PITCH, WIDTH / 8) != 0)
+            {
+                fprintf(stderr, "Scanline: %u of bitplane: %u is incorrect!\n", i, j);
+                status = 1;
+            }
+        }
+    }
+
+    amiVideo_cleanupScreen(&screen);
+
+    return status;
+}
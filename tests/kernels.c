@@ -0,0 +1,229 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <screen.h>
+#include <cpufeatures.h>
+#include <viewportmode.h>
+
+#define WIDTH 700
+#define HEIGHT 4
+#define BITPLANE_DEPTH 8
+#define PITCH 704
+
+static amiVideo_UByte computeIndex(const amiVideo_Screen *screen, unsigned int x, unsigned int y)
+{
+    amiVideo_UByte index = 0;
+    unsigned int i;
+
+    for(i = 0; i < screen->bitplaneDepth; i++)
+    {
+        if(screen->bitplaneFormat.bitplanes[i][y * screen->bitplaneFormat.pitch + x / 8] & (0x80 >> (x % 8)))
+            index |= 1 << i;
+    }
+
+    return index;
+}
+
+static int checkBitplanesToChunkyPixels(unsigned int bitplaneDepth, amiVideo_UByte *bitplanes, amiVideo_UByte *pixels)
+{
+    amiVideo_Screen screen;
+    unsigned int x, y;
+    int status = 0;
+
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, bitplaneDepth, 8, 0);
+    amiVideo_setScreenBitplanes(&screen, bitplanes);
+    amiVideo_setScreenUncorrectedChunkyPixelsPointer(&screen, pixels, PITCH);
+
+    amiVideo_convertScreenBitplanesToChunkyPixels(&screen);
+
+    for(y = 0; y < HEIGHT; y++)
+    {
+        for(x = 0; x < WIDTH; x++)
+        {
+            if(pixels[y * PITCH + x] != computeIndex(&screen, x, y))
+                status = 1;
+        }
+    }
+
+    amiVideo_cleanupScreen(&screen);
+
+    return status;
+}
+
+static int checkChunkyPixelsToBitplanes(unsigned int bitplaneDepth, amiVideo_UByte *bitplanes, amiVideo_UByte *pixels)
+{
+    amiVideo_Screen screen;
+    unsigned int x, y;
+    int status = 0;
+
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, bitplaneDepth, 8, 0);
+    amiVideo_setScreenBitplanes(&screen, bitplanes);
+    amiVideo_setScreenUncorrectedChunkyPixelsPointer(&screen, pixels, PITCH);
+
+    amiVideo_convertScreenChunkyPixelsToBitplanes(&screen);
+
+    for(y = 0; y < HEIGHT; y++)
+    {
+        for(x = 0; x < screen.bitplaneFormat.pitch * 8; x++)
+        {
+            amiVideo_UByte index = pixels[y * PITCH + x] & ((1 << bitplaneDepth) - 1);
+
+            if(x >= WIDTH)
+                index = 0; /* The padding bits must be 0 */
+
+            if(computeIndex(&screen, x, y) != index)
+                status = 1;
+        }
+    }
+
+    amiVideo_cleanupScreen(&screen);
+
+    return status;
+}
+
+static int checkCorrectedPixels(unsigned int lowresPixelScaleFactor, amiVideo_Long viewportMode, unsigned int bytesPerPixel, amiVideo_UByte *pixels)
+{
+    amiVideo_Screen screen;
+    amiVideo_UByte *correctedPixels;
+    unsigned int correctedPitch, x, y;
+    int status = 0;
+
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, BITPLANE_DEPTH, 8, viewportMode);
+    amiVideo_setLowresPixelScaleFactor(&screen, lowresPixelScaleFactor);
+
+    /* The source pixels are interpreted as either chunky or RGB pixels */
+    amiVideo_setScreenUncorrectedChunkyPixelsPointer(&screen, pixels, PITCH);
+    amiVideo_setScreenUncorrectedRGBPixelsPointer(&screen, (amiVideo_ULong*)pixels, PITCH * 4, 0, 16, 8, 0, 24);
+
+    correctedPitch = screen.correctedFormat.width * bytesPerPixel + 4;
+    correctedPixels = (amiVideo_UByte*)malloc(correctedPitch * screen.correctedFormat.height);
+    amiVideo_setScreenCorrectedPixelsPointer(&screen, correctedPixels, correctedPitch, bytesPerPixel, 0, 16, 8, 0, 24);
+
+    amiVideo_correctScreenPixels(&screen);
+
+    for(y = 0; y < screen.correctedFormat.height; y++)
+    {
+        for(x = 0; x < screen.correctedFormat.width; x++)
+        {
+            unsigned int sourceX = x * WIDTH / screen.correctedFormat.width;
+            unsigned int sourceY = y * HEIGHT / screen.correctedFormat.height;
+
+            if(memcmp(correctedPixels + y * correctedPitch + x * bytesPerPixel, pixels + sourceY * PITCH * bytesPerPixel + sourceX * bytesPerPixel, bytesPerPixel) != 0)
+                status = 1;
+        }
+    }
+
+    free(correctedPixels);
+    amiVideo_cleanupScreen(&screen);
+
+    return status;
+}
+
+static int checkReorderedPixels(unsigned int bitplaneDepth, const amiVideo_UByte *shifts, const amiVideo_UByte *pixels)
+{
+    amiVideo_Screen screen;
+    amiVideo_ULong *rgbPixels = (amiVideo_ULong*)malloc(PITCH * HEIGHT * 4);
+    const amiVideo_ULong *sourcePixels = (const amiVideo_ULong*)pixels;
+    unsigned int x, y;
+    int status = 0;
+
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, bitplaneDepth, 8, 0);
+    amiVideo_setScreenUncorrectedRGBPixelsPointer(&screen, rgbPixels, PITCH * 4, 0, shifts[0], shifts[1], shifts[2], shifts[3]);
+    memcpy(rgbPixels, pixels, PITCH * HEIGHT * 4);
+
+    amiVideo_reorderRGBPixels(&screen);
+
+    for(y = 0; y < HEIGHT; y++)
+    {
+        for(x = 0; x < PITCH; x++)
+        {
+            amiVideo_ULong pixel = sourcePixels[y * PITCH + x];
+            amiVideo_ULong expected;
+
+            /* The source pixels are 0RGB for 24 bitplanes and RGBA for 32 bitplanes. The padding must remain untouched */
+            if(x >= WIDTH)
+                expected = pixel;
+            else if(bitplaneDepth == 24)
+                expected = (((pixel >> 16) & 0xff) << shifts[0]) | (((pixel >> 8) & 0xff) << shifts[1]) | ((pixel & 0xff) << shifts[2]) | (((pixel >> 24) & 0xff) << shifts[3]);
+            else
+                expected = (((pixel >> 24) & 0xff) << shifts[0]) | (((pixel >> 16) & 0xff) << shifts[1]) | (((pixel >> 8) & 0xff) << shifts[2]) | ((pixel & 0xff) << shifts[3]);
+
+            if(rgbPixels[y * PITCH + x] != expected)
+                status = 1;
+        }
+    }
+
+    free(rgbPixels);
+    amiVideo_cleanupScreen(&screen);
+
+    return status;
+}
+
+int main(int argc, char *argv[])
+{
+    amiVideo_ULong features[] = { 0, AMIVIDEO_CPU_SSE2 | AMIVIDEO_CPU_SSSE3, AMIVIDEO_CPU_ALL };
+    /* RGBA, ARGB, BGRA, 0RGB, a layout in which alpha overlaps blue and a layout that is not byte aligned */
+    amiVideo_UByte layouts[][4] = { { 24, 16, 8, 0 }, { 16, 8, 0, 24 }, { 8, 16, 24, 0 }, { 0, 8, 16, 24 }, { 16, 8, 0, 0 }, { 20, 10, 0, 30 } };
+    amiVideo_Long viewportModes[] = { 0, AMIVIDEO_VIDEOPORTMODE_HIRES, AMIVIDEO_VIDEOPORTMODE_SUPERHIRES | AMIVIDEO_VIDEOPORTMODE_LACE, 0 };
+    unsigned int lowresPixelScaleFactors[] = { 4, 4, 4, 3 };
+    amiVideo_UByte *bitplanes = (amiVideo_UByte*)malloc(PITCH / 8 * HEIGHT * BITPLANE_DEPTH);
+    amiVideo_UByte *pixels = (amiVideo_UByte*)malloc(PITCH * HEIGHT * 4);
+    unsigned int i;
+    int status = 0;
+
+    srand(1);
+
+    for(i = 0; i < PITCH / 8 * HEIGHT * BITPLANE_DEPTH; i++)
+        bitplanes[i] = rand();
+
+    for(i = 0; i < PITCH * HEIGHT * 4; i++)
+        pixels[i] = rand();
+
+    /* Every kernel must produce the same results as a bit by bit conversion */
+    for(i = 0; i < sizeof(features) / sizeof(amiVideo_ULong); i++)
+    {
+        unsigned int bitplaneDepth, j;
+
+        amiVideo_restrictCPUFeatures(features[i]);
+
+        for(bitplaneDepth = 1; bitplaneDepth <= BITPLANE_DEPTH; bitplaneDepth++)
+        {
+            if(checkBitplanesToChunkyPixels(bitplaneDepth, bitplanes, pixels) != 0)
+            {
+                fprintf(stderr, "Chunky pixels of bitplane depth: %u with CPU features: %x are incorrect!\n", bitplaneDepth, features[i]);
+                status = 1;
+            }
+
+            if(checkChunkyPixelsToBitplanes(bitplaneDepth, bitplanes, pixels) != 0)
+            {
+                fprintf(stderr, "Bitplanes of bitplane depth: %u with CPU features: %x are incorrect!\n", bitplaneDepth, features[i]);
+                status = 1;
+            }
+        }
+
+        /* Check the replication kernels for each repeat factor and a repeat factor without a specialized kernel */
+        for(j = 0; j < sizeof(viewportModes) / sizeof(amiVideo_Long); j++)
+        {
+            if(checkCorrectedPixels(lowresPixelScaleFactors[j], viewportModes[j], 1, pixels) != 0 || checkCorrectedPixels(lowresPixelScaleFactors[j], viewportModes[j], 4, pixels) != 0)
+            {
+                fprintf(stderr, "Corrected pixels of viewport mode: %x with scale factor: %u and CPU features: %x are incorrect!\n", viewportModes[j], lowresPixelScaleFactors[j], features[i]);
+                status = 1;
+            }
+        }
+
+        /* Check the swizzle kernels for layouts that are permutations and layouts that are not */
+        for(j = 0; j < sizeof(layouts) / sizeof(layouts[0]); j++)
+        {
+            if(checkReorderedPixels(24, layouts[j], pixels) != 0 || checkReorderedPixels(32, layouts[j], pixels) != 0)
+            {
+                fprintf(stderr, "Reordered pixels of layout: %u %u %u %u with CPU features: %x are incorrect!\n", layouts[j][0], layouts[j][1], layouts[j][2], layouts[j][3], features[i]);
+                status = 1;
+            }
+        }
+    }
+
+    free(pixels);
+    free(bitplanes);
+
+    return status;
+}
@@ -0,0 +1,131 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <screen.h>
+#include <viewportmode.h>
+
+#define WIDTH 40
+#define HEIGHT 4
+#define PITCH 6
+
+static amiVideo_ULong expectedPixel(const amiVideo_OutputColor *color)
+{
+    return (color->r << 16) | (color->g << 8) | color->b;
+}
+
+static int checkBitplaneConversion(unsigned int bitplaneDepth, amiVideo_Long viewportMode)
+{
+    amiVideo_UByte *bitplanes = (amiVideo_UByte*)malloc(PITCH * HEIGHT * bitplaneDepth);
+    amiVideo_UByte chunkyPixels[WIDTH * HEIGHT];
+    amiVideo_ULong pixels[WIDTH * HEIGHT];
+    amiVideo_Color colors[256];
+    amiVideo_Screen screen;
+    unsigned int i;
+    int status = 0;
+
+    for(i = 0; i < PITCH * HEIGHT * bitplaneDepth; i++)
+        bitplanes[i] = rand();
+
+    for(i = 0; i < 256; i++)
+    {
+        colors[i].r = rand();
+        colors[i].g = rand();
+        colors[i].b = rand();
+    }
+
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, bitplaneDepth, 8, viewportMode);
+    amiVideo_setBitplanePaletteColors(&screen.palette, colors, screen.palette.bitplaneFormat.numOfColors);
+    amiVideo_setScreenBitplanes(&screen, bitplanes);
+    amiVideo_setScreenUncorrectedChunkyPixelsPointer(&screen, chunkyPixels, WIDTH);
+    amiVideo_setScreenUncorrectedRGBPixelsPointer(&screen, pixels, WIDTH * 4, 0, 16, 8, 0, 24);
+
+    /* Convert twice, so that the second conversion uses the cached lookup tables */
+    for(i = 0; i < 2; i++)
+    {
+        unsigned int j;
+
+        amiVideo_convertScreenBitplanesToChunkyPixels(&screen);
+        amiVideo_convertScreenBitplanesToRGBPixels(&screen);
+
+        for(j = 0; j < WIDTH * HEIGHT; j++)
+        {
+            if(pixels[j] != expectedPixel(&screen.palette.chunkyFormat.color[chunkyPixels[j]]))
+            {
+                fprintf(stderr, "Pixel: %u of a screen with bitplane depth: %u has value: %x, expected: %x\n", j, bitplaneDepth, pixels[j], expectedPixel(&screen.palette.chunkyFormat.color[chunkyPixels[j]]));
+                status = 1;
+                break;
+            }
+        }
+    }
+
+    amiVideo_cleanupScreen(&screen);
+    free(bitplanes);
+
+    return status;
+}
+
+int main(int argc, char *argv[])
+{
+    amiVideo_Palette palette;
+    amiVideo_OutputColor colors[16];
+    const amiVideo_ULong *pixels;
+    unsigned int i;
+    int status = 0;
+
+    srand(1);
+
+    for(i = 0; i < 16; i++)
+    {
+        colors[i].r = rand();
+        colors[i].g = rand();
+        colors[i].b = rand();
+        colors[i].a = 0;
+    }
+
+    amiVideo_initPalette(&palette, 4, 8, 0);
+    amiVideo_setChunkyPaletteColors(&palette, colors, 16);
+
+    /* The lookup table contains the colors in the requested layout */
+    pixels = amiVideo_getPaletteRGBPixels(&palette, 16, 8, 0, 24);
+
+    for(i = 0; i < 16; i++)
+    {
+        if(pixels[i] != expectedPixel(&colors[i]))
+        {
+            fprintf(stderr, "Color: %u has pixel value: %x, expected: %x\n", i, pixels[i], expectedPixel(&colors[i]));
+            status = 1;
+        }
+    }
+
+    /* Changing the colors must invalidate the cached table */
+    colors[3].g ^= 0xff;
+    amiVideo_setChunkyPaletteColors(&palette, colors, 16);
+    pixels = amiVideo_getPaletteRGBPixels(&palette, 16, 8, 0, 24);
+
+    if(pixels[3] != expectedPixel(&colors[3]))
+    {
+        fprintf(stderr, "The cached pixel values are not updated after changing the colors!\n");
+        status = 1;
+    }
+
+    /* Changing the layout must regenerate the table */
+    pixels = amiVideo_getPaletteRGBPixels(&palette, 0, 8, 16, 24);
+
+    if(pixels[5] != ((colors[5].b << 16) | (colors[5].g << 8) | colors[5].r))
+    {
+        fprintf(stderr, "The cached pixel values are not updated after changing the layout!\n");
+        status = 1;
+    }
+
+    amiVideo_cleanupPalette(&palette);
+
+    /* Bitplane conversions, with and without the pixel pair table */
+    if(checkBitplaneConversion(1, 0) != 0
+      || checkBitplaneConversion(4, 0) != 0
+      || checkBitplaneConversion(5, 0) != 0
+      || checkBitplaneConversion(6, AMIVIDEO_VIDEOPORTMODE_EHB) != 0
+      || checkBitplaneConversion(8, 0) != 0)
+        status = 1;
+
+    return status;
+}
@@ -0,0 +1,93 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <screen.h>
+#include <viewportmode.h>
+
+#define WIDTH 333
+#define HEIGHT 37
+#define BITPLANE_DEPTH 6
+#define LOWRES_PIXEL_SCALE_FACTOR 2
+
+static unsigned int numOfExecutedBands;
+
+static void executeBandsInReverse(amiVideo_BandFunction function, void *data, unsigned int numOfBands, void *executorData)
+{
+    unsigned int i;
+
+    for(i = numOfBands; i > 0; i--)
+    {
+        function(data, i - 1);
+        numOfExecutedBands++;
+    }
+}
+
+static void convertScreen(amiVideo_ULong *pixels, amiVideo_UByte *bitplanes, unsigned int numOfThreads, amiVideo_Executor executor)
+{
+    amiVideo_Screen screen;
+    amiVideo_Color colors[16];
+    unsigned int i;
+
+    for(i = 0; i < 16; i++)
+    {
+        colors[i].r = i * 16;
+        colors[i].g = 255 - i * 16;
+        colors[i].b = i * 8;
+    }
+
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, BITPLANE_DEPTH, 8, AMIVIDEO_VIDEOPORTMODE_HAM);
+    amiVideo_setLowresPixelScaleFactor(&screen, LOWRES_PIXEL_SCALE_FACTOR);
+    amiVideo_setBitplanePaletteColors(&screen.palette, colors, 16);
+    amiVideo_setScreenBitplanes(&screen, bitplanes);
+    amiVideo_setScreenCorrectedPixelsPointer(&screen, pixels, screen.correctedFormat.width * 4, 4, 0, 16, 8, 0, 24);
+
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixelsParallel(&screen, numOfThreads, executor, NULL);
+
+    amiVideo_cleanupScreen(&screen);
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int numOfPixels = WIDTH * LOWRES_PIXEL_SCALE_FACTOR * HEIGHT * LOWRES_PIXEL_SCALE_FACTOR;
+    amiVideo_UByte *bitplanes = (amiVideo_UByte*)malloc((WIDTH + 15) / 16 * 2 * HEIGHT * BITPLANE_DEPTH);
+    amiVideo_ULong *expectedPixels = (amiVideo_ULong*)calloc(numOfPixels, sizeof(amiVideo_ULong));
+    amiVideo_ULong *pixels = (amiVideo_ULong*)calloc(numOfPixels, sizeof(amiVideo_ULong));
+    unsigned int i;
+    int status = 0;
+
+    srand(1);
+
+    for(i = 0; i < (WIDTH + 15) / 16 * 2 * HEIGHT * BITPLANE_DEPTH; i++)
+        bitplanes[i] = rand();
+
+    convertScreen(expectedPixels, bitplanes, 1, NULL);
+
+    /* The output must not depend on the amount of bands, nor on the order in which they are converted */
+    for(i = 2; i <= HEIGHT + 1; i += 5)
+    {
+        memset(pixels, 0, numOfPixels * sizeof(amiVideo_ULong));
+        convertScreen(pixels, bitplanes, i, NULL);
+
+        if(memcmp(pixels, expectedPixels, numOfPixels * sizeof(amiVideo_ULong)) != 0)
+        {
+            fprintf(stderr, "The pixels converted by %u threads are not identical!\n", i);
+            status = 1;
+        }
+
+        memset(pixels, 0, numOfPixels * sizeof(amiVideo_ULong));
+        numOfExecutedBands = 0;
+        convertScreen(pixels, bitplanes, i, executeBandsInReverse);
+
+        if(memcmp(pixels, expectedPixels, numOfPixels * sizeof(amiVideo_ULong)) != 0 || numOfExecutedBands != (i > HEIGHT ? HEIGHT : i))
+        {
+            fprintf(stderr, "The pixels converted by an executor with %u bands are not identical!\n", i);
+            status = 1;
+        }
+    }
+
+    free(pixels);
+    free(expectedPixels);
+    free(bitplanes);
+
+    return status;
+}
@@ -0,0 +1,228 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <screen.h>
+#include <viewportmode.h>
+
+#define WIDTH 300
+#define HEIGHT 20
+#define PLAYFIELD_WIDTH 416
+#define PLAYFIELD_HEIGHT 32
+#define MODULO 4
+#define ROW_STRIDE (PLAYFIELD_WIDTH / 8 + MODULO)
+#define MAX_BITPLANE_DEPTH 24
+#define LOWRES_PIXEL_SCALE_FACTOR 2
+#define NUM_OF_PIXELS (WIDTH * HEIGHT * LOWRES_PIXEL_SCALE_FACTOR * LOWRES_PIXEL_SCALE_FACTOR)
+
+static int getPlayfieldBit(const amiVideo_UByte *playfield, unsigned int bitplane, unsigned int x, unsigned int y)
+{
+    return (playfield[bitplane * ROW_STRIDE * PLAYFIELD_HEIGHT + y * ROW_STRIDE + x / 8] >> (7 - x % 8)) & 1;
+}
+
+static void setPlayfieldBit(amiVideo_UByte *playfield, unsigned int bitplane, unsigned int x, unsigned int y, int value)
+{
+    amiVideo_UByte *byte = &playfield[bitplane * ROW_STRIDE * PLAYFIELD_HEIGHT + y * ROW_STRIDE + x / 8];
+
+    if(value)
+        *byte |= 0x80 >> (x % 8);
+    else
+        *byte &= ~(0x80 >> (x % 8));
+}
+
+/* Copies the visible part of the playfield into separately stored bitplanes */
+static void copyVisibleBitplanes(const amiVideo_UByte *playfield, unsigned int bitplaneDepth, unsigned int playfieldX, unsigned int playfieldY, const amiVideo_Screen *screen, amiVideo_UByte *bitplanes)
+{
+    unsigned int i;
+
+    memset(bitplanes, '\0', screen->bitplaneFormat.pitch * HEIGHT * bitplaneDepth);
+
+    for(i = 0; i < bitplaneDepth; i++)
+    {
+        unsigned int x, y;
+
+        for(y = 0; y < HEIGHT; y++)
+        {
+            for(x = 0; x < WIDTH; x++)
+            {
+                if(getPlayfieldBit(playfield, i, playfieldX + x, (playfieldY + y) % PLAYFIELD_HEIGHT))
+                    bitplanes[(i * HEIGHT + y) * screen->bitplaneFormat.pitch + x / 8] |= 0x80 >> (x % 8);
+            }
+        }
+    }
+}
+
+static void initScreen(amiVideo_Screen *screen, unsigned int bitplaneDepth, amiVideo_Color *colors)
+{
+    amiVideo_initScreen(screen, WIDTH, HEIGHT, bitplaneDepth, 8, 0);
+    amiVideo_setLowresPixelScaleFactor(screen, LOWRES_PIXEL_SCALE_FACTOR);
+
+    if(bitplaneDepth <= 8)
+        amiVideo_setBitplanePaletteColors(&screen->palette, colors, 1 << bitplaneDepth);
+}
+
+static void convertScreen(amiVideo_Screen *screen, amiVideo_UByte *chunkyPixels, amiVideo_ULong *rgbPixels, amiVideo_ULong *correctedPixels)
+{
+    amiVideo_setScreenUncorrectedChunkyPixelsPointer(screen, chunkyPixels, WIDTH);
+    amiVideo_setScreenUncorrectedRGBPixelsPointer(screen, rgbPixels, WIDTH * 4, 0, 16, 8, 0, 24);
+    amiVideo_setScreenCorrectedPixelsPointer(screen, correctedPixels, screen->correctedFormat.width * 4, 4, 0, 16, 8, 0, 24);
+
+    amiVideo_convertScreenBitplanesToChunkyPixels(screen);
+    amiVideo_convertScreenBitplanesToRGBPixels(screen);
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixels(screen);
+}
+
+/* Converts the visible part of the playfield and compares it with the conversion of a copy of the visible part */
+static int checkView(amiVideo_Screen *screen, const amiVideo_UByte *playfield, unsigned int bitplaneDepth, unsigned int playfieldX, unsigned int playfieldY, amiVideo_Color *colors)
+{
+    amiVideo_UByte bitplanes[(WIDTH + 15) / 16 * 2 * HEIGHT * MAX_BITPLANE_DEPTH];
+    amiVideo_UByte expectedChunkyPixels[WIDTH * HEIGHT], chunkyPixels[WIDTH * HEIGHT];
+    amiVideo_ULong expectedRGBPixels[WIDTH * HEIGHT], rgbPixels[WIDTH * HEIGHT];
+    amiVideo_ULong expectedCorrectedPixels[NUM_OF_PIXELS], correctedPixels[NUM_OF_PIXELS];
+    amiVideo_Screen expectedScreen;
+    int status = 0;
+
+    initScreen(&expectedScreen, bitplaneDepth, colors);
+    copyVisibleBitplanes(playfield, bitplaneDepth, playfieldX, playfieldY, &expectedScreen, bitplanes);
+    amiVideo_setScreenBitplanes(&expectedScreen, bitplanes);
+    convertScreen(&expectedScreen, expectedChunkyPixels, expectedRGBPixels, expectedCorrectedPixels);
+    amiVideo_cleanupScreen(&expectedScreen);
+
+    convertScreen(screen, chunkyPixels, rgbPixels, correctedPixels);
+
+    if(memcmp(chunkyPixels, expectedChunkyPixels, sizeof(chunkyPixels)) != 0)
+    {
+        fprintf(stderr, "The chunky pixels of %u bitplanes at position: %u, %u are incorrect!\n", bitplaneDepth, playfieldX, playfieldY);
+        status = 1;
+    }
+
+    if(memcmp(rgbPixels, expectedRGBPixels, sizeof(rgbPixels)) != 0)
+    {
+        fprintf(stderr, "The RGB pixels of %u bitplanes at position: %u, %u are incorrect!\n", bitplaneDepth, playfieldX, playfieldY);
+        status = 1;
+    }
+
+    if(memcmp(correctedPixels, expectedCorrectedPixels, screen->correctedFormat.width * screen->correctedFormat.height * 4) != 0)
+    {
+        fprintf(stderr, "The corrected pixels of %u bitplanes at position: %u, %u are incorrect!\n", bitplaneDepth, playfieldX, playfieldY);
+        status = 1;
+    }
+
+    return status;
+}
+
+static void setPlayfieldPosition(amiVideo_Screen *screen, amiVideo_UByte *playfield, unsigned int x, unsigned int y)
+{
+    amiVideo_Playfield view;
+
+    view.bitplanes = playfield;
+    view.planeOffset = ROW_STRIDE * PLAYFIELD_HEIGHT;
+    view.rowStride = ROW_STRIDE;
+    view.numOfRows = PLAYFIELD_HEIGHT;
+    view.x = x;
+    view.y = y;
+
+    amiVideo_setScreenPlayfield(screen, &view);
+}
+
+static int checkScrolling(amiVideo_UByte *playfield, unsigned int bitplaneDepth, amiVideo_Color *colors)
+{
+    unsigned int positions[][2] = { { 0, 0 }, { 8, 3 }, { 3, 0 }, { 13, 5 }, { 101, 12 }, { 115, 31 }, { 116, 31 } };
+    amiVideo_Screen screen;
+    unsigned int i;
+    int status = 0;
+
+    initScreen(&screen, bitplaneDepth, colors);
+
+    /* The same screen scrolls over the playfield, without copying it */
+    for(i = 0; i < sizeof(positions) / sizeof(positions[0]); i++)
+    {
+        setPlayfieldPosition(&screen, playfield, positions[i][0], positions[i][1]);
+        status |= checkView(&screen, playfield, bitplaneDepth, positions[i][0], positions[i][1], colors);
+    }
+
+    /* An incremental conversion notices a fine scroll that does not change the bitplane pointers and a modified visible pixel */
+    amiVideo_setScreenIncrementalConversion(&screen, 1);
+    setPlayfieldPosition(&screen, playfield, 16, 20);
+    status |= checkView(&screen, playfield, bitplaneDepth, 16, 20, colors);
+    setPlayfieldPosition(&screen, playfield, 21, 20);
+    status |= checkView(&screen, playfield, bitplaneDepth, 21, 20, colors);
+
+    setPlayfieldBit(playfield, 0, 21 + WIDTH - 1, (20 + HEIGHT - 1) % PLAYFIELD_HEIGHT, !getPlayfieldBit(playfield, 0, 21 + WIDTH - 1, (20 + HEIGHT - 1) % PLAYFIELD_HEIGHT));
+    status |= checkView(&screen, playfield, bitplaneDepth, 21, 20, colors);
+
+    amiVideo_cleanupScreen(&screen);
+
+    return status;
+}
+
+/* Writes chunky pixels into the visible part of the playfield, which must leave the rest of the playfield untouched */
+static int checkChunkyPixelsToPlayfield(amiVideo_UByte *playfield, unsigned int bitplaneDepth, unsigned int playfieldX, unsigned int playfieldY)
+{
+    amiVideo_UByte *expectedPlayfield = (amiVideo_UByte*)malloc(ROW_STRIDE * PLAYFIELD_HEIGHT * bitplaneDepth);
+    amiVideo_UByte chunkyPixels[WIDTH * HEIGHT];
+    amiVideo_Screen screen;
+    unsigned int i;
+    int status = 0;
+
+    for(i = 0; i < sizeof(chunkyPixels); i++)
+        chunkyPixels[i] = rand() % (1 << bitplaneDepth);
+
+    /* Compose the expected playfield bit by bit */
+    memcpy(expectedPlayfield, playfield, ROW_STRIDE * PLAYFIELD_HEIGHT * bitplaneDepth);
+
+    for(i = 0; i < bitplaneDepth; i++)
+    {
+        unsigned int x, y;
+
+        for(y = 0; y < HEIGHT; y++)
+        {
+            for(x = 0; x < WIDTH; x++)
+                setPlayfieldBit(expectedPlayfield, i, playfieldX + x, (playfieldY + y) % PLAYFIELD_HEIGHT, (chunkyPixels[y * WIDTH + x] >> i) & 1);
+        }
+    }
+
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, bitplaneDepth, 8, 0);
+    setPlayfieldPosition(&screen, playfield, playfieldX, playfieldY);
+    amiVideo_setScreenUncorrectedChunkyPixelsPointer(&screen, chunkyPixels, WIDTH);
+    amiVideo_convertScreenChunkyPixelsToBitplanes(&screen);
+    amiVideo_cleanupScreen(&screen);
+
+    if(memcmp(playfield, expectedPlayfield, ROW_STRIDE * PLAYFIELD_HEIGHT * bitplaneDepth) != 0)
+    {
+        fprintf(stderr, "The playfield of %u bitplanes at position: %u, %u is incorrect!\n", bitplaneDepth, playfieldX, playfieldY);
+        status = 1;
+    }
+
+    free(expectedPlayfield);
+
+    return status;
+}
+
+int main(int argc, char *argv[])
+{
+    amiVideo_UByte *playfield = (amiVideo_UByte*)malloc(ROW_STRIDE * PLAYFIELD_HEIGHT * MAX_BITPLANE_DEPTH);
+    amiVideo_Color colors[32];
+    unsigned int i;
+    int status = 0;
+
+    srand(1);
+
+    for(i = 0; i < ROW_STRIDE * PLAYFIELD_HEIGHT * MAX_BITPLANE_DEPTH; i++)
+        playfield[i] = rand();
+
+    for(i = 0; i < 32; i++)
+    {
+        colors[i].r = rand();
+        colors[i].g = rand();
+        colors[i].b = rand();
+    }
+
+    status |= checkScrolling(playfield, 5, colors);
+    status |= checkScrolling(playfield, 24, colors);
+    status |= checkChunkyPixelsToPlayfield(playfield, 5, 0, 0);
+    status |= checkChunkyPixelsToPlayfield(playfield, 5, 37, 25);
+
+    free(playfield);
+
+    return status;
+}
@@ -0,0 +1,235 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <screen.h>
+#include <viewportmode.h>
+
+#define WIDTH 300
+#define HEIGHT 20
+#define PITCH ((WIDTH + 15) / 16 * 2)
+#define MAX_BITPLANE_DEPTH 24
+#define LOWRES_PIXEL_SCALE_FACTOR 2
+#define NUM_OF_PIXELS (WIDTH * HEIGHT * LOWRES_PIXEL_SCALE_FACTOR * LOWRES_PIXEL_SCALE_FACTOR)
+#define UNTOUCHED 0xaa
+
+/* Checks whether the pixels inside the rectangle are identical to the full conversion and the pixels outside the rectangle are untouched */
+static int checkRectangle(const amiVideo_UByte *fullPixels, const amiVideo_UByte *pixels, unsigned int pitch, unsigned int numOfRows, unsigned int left, unsigned int top, unsigned int right, unsigned int bottom)
+{
+    unsigned int i;
+
+    for(i = 0; i < numOfRows; i++)
+    {
+        unsigned int j;
+
+        for(j = 0; j < pitch; j++)
+        {
+            unsigned int offset = i * pitch + j;
+
+            if(i >= top && i < bottom && j >= left && j < right)
+            {
+                if(pixels[offset] != fullPixels[offset])
+                    return 1;
+            }
+            else if(pixels[offset] != UNTOUCHED)
+                return 1;
+        }
+    }
+
+    return 0;
+}
+
+static void initScreen(amiVideo_Screen *screen, amiVideo_UByte *bitplanes, unsigned int bitplaneDepth, amiVideo_Long viewportMode, amiVideo_Color *colors)
+{
+    amiVideo_initScreen(screen, WIDTH, HEIGHT, bitplaneDepth, 8, viewportMode);
+    amiVideo_setLowresPixelScaleFactor(screen, LOWRES_PIXEL_SCALE_FACTOR);
+    amiVideo_setScreenBitplanes(screen, bitplanes);
+
+    if(bitplaneDepth <= 8)
+        amiVideo_setBitplanePaletteColors(&screen->palette, colors, bitplaneDepth < 5 ? 1 << bitplaneDepth : 32);
+}
+
+static int checkRegion(amiVideo_UByte *bitplanes, unsigned int bitplaneDepth, amiVideo_Long viewportMode, amiVideo_Color *colors, const amiVideo_Region *region)
+{
+    static amiVideo_UByte fullChunkyPixels[WIDTH * HEIGHT], chunkyPixels[WIDTH * HEIGHT];
+    static amiVideo_ULong fullRGBPixels[WIDTH * HEIGHT], rgbPixels[WIDTH * HEIGHT];
+    static amiVideo_ULong fullCorrectedPixels[NUM_OF_PIXELS], correctedPixels[NUM_OF_PIXELS];
+    unsigned int right = region->x + region->width > WIDTH ? WIDTH : region->x + region->width;
+    unsigned int bottom = region->y + region->height > HEIGHT ? HEIGHT : region->y + region->height;
+    unsigned int repeatHorizontal, repeatVertical, correctedPitch;
+    amiVideo_Screen screen;
+    int status = 0;
+
+    /* Convert the full screen */
+    initScreen(&screen, bitplanes, bitplaneDepth, viewportMode, colors);
+    repeatHorizontal = screen.correctedFormat.width / WIDTH;
+    repeatVertical = screen.correctedFormat.height / HEIGHT;
+    correctedPitch = screen.correctedFormat.width * 4;
+
+    amiVideo_setScreenUncorrectedChunkyPixelsPointer(&screen, fullChunkyPixels, WIDTH);
+    amiVideo_setScreenUncorrectedRGBPixelsPointer(&screen, fullRGBPixels, WIDTH * 4, 0, 16, 8, 0, 24);
+    amiVideo_setScreenCorrectedPixelsPointer(&screen, fullCorrectedPixels, correctedPitch, 4, 0, 16, 8, 0, 24);
+    amiVideo_convertScreenBitplanesToChunkyPixels(&screen);
+    amiVideo_convertScreenBitplanesToRGBPixels(&screen);
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixels(&screen);
+
+    /* Convert the region into untouched surfaces */
+    memset(chunkyPixels, UNTOUCHED, sizeof(chunkyPixels));
+    memset(rgbPixels, UNTOUCHED, sizeof(rgbPixels));
+    memset(correctedPixels, UNTOUCHED, sizeof(correctedPixels));
+
+    amiVideo_setScreenUncorrectedChunkyPixelsPointer(&screen, chunkyPixels, WIDTH);
+    amiVideo_setScreenUncorrectedRGBPixelsPointer(&screen, rgbPixels, WIDTH * 4, 0, 16, 8, 0, 24);
+    amiVideo_setScreenCorrectedPixelsPointer(&screen, correctedPixels, correctedPitch, 4, 0, 16, 8, 0, 24);
+    amiVideo_convertScreenBitplanesToChunkyPixelsRegion(&screen, region);
+    amiVideo_convertScreenBitplanesToRGBPixelsRegion(&screen, region);
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixelsRegion(&screen, region);
+
+    if(checkRectangle(fullChunkyPixels, chunkyPixels, WIDTH, HEIGHT, region->x, region->y, right, bottom) != 0)
+    {
+        fprintf(stderr, "The chunky pixels of the region: %u, %u, %u, %u of %u bitplanes are incorrect!\n", region->x, region->y, region->width, region->height, bitplaneDepth);
+        status = 1;
+    }
+
+    if(checkRectangle((amiVideo_UByte*)fullRGBPixels, (amiVideo_UByte*)rgbPixels, WIDTH * 4, HEIGHT, region->x * 4, region->y, right * 4, bottom) != 0)
+    {
+        fprintf(stderr, "The RGB pixels of the region: %u, %u, %u, %u of %u bitplanes are incorrect!\n", region->x, region->y, region->width, region->height, bitplaneDepth);
+        status = 1;
+    }
+
+    if(checkRectangle((amiVideo_UByte*)fullCorrectedPixels, (amiVideo_UByte*)correctedPixels, correctedPitch, HEIGHT * repeatVertical, region->x * repeatHorizontal * 4, region->y * repeatVertical, right * repeatHorizontal * 4, bottom * repeatVertical) != 0)
+    {
+        fprintf(stderr, "The corrected pixels of the region: %u, %u, %u, %u of %u bitplanes are incorrect!\n", region->x, region->y, region->width, region->height, bitplaneDepth);
+        status = 1;
+    }
+
+    /* Correct the region of the uncorrected RGB pixels separately */
+    if(bitplaneDepth <= 8)
+    {
+        memcpy(chunkyPixels, fullChunkyPixels, sizeof(chunkyPixels)); /* HAM pixels depend on the chunky pixels in front of the region */
+        memset(correctedPixels, UNTOUCHED, sizeof(correctedPixels));
+        amiVideo_convertScreenChunkyPixelsToRGBPixelsRegion(&screen, region);
+        amiVideo_correctScreenPixelsRegion(&screen, region);
+
+        if(checkRectangle((amiVideo_UByte*)fullCorrectedPixels, (amiVideo_UByte*)correctedPixels, correctedPitch, HEIGHT * repeatVertical, region->x * repeatHorizontal * 4, region->y * repeatVertical, right * repeatHorizontal * 4, bottom * repeatVertical) != 0)
+        {
+            fprintf(stderr, "The separately corrected pixels of the region: %u, %u, %u, %u of %u bitplanes are incorrect!\n", region->x, region->y, region->width, region->height, bitplaneDepth);
+            status = 1;
+        }
+    }
+
+    amiVideo_cleanupScreen(&screen);
+
+    return status;
+}
+
+/* Converts a region into packed 4-bit chunky pixels, of which the region is widened to whole bytes */
+static int checkChunky4Region(amiVideo_UByte *bitplanes, amiVideo_Color *colors, const amiVideo_Region *region)
+{
+    amiVideo_UByte fullPixels[WIDTH / 2 * HEIGHT], pixels[WIDTH / 2 * HEIGHT];
+    unsigned int right = region->x + region->width > WIDTH ? WIDTH : region->x + region->width;
+    unsigned int bottom = region->y + region->height > HEIGHT ? HEIGHT : region->y + region->height;
+    amiVideo_Screen screen;
+    int status = 0;
+
+    initScreen(&screen, bitplanes, 4, 0, colors);
+    amiVideo_setScreenUncorrectedChunkyPixelsPointer(&screen, fullPixels, WIDTH / 2);
+    amiVideo_setScreenUncorrectedChunkyPixelFormat(&screen, AMIVIDEO_PIXEL_FORMAT_CHUNKY4);
+    amiVideo_convertScreenBitplanesToChunkyPixels(&screen);
+
+    memset(pixels, UNTOUCHED, sizeof(pixels));
+    amiVideo_setScreenUncorrectedChunkyPixelsPointer(&screen, pixels, WIDTH / 2);
+    amiVideo_setScreenUncorrectedChunkyPixelFormat(&screen, AMIVIDEO_PIXEL_FORMAT_CHUNKY4);
+    amiVideo_convertScreenBitplanesToChunkyPixelsRegion(&screen, region);
+
+    if(checkRectangle(fullPixels, pixels, WIDTH / 2, HEIGHT, region->x / 2, region->y, (right + 1) / 2, bottom) != 0)
+    {
+        fprintf(stderr, "The 4-bit chunky pixels of the region: %u, %u, %u, %u are incorrect!\n", region->x, region->y, region->width, region->height);
+        status = 1;
+    }
+
+    amiVideo_cleanupScreen(&screen);
+
+    return status;
+}
+
+/* Encodes a region of chunky pixels into a copy of the bitplanes, which must leave the bits outside the region untouched */
+static int checkChunkyPixelsToBitplanesRegion(const amiVideo_UByte *bitplanes, unsigned int bitplaneDepth, const amiVideo_Region *region)
+{
+    amiVideo_UByte expectedBitplanes[PITCH * HEIGHT * 8], regionBitplanes[PITCH * HEIGHT * 8];
+    amiVideo_UByte chunkyPixels[WIDTH * HEIGHT];
+    amiVideo_Screen screen;
+    unsigned int i;
+
+    for(i = 0; i < sizeof(chunkyPixels); i++)
+        chunkyPixels[i] = rand() % (1 << bitplaneDepth);
+
+    memcpy(expectedBitplanes, bitplanes, PITCH * HEIGHT * bitplaneDepth);
+    memcpy(regionBitplanes, bitplanes, PITCH * HEIGHT * bitplaneDepth);
+
+    /* Compose the expected bitplanes bit by bit */
+    for(i = 0; i < bitplaneDepth; i++)
+    {
+        unsigned int x, y;
+
+        for(y = region->y; y < region->y + region->height && y < HEIGHT; y++)
+        {
+            for(x = region->x; x < region->x + region->width && x < WIDTH; x++)
+            {
+                amiVideo_UByte *byte = &expectedBitplanes[(i * HEIGHT + y) * PITCH + x / 8];
+
+                if((chunkyPixels[y * WIDTH + x] >> i) & 1)
+                    *byte |= 0x80 >> (x % 8);
+                else
+                    *byte &= ~(0x80 >> (x % 8));
+            }
+        }
+    }
+
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, bitplaneDepth, 8, 0);
+    amiVideo_setScreenBitplanes(&screen, regionBitplanes);
+    amiVideo_setScreenUncorrectedChunkyPixelsPointer(&screen, chunkyPixels, WIDTH);
+    amiVideo_convertScreenChunkyPixelsToBitplanesRegion(&screen, region);
+    amiVideo_cleanupScreen(&screen);
+
+    if(memcmp(regionBitplanes, expectedBitplanes, PITCH * HEIGHT * bitplaneDepth) != 0)
+    {
+        fprintf(stderr, "The bitplanes of the region: %u, %u, %u, %u of %u bitplanes are incorrect!\n", region->x, region->y, region->width, region->height, bitplaneDepth);
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    amiVideo_Region regions[] = { { 0, 0, WIDTH, HEIGHT }, { 64, 0, 64, 20 }, { 37, 3, 64, 9 }, { 5, 2, 3, 1 }, { 251, 11, 100, 100 }, { 13, 19, 287, 1 } };
+    amiVideo_UByte *bitplanes = (amiVideo_UByte*)malloc(PITCH * HEIGHT * MAX_BITPLANE_DEPTH);
+    amiVideo_Color colors[32];
+    unsigned int i;
+    int status = 0;
+
+    srand(1);
+
+    for(i = 0; i < PITCH * HEIGHT * MAX_BITPLANE_DEPTH; i++)
+        bitplanes[i] = rand();
+
+    for(i = 0; i < 32; i++)
+    {
+        colors[i].r = rand();
+        colors[i].g = rand();
+        colors[i].b = rand();
+    }
+
+    for(i = 0; i < sizeof(regions) / sizeof(regions[0]); i++)
+    {
+        status |= checkRegion(bitplanes, 5, 0, colors, &regions[i]);
+        status |= checkRegion(bitplanes, 6, AMIVIDEO_VIDEOPORTMODE_HAM | AMIVIDEO_VIDEOPORTMODE_HIRES, colors, &regions[i]);
+        status |= checkRegion(bitplanes, 24, 0, colors, &regions[i]);
+        status |= checkChunky4Region(bitplanes, colors, &regions[i]);
+        status |= checkChunkyPixelsToBitplanesRegion(bitplanes, 5, &regions[i]);
+    }
+
+    free(bitplanes);
+
+    return status;
+}
@@ -0,0 +1,251 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <screen.h>
+#include <viewportmode.h>
+
+#define WIDTH 40
+#define HEIGHT 12
+#define BITPLANE_DEPTH 6
+#define PITCH 6
+#define LOWRES_PIXEL_SCALE_FACTOR 2
+#define NUM_OF_PIXELS (WIDTH * HEIGHT * LOWRES_PIXEL_SCALE_FACTOR * LOWRES_PIXEL_SCALE_FACTOR)
+#define NUM_OF_CHANGES 6
+#define NUM_OF_SEGMENTS 4
+
+static const unsigned int segmentRows[NUM_OF_SEGMENTS + 1] = { 0, 3, 6, 9, HEIGHT };
+
+typedef struct
+{
+    amiVideo_UByte *pixels;
+    unsigned int pitch;
+}
+Frame;
+
+static void storeScanLine(const void *pixels, unsigned int row, void *data)
+{
+    Frame *frame = (Frame*)data;
+
+    memcpy(frame->pixels + row * frame->pitch, pixels, frame->pitch);
+}
+
+static void convertFrame(amiVideo_Screen *screen, amiVideo_PixelFormat pixelFormat, int corrected, void *pixels)
+{
+    if(corrected)
+    {
+        amiVideo_setScreenCorrectedPixelsPointer(screen, pixels, screen->correctedFormat.width * 4, 4, 0, 16, 8, 0, 24);
+        amiVideo_convertScreenBitplanesToCorrectedRGBPixels(screen);
+    }
+    else
+    {
+        amiVideo_setScreenUncorrectedRGBPixelsPointer(screen, (amiVideo_ULong*)pixels, WIDTH * (pixelFormat == AMIVIDEO_PIXEL_FORMAT_RGB32 ? 4 : 2), 0, 16, 8, 0, 24);
+        amiVideo_setScreenUncorrectedRGBPixelFormat(screen, pixelFormat);
+        amiVideo_convertScreenBitplanesToRGBPixels(screen);
+    }
+}
+
+/* Converts each range of scanlines with a separate screen that has the registers of that range */
+static void convertExpectedFrame(amiVideo_UByte *bitplanes, amiVideo_Color palettes[][64], const amiVideo_Long *viewportModes, amiVideo_PixelFormat pixelFormat, int corrected, amiVideo_UByte *expectedPixels)
+{
+    amiVideo_ULong segmentPixels[NUM_OF_PIXELS];
+    unsigned int i;
+
+    for(i = 0; i < NUM_OF_SEGMENTS; i++)
+    {
+        amiVideo_Screen screen;
+        unsigned int rowSize = WIDTH * (pixelFormat == AMIVIDEO_PIXEL_FORMAT_RGB32 ? 4 : 2);
+        unsigned int repeat = 1;
+
+        amiVideo_initScreen(&screen, WIDTH, HEIGHT, BITPLANE_DEPTH, 8, viewportModes[i]);
+        amiVideo_setBitplanePaletteColors(&screen.palette, palettes[i], 64);
+        amiVideo_setScreenBitplanes(&screen, bitplanes);
+
+        if(corrected)
+        {
+            amiVideo_setLowresPixelScaleFactor(&screen, LOWRES_PIXEL_SCALE_FACTOR);
+            rowSize = screen.correctedFormat.width * 4;
+            repeat = screen.correctedFormat.height / HEIGHT;
+        }
+
+        convertFrame(&screen, pixelFormat, corrected, segmentPixels);
+        memcpy(expectedPixels + segmentRows[i] * repeat * rowSize, (amiVideo_UByte*)segmentPixels + segmentRows[i] * repeat * rowSize, (segmentRows[i + 1] - segmentRows[i]) * repeat * rowSize);
+        amiVideo_cleanupScreen(&screen);
+    }
+}
+
+static int checkRegisters(amiVideo_UByte *bitplanes, amiVideo_Color palettes[][64], const amiVideo_Long *viewportModes, const amiVideo_RegisterChange *changes)
+{
+    amiVideo_PixelFormat pixelFormats[] = { AMIVIDEO_PIXEL_FORMAT_RGB32, AMIVIDEO_PIXEL_FORMAT_RGB565 };
+    amiVideo_ULong expectedPixels[NUM_OF_PIXELS];
+    amiVideo_ULong pixels[NUM_OF_PIXELS];
+    amiVideo_Screen screen;
+    amiVideo_ScanLineStream stream;
+    Frame frame;
+    unsigned int i;
+    int status = 0;
+
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, BITPLANE_DEPTH, 8, viewportModes[0]);
+    amiVideo_setLowresPixelScaleFactor(&screen, LOWRES_PIXEL_SCALE_FACTOR);
+    amiVideo_setBitplanePaletteColors(&screen.palette, palettes[0], 64);
+    amiVideo_setScreenBitplanes(&screen, bitplanes);
+
+    if(!amiVideo_setScreenRegisterChanges(&screen, changes, NUM_OF_CHANGES))
+    {
+        fprintf(stderr, "Cannot set the register changes!\n");
+        return 1;
+    }
+
+    /* Uncorrected conversions, the second one reuses the lookup tables of the first */
+    for(i = 0; i < 2 * sizeof(pixelFormats) / sizeof(amiVideo_PixelFormat); i++)
+    {
+        amiVideo_PixelFormat pixelFormat = pixelFormats[i / 2];
+
+        memset(expectedPixels, 0, sizeof(expectedPixels));
+        memset(pixels, 0, sizeof(pixels));
+        convertExpectedFrame(bitplanes, palettes, viewportModes, pixelFormat, 0, (amiVideo_UByte*)expectedPixels);
+        convertFrame(&screen, pixelFormat, 0, pixels);
+
+        if(memcmp(pixels, expectedPixels, sizeof(pixels)) != 0)
+        {
+            fprintf(stderr, "The scanlines of pixel format: %d with changed registers are incorrect!\n", pixelFormat);
+            status = 1;
+        }
+    }
+
+    /* Corrected conversion */
+    memset(expectedPixels, 0, sizeof(expectedPixels));
+    convertExpectedFrame(bitplanes, palettes, viewportModes, AMIVIDEO_PIXEL_FORMAT_RGB32, 1, (amiVideo_UByte*)expectedPixels);
+    convertFrame(&screen, AMIVIDEO_PIXEL_FORMAT_RGB32, 1, pixels);
+
+    if(memcmp(pixels, expectedPixels, screen.correctedFormat.width * screen.correctedFormat.height * 4) != 0)
+    {
+        fprintf(stderr, "The corrected scanlines with changed registers are incorrect!\n");
+        status = 1;
+    }
+
+    /* Streamed conversion */
+    memset(pixels, 0, sizeof(pixels));
+    frame.pixels = (amiVideo_UByte*)pixels;
+    frame.pitch = screen.correctedFormat.width * 4;
+
+    if(!amiVideo_initScanLineStream(&stream, &screen, AMIVIDEO_PIXEL_FORMAT_RGB32, 1, storeScanLine, &frame))
+    {
+        fprintf(stderr, "Cannot initialize the scanline stream!\n");
+        return 1;
+    }
+
+    for(i = 0; i < HEIGHT; i++)
+    {
+        amiVideo_UByte *bitplaneRows[BITPLANE_DEPTH];
+        unsigned int j;
+
+        for(j = 0; j < BITPLANE_DEPTH; j++)
+            bitplaneRows[j] = bitplanes + (j * HEIGHT + i) * PITCH;
+
+        amiVideo_feedScanLineStream(&stream, bitplaneRows);
+    }
+
+    amiVideo_cleanupScanLineStream(&stream);
+
+    if(memcmp(pixels, expectedPixels, screen.correctedFormat.width * screen.correctedFormat.height * 4) != 0)
+    {
+        fprintf(stderr, "The streamed scanlines with changed registers are incorrect!\n");
+        status = 1;
+    }
+
+    /* The changes are applied on top of the current palette of the screen */
+    for(i = 0; i < NUM_OF_SEGMENTS; i++)
+        palettes[i][40].r ^= 0xff;
+
+    amiVideo_setBitplanePaletteColors(&screen.palette, palettes[0], 64);
+    convertFrame(&screen, AMIVIDEO_PIXEL_FORMAT_RGB32, 0, pixels);
+    convertExpectedFrame(bitplanes, palettes, viewportModes, AMIVIDEO_PIXEL_FORMAT_RGB32, 0, (amiVideo_UByte*)expectedPixels);
+
+    if(memcmp(pixels, expectedPixels, WIDTH * HEIGHT * 4) != 0)
+    {
+        fprintf(stderr, "The scanlines with changed registers do not follow the palette of the screen!\n");
+        status = 1;
+    }
+
+    /* Without changes, every scanline uses the registers of the screen */
+    amiVideo_setScreenRegisterChanges(&screen, NULL, 0);
+    convertFrame(&screen, AMIVIDEO_PIXEL_FORMAT_RGB32, 0, pixels);
+    convertExpectedFrame(bitplanes, palettes, viewportModes, AMIVIDEO_PIXEL_FORMAT_RGB32, 0, (amiVideo_UByte*)expectedPixels);
+
+    if(memcmp(pixels, expectedPixels, segmentRows[1] * WIDTH * 4) != 0 || memcmp(pixels, expectedPixels, WIDTH * HEIGHT * 4) == 0)
+    {
+        fprintf(stderr, "Removing the register changes has no effect!\n");
+        status = 1;
+    }
+
+    amiVideo_cleanupScreen(&screen);
+
+    return status;
+}
+
+int main(int argc, char *argv[])
+{
+    amiVideo_UByte bitplanes[PITCH * HEIGHT * BITPLANE_DEPTH];
+    amiVideo_Color palettes[NUM_OF_SEGMENTS][64];
+    amiVideo_Long viewportModes[NUM_OF_SEGMENTS];
+    amiVideo_RegisterChange changes[NUM_OF_CHANGES];
+    unsigned int i;
+    int status = 0;
+
+    srand(1);
+
+    for(i = 0; i < sizeof(bitplanes); i++)
+        bitplanes[i] = rand();
+
+    for(i = 0; i < 64; i++)
+    {
+        palettes[0][i].r = rand();
+        palettes[0][i].g = rand();
+        palettes[0][i].b = rand();
+    }
+
+    for(i = 0; i < NUM_OF_CHANGES; i++)
+    {
+        changes[i].color.r = rand();
+        changes[i].color.g = rand();
+        changes[i].color.b = rand();
+        changes[i].viewportMode = 0;
+    }
+
+    /* Two colors change at scanline 3 */
+    changes[0].row = 3;
+    changes[0].reg = 1;
+    changes[1].row = 3;
+    changes[1].reg = 17;
+
+    /* The screen switches to HAM at scanline 6 and to extra halfbrite at scanline 9, which also changes the background color */
+    changes[2].row = 6;
+    changes[2].reg = AMIVIDEO_REGISTER_VIEWPORT_MODE;
+    changes[2].viewportMode = AMIVIDEO_VIDEOPORTMODE_HAM;
+    changes[3].row = 9;
+    changes[3].reg = AMIVIDEO_REGISTER_VIEWPORT_MODE;
+    changes[3].viewportMode = AMIVIDEO_VIDEOPORTMODE_EHB;
+    changes[4].row = 9;
+    changes[4].reg = 0;
+
+    /* Registers beyond the palette are ignored */
+    changes[5].row = 9;
+    changes[5].reg = 64;
+
+    /* Compose the registers of each range of scanlines */
+    viewportModes[0] = 0;
+    viewportModes[1] = 0;
+    viewportModes[2] = AMIVIDEO_VIDEOPORTMODE_HAM;
+    viewportModes[3] = AMIVIDEO_VIDEOPORTMODE_EHB;
+
+    for(i = 1; i < NUM_OF_SEGMENTS; i++)
+        memcpy(palettes[i], palettes[i - 1], sizeof(palettes[i]));
+
+    palettes[1][1] = palettes[2][1] = palettes[3][1] = changes[0].color;
+    palettes[1][17] = palettes[2][17] = palettes[3][17] = changes[1].color;
+    palettes[3][0] = changes[4].color;
+
+    status |= checkRegisters(bitplanes, palettes, viewportModes, changes);
+
+    return status;
+}
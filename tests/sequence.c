@@ -0,0 +1,150 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <screen.h>
+#include <viewportmode.h>
+
+#define MAX_WIDTH 64
+#define MAX_HEIGHT 12
+#define MAX_BITPLANE_DEPTH 24
+#define LOWRES_PIXEL_SCALE_FACTOR 2
+#define MAX_NUM_OF_PIXELS (MAX_WIDTH * MAX_HEIGHT * LOWRES_PIXEL_SCALE_FACTOR * LOWRES_PIXEL_SCALE_FACTOR)
+
+typedef struct
+{
+    amiVideo_Word width;
+    amiVideo_Word height;
+    unsigned int bitplaneDepth;
+    amiVideo_Long viewportMode;
+}
+Frame;
+
+static amiVideo_Color colors[256];
+
+static void setFrameSurfaces(amiVideo_Screen *screen, amiVideo_UByte *bitplanes, amiVideo_ULong *pixels)
+{
+    if(screen->palette.bitplaneFormat.numOfColors > 0)
+        amiVideo_setBitplanePaletteColors(&screen->palette, colors, screen->palette.bitplaneFormat.numOfColors); /* True color screens have no palette */
+    amiVideo_setScreenBitplanes(screen, bitplanes);
+    amiVideo_setScreenCorrectedPixelsPointer(screen, pixels, screen->correctedFormat.width * 4, 4, 1, 16, 8, 0, 24);
+}
+
+static int checkFrame(amiVideo_Screen *screen, const Frame *frame, amiVideo_UByte *bitplanes)
+{
+    amiVideo_ULong expectedPixels[MAX_NUM_OF_PIXELS];
+    amiVideo_ULong pixels[MAX_NUM_OF_PIXELS];
+    amiVideo_Screen freshScreen;
+    int status = 0;
+
+    /* Convert the frame with a newly initialized screen */
+    memset(expectedPixels, 0, sizeof(expectedPixels));
+    amiVideo_initScreen(&freshScreen, frame->width, frame->height, frame->bitplaneDepth, 8, frame->viewportMode);
+    amiVideo_setLowresPixelScaleFactor(&freshScreen, LOWRES_PIXEL_SCALE_FACTOR);
+    setFrameSurfaces(&freshScreen, bitplanes, expectedPixels);
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixels(&freshScreen);
+    amiVideo_cleanupScreen(&freshScreen);
+
+    /* Convert the frame with the reused screen, into a surface containing garbage */
+    memset(pixels, 0, sizeof(pixels));
+    memset(pixels, 0xaa, freshScreen.correctedFormat.width * freshScreen.correctedFormat.height * 4);
+    amiVideo_reinitScreen(screen, frame->width, frame->height, frame->bitplaneDepth, 8, frame->viewportMode);
+    setFrameSurfaces(screen, bitplanes, pixels);
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixels(screen);
+
+    if(memcmp(pixels, expectedPixels, sizeof(pixels)) != 0)
+    {
+        fprintf(stderr, "The frame of %dx%d with %u bitplanes and viewport mode: %x is incorrect!\n", frame->width, frame->height, frame->bitplaneDepth, frame->viewportMode);
+        status = 1;
+    }
+
+    return status;
+}
+
+int main(int argc, char *argv[])
+{
+    static const Frame frames[] = {
+        { 40, 10, 5, 0 },
+        { 64, 12, 6, AMIVIDEO_VIDEOPORTMODE_EHB },
+        { 40, 10, 4, AMIVIDEO_VIDEOPORTMODE_HIRES },
+        { 40, 10, 4, AMIVIDEO_VIDEOPORTMODE_HIRES },
+        { 48, 8, 6, AMIVIDEO_VIDEOPORTMODE_HAM },
+        { 32, 8, 24, 0 },
+        { 32, 8, 24, 0 },
+        { 40, 10, 5, 0 }
+    };
+    amiVideo_UByte *bitplanes = (amiVideo_UByte*)malloc(MAX_WIDTH / 8 * MAX_HEIGHT * MAX_BITPLANE_DEPTH);
+    amiVideo_Color *bitplaneColors;
+    amiVideo_Screen screen;
+    unsigned int i, j;
+    int status = 0;
+
+    srand(1);
+
+    for(i = 0; i < 256; i++)
+    {
+        colors[i].r = rand();
+        colors[i].g = rand();
+        colors[i].b = rand();
+    }
+
+    amiVideo_initScreen(&screen, frames[0].width, frames[0].height, frames[0].bitplaneDepth, 8, frames[0].viewportMode);
+    amiVideo_setLowresPixelScaleFactor(&screen, LOWRES_PIXEL_SCALE_FACTOR);
+
+    for(i = 0; i < sizeof(frames) / sizeof(Frame); i++)
+    {
+        /* Every frame has different bitplanes */
+        for(j = 0; j < MAX_WIDTH / 8 * MAX_HEIGHT * MAX_BITPLANE_DEPTH; j++)
+            bitplanes[j] = rand();
+
+        if(checkFrame(&screen, &frames[i], bitplanes) != 0)
+            status = 1;
+    }
+
+    /* A palette with fewer colors must reuse the storage of the previous palette */
+    amiVideo_reinitScreen(&screen, 40, 10, 6, 8, AMIVIDEO_VIDEOPORTMODE_EHB);
+    bitplaneColors = screen.palette.bitplaneFormat.color;
+    amiVideo_reinitScreen(&screen, 40, 10, 3, 4, 0);
+
+    if(screen.palette.bitplaneFormat.color != bitplaneColors || screen.palette.bitplaneFormat.numOfColors != 8 || screen.palette.chunkyFormat.numOfColors != 8)
+    {
+        fprintf(stderr, "The palette storage is not reused!\n");
+        status = 1;
+    }
+
+    /* The buffers of the incremental and delta conversions must be reused while they fit */
+    if(!amiVideo_setScreenIncrementalConversion(&screen, 1) || !amiVideo_setScreenDeltaConversion(&screen, 1))
+    {
+        fprintf(stderr, "Cannot enable the incremental and delta conversion!\n");
+        status = 1;
+    }
+    else
+    {
+        amiVideo_UByte *previousBitplanes = screen.incrementalFormat.previousBitplanes;
+        amiVideo_UByte *touchedRows = screen.deltaFormat.touchedRows;
+
+        if(!amiVideo_reinitScreen(&screen, 32, 8, 2, 8, 0)
+          || !amiVideo_reinitScreen(&screen, 40, 10, 3, 4, 0)
+          || screen.incrementalFormat.previousBitplanes != previousBitplanes
+          || screen.deltaFormat.touchedRows != touchedRows)
+        {
+            fprintf(stderr, "The buffers of the incremental and delta conversion are not reused!\n");
+            status = 1;
+        }
+
+        screen.incrementalFormat.previousValid = 1;
+        screen.deltaFormat.valid = 1;
+        amiVideo_reinitScreen(&screen, 40, 10, 3, 4, 0);
+
+        /* The next image has the same size, but none of its scanlines has been converted yet */
+        if(screen.incrementalFormat.previousValid || screen.deltaFormat.valid)
+        {
+            fprintf(stderr, "A reinitialized screen must convert all scanlines again!\n");
+            status = 1;
+        }
+    }
+
+    amiVideo_cleanupScreen(&screen);
+    free(bitplanes);
+
+    return status;
+}
@@ -0,0 +1,114 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <screen.h>
+#include <byterun1.h>
+#include <viewportmode.h>
+
+#define WIDTH 40
+#define HEIGHT 10
+#define BITPLANE_DEPTH 5
+#define PITCH 6
+#define LOWRES_PIXEL_SCALE_FACTOR 2
+
+static int checkStage(const amiVideo_ScreenStats *stats, unsigned int stage, unsigned long numOfRuns, unsigned long numOfPixels, unsigned long numOfBytes)
+{
+    const amiVideo_StageStats *stageStats = &stats->stage[stage];
+
+    if(stageStats->numOfRuns != numOfRuns || stageStats->numOfPixels != numOfPixels || stageStats->numOfBytes != numOfBytes || stageStats->time < 0.0)
+    {
+        fprintf(stderr, "Stage: %u has %lu runs, %lu pixels and %lu bytes, expected: %lu runs, %lu pixels and %lu bytes!\n", stage, stageStats->numOfRuns, stageStats->numOfPixels, stageStats->numOfBytes, numOfRuns, numOfPixels, numOfBytes);
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    amiVideo_UByte bitplanes[PITCH * HEIGHT * BITPLANE_DEPTH];
+    amiVideo_UByte chunkyPixels[WIDTH * HEIGHT];
+    amiVideo_ULong rgbPixels[WIDTH * HEIGHT];
+    amiVideo_ULong correctedPixels[WIDTH * HEIGHT * LOWRES_PIXEL_SCALE_FACTOR * LOWRES_PIXEL_SCALE_FACTOR];
+    amiVideo_Color colors[32];
+    amiVideo_Screen screen;
+    amiVideo_ScreenStats stats;
+    unsigned int i;
+    int status = 0;
+
+    srand(1);
+
+    for(i = 0; i < sizeof(bitplanes); i++)
+        bitplanes[i] = rand();
+
+    for(i = 0; i < 32; i++)
+    {
+        colors[i].r = rand();
+        colors[i].g = rand();
+        colors[i].b = rand();
+    }
+
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, BITPLANE_DEPTH, 8, 0);
+    amiVideo_setLowresPixelScaleFactor(&screen, LOWRES_PIXEL_SCALE_FACTOR);
+    amiVideo_setBitplanePaletteColors(&screen.palette, colors, 32);
+    amiVideo_setScreenBitplanes(&screen, bitplanes);
+    amiVideo_setScreenUncorrectedChunkyPixelsPointer(&screen, chunkyPixels, WIDTH);
+    amiVideo_setScreenCorrectedPixelsPointer(&screen, correctedPixels, screen.correctedFormat.width * 4, 4, 0, 16, 8, 0, 24);
+    amiVideo_setScreenUncorrectedRGBPixelsPointer(&screen, rgbPixels, WIDTH * 4, 0, 16, 8, 0, 24);
+
+    /* Perform every stage once, the RGB conversion twice */
+    amiVideo_convertScreenBitplanesToChunkyPixels(&screen);
+    amiVideo_convertScreenBitplanesToRGBPixels(&screen);
+    amiVideo_convertScreenChunkyPixelsToRGBPixels(&screen);
+    amiVideo_correctScreenPixels(&screen);
+    amiVideo_convertScreenChunkyPixelsToBitplanes(&screen);
+    amiVideo_setScreenIncrementalConversion(&screen, 1);
+
+    amiVideo_queryScreenStats(&screen, &stats);
+
+    if(amiVideo_checkInstrumentation())
+    {
+        status |= checkStage(&stats, AMIVIDEO_STAGE_PALETTE, 2, 0, 0);
+        status |= checkStage(&stats, AMIVIDEO_STAGE_PLANAR_DECODE, 1, WIDTH * HEIGHT, WIDTH * HEIGHT);
+        status |= checkStage(&stats, AMIVIDEO_STAGE_COLOR_LOOKUP, 2, 2 * WIDTH * HEIGHT, 2 * WIDTH * HEIGHT * 4);
+        status |= checkStage(&stats, AMIVIDEO_STAGE_CORRECTION, 1, sizeof(correctedPixels) / 4, sizeof(correctedPixels));
+        status |= checkStage(&stats, AMIVIDEO_STAGE_PLANAR_ENCODE, 1, WIDTH * HEIGHT, sizeof(bitplanes));
+        status |= checkStage(&stats, AMIVIDEO_STAGE_HAM_DECODE, 0, 0, 0);
+
+        /* The incremental mode allocates a copy of the bitplanes and the dirty scanline ranges */
+        if(stats.numOfAllocations != 2 || stats.allocatedBytes != sizeof(bitplanes) + (HEIGHT / 2 + 1) * sizeof(amiVideo_RowRange))
+        {
+            fprintf(stderr, "The screen has made: %lu allocations of: %lu bytes!\n", stats.numOfAllocations, stats.allocatedBytes);
+            status = 1;
+        }
+
+        /* An incremental conversion of unchanged bitplanes produces no pixels */
+        amiVideo_convertScreenBitplanesToRGBPixels(&screen);
+        amiVideo_convertScreenBitplanesToRGBPixels(&screen);
+        amiVideo_queryScreenStats(&screen, &stats);
+        status |= checkStage(&stats, AMIVIDEO_STAGE_COLOR_LOOKUP, 4, 3 * WIDTH * HEIGHT, 3 * WIDTH * HEIGHT * 4);
+    }
+    else
+    {
+        /* Without instrumentation, nothing is recorded */
+        for(i = 0; i < AMIVIDEO_NUM_OF_STAGES; i++)
+            status |= checkStage(&stats, i, 0, 0, 0);
+    }
+
+    /* Resetting clears all statistics */
+    amiVideo_resetScreenStats(&screen);
+    amiVideo_queryScreenStats(&screen, &stats);
+
+    for(i = 0; i < AMIVIDEO_NUM_OF_STAGES; i++)
+        status |= checkStage(&stats, i, 0, 0, 0);
+
+    if(stats.numOfAllocations != 0 || stats.allocatedBytes != 0)
+    {
+        fprintf(stderr, "The allocations have not been reset!\n");
+        status = 1;
+    }
+
+    amiVideo_cleanupScreen(&screen);
+
+    return status;
+}
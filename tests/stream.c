@@ -0,0 +1,169 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <screen.h>
+#include <viewportmode.h>
+
+#define WIDTH 40
+#define HEIGHT 10
+#define BITPLANE_DEPTH 6
+#define PITCH 6
+#define LOWRES_PIXEL_SCALE_FACTOR 2
+
+typedef struct
+{
+    amiVideo_UByte *pixels;
+    unsigned int pitch;
+    unsigned int numOfRows;
+}
+Frame;
+
+static void storeScanLine(const void *pixels, unsigned int row, void *data)
+{
+    Frame *frame = (Frame*)data;
+
+    memcpy(frame->pixels + row * frame->pitch, pixels, frame->pitch);
+    frame->numOfRows++;
+}
+
+static int checkStream(amiVideo_UByte *bitplanes, amiVideo_Color *colors, amiVideo_Long viewportMode)
+{
+    amiVideo_ULong expectedPixels[WIDTH * HEIGHT * LOWRES_PIXEL_SCALE_FACTOR * LOWRES_PIXEL_SCALE_FACTOR];
+    amiVideo_ULong pixels[WIDTH * HEIGHT * LOWRES_PIXEL_SCALE_FACTOR * LOWRES_PIXEL_SCALE_FACTOR];
+    amiVideo_UByte expectedChunkyPixels[WIDTH * HEIGHT];
+    amiVideo_UByte chunkyPixels[WIDTH * HEIGHT];
+    amiVideo_UByte scanLine[PITCH * BITPLANE_DEPTH];
+    amiVideo_Screen screen;
+    amiVideo_ScanLineStream stream;
+    Frame frame;
+    unsigned int i;
+    int status = 0;
+
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, BITPLANE_DEPTH, 8, viewportMode);
+    amiVideo_setLowresPixelScaleFactor(&screen, LOWRES_PIXEL_SCALE_FACTOR);
+    amiVideo_setBitplanePaletteColors(&screen.palette, colors, 64);
+    amiVideo_setScreenBitplanes(&screen, bitplanes);
+    amiVideo_setScreenUncorrectedChunkyPixelsPointer(&screen, expectedChunkyPixels, WIDTH);
+    amiVideo_setScreenCorrectedPixelsPointer(&screen, expectedPixels, screen.correctedFormat.width * 4, 4, 0, 16, 8, 0, 24);
+    amiVideo_convertScreenBitplanesToChunkyPixels(&screen);
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixels(&screen);
+
+    /* Stream corrected RGB scanlines from the bitplane rows */
+    frame.pixels = (amiVideo_UByte*)pixels;
+    frame.pitch = screen.correctedFormat.width * 4;
+    frame.numOfRows = 0;
+
+    if(!amiVideo_initScanLineStream(&stream, &screen, AMIVIDEO_PIXEL_FORMAT_RGB32, 1, storeScanLine, &frame))
+    {
+        fprintf(stderr, "Cannot initialize the scanline stream!\n");
+        return 1;
+    }
+
+    for(i = 0; i < HEIGHT; i++)
+    {
+        amiVideo_UByte *bitplaneRows[BITPLANE_DEPTH];
+        unsigned int j;
+
+        for(j = 0; j < BITPLANE_DEPTH; j++)
+            bitplaneRows[j] = bitplanes + (j * HEIGHT + i) * PITCH;
+
+        amiVideo_feedScanLineStream(&stream, bitplaneRows);
+    }
+
+    if(amiVideo_feedScanLineStream(&stream, NULL))
+    {
+        fprintf(stderr, "The stream accepts more scanlines than the screen has!\n");
+        status = 1;
+    }
+
+    amiVideo_cleanupScanLineStream(&stream);
+
+    if(frame.numOfRows != (unsigned int)screen.correctedFormat.height || memcmp(pixels, expectedPixels, sizeof(pixels)) != 0)
+    {
+        fprintf(stderr, "The streamed corrected scanlines of viewport mode: %x are incorrect!\n", viewportMode);
+        status = 1;
+    }
+
+    /* Stream uncorrected chunky scanlines from interleaved scanlines */
+    frame.pixels = chunkyPixels;
+    frame.pitch = WIDTH;
+    frame.numOfRows = 0;
+
+    if(!amiVideo_initScanLineStream(&stream, &screen, AMIVIDEO_PIXEL_FORMAT_CHUNKY8, 0, storeScanLine, &frame))
+    {
+        fprintf(stderr, "Cannot initialize the scanline stream!\n");
+        return 1;
+    }
+
+    for(i = 0; i < HEIGHT; i++)
+    {
+        unsigned int j;
+
+        for(j = 0; j < BITPLANE_DEPTH; j++)
+            memcpy(scanLine + j * PITCH, bitplanes + (j * HEIGHT + i) * PITCH, PITCH);
+
+        amiVideo_feedInterleavedScanLineStream(&stream, scanLine);
+    }
+
+    amiVideo_cleanupScanLineStream(&stream);
+
+    if(frame.numOfRows != HEIGHT || memcmp(chunkyPixels, expectedChunkyPixels, sizeof(chunkyPixels)) != 0)
+    {
+        fprintf(stderr, "The streamed chunky scanlines of viewport mode: %x are incorrect!\n", viewportMode);
+        status = 1;
+    }
+
+    amiVideo_cleanupScreen(&screen);
+
+    return status;
+}
+
+static int checkTrueColorChunkyStream(void)
+{
+    amiVideo_Screen screen;
+    amiVideo_ScanLineStream stream;
+    Frame frame;
+    int status = 0;
+
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, 24, 8, 0);
+
+    /* A chunky pixel cannot hold the color channels of a true color screen */
+    if(amiVideo_initScanLineStream(&stream, &screen, AMIVIDEO_PIXEL_FORMAT_CHUNKY8, 0, storeScanLine, &frame)
+      || amiVideo_initScanLineStream(&stream, &screen, AMIVIDEO_PIXEL_FORMAT_CHUNKY4, 0, storeScanLine, &frame))
+    {
+        fprintf(stderr, "A chunky stream of a true color screen should not be initialized!\n");
+        status = 1;
+    }
+
+    amiVideo_cleanupScreen(&screen);
+
+    return status;
+}
+
+int main(int argc, char *argv[])
+{
+    amiVideo_UByte bitplanes[PITCH * HEIGHT * BITPLANE_DEPTH];
+    amiVideo_Color colors[64];
+    unsigned int i;
+    int status = 0;
+
+    srand(1);
+
+    for(i = 0; i < PITCH * HEIGHT * BITPLANE_DEPTH; i++)
+        bitplanes[i] = rand();
+
+    for(i = 0; i < 64; i++)
+    {
+        colors[i].r = rand();
+        colors[i].g = rand();
+        colors[i].b = rand();
+    }
+
+    if(checkStream(bitplanes, colors, 0) != 0
+      || checkStream(bitplanes, colors, AMIVIDEO_VIDEOPORTMODE_HAM) != 0
+      || checkStream(bitplanes, colors, AMIVIDEO_VIDEOPORTMODE_HIRES | AMIVIDEO_VIDEOPORTMODE_LACE) != 0
+      || checkTrueColorChunkyStream() != 0)
+        status = 1;
+
+    return status;
+}
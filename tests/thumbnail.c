@@ -0,0 +1,186 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <screen.h>
+#include <viewportmode.h>
+
+#define WIDTH 320
+#define HEIGHT 24
+#define PITCH (WIDTH / 8)
+#define MAX_BITPLANE_DEPTH 24
+#define THUMBNAIL_WIDTH 56
+#define THUMBNAIL_HEIGHT 9
+#define LARGE_THUMBNAIL_WIDTH 500
+#define LARGE_THUMBNAIL_HEIGHT 30
+
+/* Composes the expected thumbnail from the pixels of a full conversion */
+static void composeExpectedThumbnail(const amiVideo_ULong *fullPixels, unsigned int width, unsigned int height, amiVideo_ThumbnailFilter filter, amiVideo_ULong *pixels)
+{
+    unsigned int i;
+
+    for(i = 0; i < height; i++)
+    {
+        unsigned int j;
+
+        for(j = 0; j < width; j++)
+        {
+            if(filter == AMIVIDEO_THUMBNAIL_BOX)
+            {
+                unsigned int firstRow = i * HEIGHT / height, lastRow = (i + 1) * HEIGHT / height;
+                unsigned int firstColumn = j * WIDTH / width, lastColumn = (j + 1) * WIDTH / width;
+                unsigned long sum[4] = { 0, 0, 0, 0 };
+                unsigned long numOfPixels;
+                unsigned int x, y, k;
+
+                if(lastRow <= firstRow)
+                    lastRow = firstRow + 1;
+
+                if(lastColumn <= firstColumn)
+                    lastColumn = firstColumn + 1;
+
+                numOfPixels = (lastRow - firstRow) * (lastColumn - firstColumn);
+
+                for(y = firstRow; y < lastRow; y++)
+                {
+                    for(x = firstColumn; x < lastColumn; x++)
+                    {
+                        for(k = 0; k < 4; k++)
+                            sum[k] += (fullPixels[y * WIDTH + x] >> (k * 8)) & 0xff;
+                    }
+                }
+
+                pixels[i * width + j] = 0;
+
+                for(k = 0; k < 4; k++)
+                    pixels[i * width + j] |= (amiVideo_ULong)((sum[k] + numOfPixels / 2) / numOfPixels) << (k * 8);
+            }
+            else
+                pixels[i * width + j] = fullPixels[((2 * i + 1) * HEIGHT / (2 * height)) * WIDTH + (2 * j + 1) * WIDTH / (2 * width)];
+        }
+    }
+}
+
+static int checkThumbnail(amiVideo_UByte *bitplanes, unsigned int bitplaneDepth, amiVideo_Long viewportMode, amiVideo_Color *colors, unsigned int width, unsigned int height, amiVideo_ThumbnailFilter filter)
+{
+    static amiVideo_ULong fullPixels[WIDTH * HEIGHT];
+    static amiVideo_ULong expectedPixels[LARGE_THUMBNAIL_WIDTH * LARGE_THUMBNAIL_HEIGHT], pixels[LARGE_THUMBNAIL_WIDTH * LARGE_THUMBNAIL_HEIGHT];
+    amiVideo_Screen screen;
+    int status = 0;
+
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, bitplaneDepth, 8, viewportMode);
+    amiVideo_setScreenBitplanes(&screen, bitplanes);
+
+    if(bitplaneDepth <= 8)
+        amiVideo_setBitplanePaletteColors(&screen.palette, colors, 32);
+
+    amiVideo_setScreenUncorrectedRGBPixelsPointer(&screen, fullPixels, WIDTH * 4, 0, 16, 8, 0, 24);
+    amiVideo_convertScreenBitplanesToRGBPixels(&screen);
+    composeExpectedThumbnail(fullPixels, width, height, filter, expectedPixels);
+
+    if(!amiVideo_convertScreenBitplanesToThumbnail(&screen, pixels, width, height, width * 4, filter, 16, 8, 0, 24) || memcmp(pixels, expectedPixels, width * height * 4) != 0)
+    {
+        fprintf(stderr, "The %s thumbnail of %ux%u pixels of %u bitplanes with viewport mode: %x is incorrect!\n", filter == AMIVIDEO_THUMBNAIL_BOX ? "box filtered" : "sampled", width, height, bitplaneDepth, (unsigned int)viewportMode);
+        status = 1;
+    }
+
+    amiVideo_cleanupScreen(&screen);
+
+    return status;
+}
+
+/* Converts a thumbnail with the red and blue components swapped, which must only reorder the bytes of the pixels */
+static int checkThumbnailLayout(amiVideo_UByte *bitplanes, amiVideo_Color *colors, amiVideo_ThumbnailFilter filter)
+{
+    amiVideo_ULong expectedPixels[THUMBNAIL_WIDTH * THUMBNAIL_HEIGHT], pixels[THUMBNAIL_WIDTH * THUMBNAIL_HEIGHT];
+    amiVideo_Screen screen;
+    unsigned int i;
+    int status = 0;
+
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, 5, 8, 0);
+    amiVideo_setScreenBitplanes(&screen, bitplanes);
+    amiVideo_setBitplanePaletteColors(&screen.palette, colors, 32);
+
+    amiVideo_convertScreenBitplanesToThumbnail(&screen, expectedPixels, THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT, THUMBNAIL_WIDTH * 4, filter, 16, 8, 0, 24);
+    amiVideo_convertScreenBitplanesToThumbnail(&screen, pixels, THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT, THUMBNAIL_WIDTH * 4, filter, 0, 8, 16, 24);
+
+    for(i = 0; i < THUMBNAIL_WIDTH * THUMBNAIL_HEIGHT; i++)
+    {
+        amiVideo_ULong expectedPixel = (expectedPixels[i] & 0xff00ff00) | ((expectedPixels[i] >> 16) & 0xff) | ((expectedPixels[i] & 0xff) << 16);
+
+        if(pixels[i] != expectedPixel)
+        {
+            fprintf(stderr, "The %s thumbnail with swapped red and blue components is incorrect!\n", filter == AMIVIDEO_THUMBNAIL_BOX ? "box filtered" : "sampled");
+            status = 1;
+            break;
+        }
+    }
+
+    amiVideo_cleanupScreen(&screen);
+
+    return status;
+}
+
+static int checkThumbnailSize(amiVideo_Word width, amiVideo_Word height, amiVideo_Long viewportMode, unsigned int maxWidth, unsigned int maxHeight, unsigned int expectedWidth, unsigned int expectedHeight)
+{
+    amiVideo_Screen screen;
+    unsigned int thumbnailWidth, thumbnailHeight;
+
+    amiVideo_initScreen(&screen, width, height, 5, 4, viewportMode);
+    amiVideo_calculateThumbnailSize(&screen, maxWidth, maxHeight, &thumbnailWidth, &thumbnailHeight);
+    amiVideo_cleanupScreen(&screen);
+
+    if(thumbnailWidth != expectedWidth || thumbnailHeight != expectedHeight)
+    {
+        fprintf(stderr, "The thumbnail of a %ux%u screen with viewport mode: %x is %ux%u, expected: %ux%u!\n", width, height, (unsigned int)viewportMode, thumbnailWidth, thumbnailHeight, expectedWidth, expectedHeight);
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    amiVideo_UByte *bitplanes = (amiVideo_UByte*)malloc(PITCH * HEIGHT * MAX_BITPLANE_DEPTH);
+    amiVideo_Color colors[32];
+    unsigned int i;
+    int status = 0;
+
+    srand(1);
+
+    for(i = 0; i < PITCH * HEIGHT * MAX_BITPLANE_DEPTH; i++)
+        bitplanes[i] = rand();
+
+    for(i = 0; i < 32; i++)
+    {
+        colors[i].r = rand();
+        colors[i].g = rand();
+        colors[i].b = rand();
+    }
+
+    for(i = 0; i < 2; i++)
+    {
+        amiVideo_ThumbnailFilter filter = i == 0 ? AMIVIDEO_THUMBNAIL_SAMPLE : AMIVIDEO_THUMBNAIL_BOX;
+
+        status |= checkThumbnail(bitplanes, 5, 0, colors, THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT, filter);
+        status |= checkThumbnail(bitplanes, 6, AMIVIDEO_VIDEOPORTMODE_EHB, colors, THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT, filter);
+        status |= checkThumbnail(bitplanes, 6, AMIVIDEO_VIDEOPORTMODE_HAM, colors, THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT, filter);
+        status |= checkThumbnail(bitplanes, 24, 0, colors, THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT, filter);
+        status |= checkThumbnail(bitplanes, 5, 0, colors, WIDTH, HEIGHT, filter); /* Identical to the screen */
+        status |= checkThumbnail(bitplanes, 5, 0, colors, 16, 6, filter); /* Sampled pixels that are far apart */
+        status |= checkThumbnail(bitplanes, 24, 0, colors, 16, 6, filter);
+        status |= checkThumbnail(bitplanes, 24, 0, colors, 1, 1, filter); /* A box wider than 256 pixels */
+        status |= checkThumbnailLayout(bitplanes, colors, filter);
+        status |= checkThumbnail(bitplanes, 5, 0, colors, LARGE_THUMBNAIL_WIDTH, LARGE_THUMBNAIL_HEIGHT, filter); /* Larger than the screen */
+    }
+
+    /* The displayed aspect ratio depends on the resolution and interlace bits */
+    status |= checkThumbnailSize(320, 256, 0, 160, 160, 160, 128);
+    status |= checkThumbnailSize(640, 200, AMIVIDEO_VIDEOPORTMODE_HIRES, 160, 160, 160, 100);
+    status |= checkThumbnailSize(640, 512, AMIVIDEO_VIDEOPORTMODE_HIRES | AMIVIDEO_VIDEOPORTMODE_LACE, 160, 160, 160, 128);
+    status |= checkThumbnailSize(320, 512, AMIVIDEO_VIDEOPORTMODE_LACE, 160, 160, 160, 128);
+    status |= checkThumbnailSize(1280, 200, AMIVIDEO_VIDEOPORTMODE_SUPERHIRES, 100, 100, 100, 62);
+
+    free(bitplanes);
+
+    return status;
+}
@@ -0,0 +1,213 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <screen.h>
+#include <pixelformat.h>
+
+#define WIDTH 300
+#define HEIGHT 7
+#define MAX_BITPLANE_DEPTH 32
+#define LOWRES_PIXEL_SCALE_FACTOR 2
+#define MAX_NUM_OF_PIXELS (WIDTH * HEIGHT * LOWRES_PIXEL_SCALE_FACTOR * LOWRES_PIXEL_SCALE_FACTOR)
+
+typedef struct
+{
+    amiVideo_UByte *pixels;
+    unsigned int pitch;
+}
+Frame;
+
+static void storeScanLine(const void *pixels, unsigned int row, void *data)
+{
+    Frame *frame = (Frame*)data;
+
+    memcpy(frame->pixels + row * frame->pitch, pixels, frame->pitch);
+}
+
+/* Composes the expected pixels by collecting the bits of each pixel from every bitplane separately */
+static void composeExpectedPixels(const amiVideo_Screen *screen, amiVideo_UByte rshift, amiVideo_UByte gshift, amiVideo_UByte bshift, amiVideo_UByte ashift, amiVideo_ULong *pixels)
+{
+    unsigned int i;
+
+    for(i = 0; i < HEIGHT; i++)
+    {
+        unsigned int j;
+
+        for(j = 0; j < WIDTH; j++)
+        {
+            amiVideo_ULong value = 0;
+            amiVideo_ULong r, g, b, a;
+            unsigned int k;
+
+            for(k = 0; k < screen->bitplaneDepth; k++)
+            {
+                if(screen->bitplaneFormat.bitplanes[k][i * screen->bitplaneFormat.rowStride + j / 8] & (0x80 >> (j % 8)))
+                    value |= (amiVideo_ULong)1 << k;
+            }
+
+            if(screen->bitplaneDepth == 24)
+            {
+                r = (value >> 16) & 0xff;
+                g = (value >> 8) & 0xff;
+                b = value & 0xff;
+                a = 0;
+            }
+            else
+            {
+                r = (value >> 24) & 0xff;
+                g = (value >> 16) & 0xff;
+                b = (value >> 8) & 0xff;
+                a = value & 0xff;
+            }
+
+            pixels[i * WIDTH + j] = (r << rshift) | (g << gshift) | (b << bshift) | (a << ashift);
+        }
+    }
+}
+
+/* Repeats every pixel of the expected pixels horizontally and vertically */
+static void correctExpectedPixels(const amiVideo_ULong *pixels, unsigned int repeatHorizontal, unsigned int repeatVertical, amiVideo_ULong *correctedPixels)
+{
+    unsigned int i;
+
+    for(i = 0; i < HEIGHT * repeatVertical; i++)
+    {
+        unsigned int j;
+
+        for(j = 0; j < WIDTH * repeatHorizontal; j++)
+            correctedPixels[i * WIDTH * repeatHorizontal + j] = pixels[(i / repeatVertical) * WIDTH + j / repeatHorizontal];
+    }
+}
+
+static int checkTrueColor(amiVideo_UByte *bitplanes, unsigned int bitplaneDepth, amiVideo_UByte rshift, amiVideo_UByte gshift, amiVideo_UByte bshift, amiVideo_UByte ashift)
+{
+    amiVideo_ULong expectedPixels[WIDTH * HEIGHT];
+    amiVideo_ULong expectedCorrectedPixels[MAX_NUM_OF_PIXELS];
+    amiVideo_ULong compactPixels[WIDTH * HEIGHT];
+    amiVideo_UWord expectedWordPixels[WIDTH * HEIGHT];
+    amiVideo_ULong pixels[MAX_NUM_OF_PIXELS];
+    amiVideo_Screen screen;
+    amiVideo_ScanLineStream stream;
+    Frame frame;
+    unsigned int repeatHorizontal, repeatVertical;
+    unsigned int i;
+    int status = 0;
+
+    amiVideo_initScreen(&screen, WIDTH, HEIGHT, bitplaneDepth, 8, 0);
+    amiVideo_setLowresPixelScaleFactor(&screen, LOWRES_PIXEL_SCALE_FACTOR);
+    amiVideo_setScreenBitplanes(&screen, bitplanes);
+
+    composeExpectedPixels(&screen, rshift, gshift, bshift, ashift, expectedPixels);
+
+    /* Sequential and parallel conversions to uncorrected RGB pixels */
+    for(i = 1; i <= 3; i += 2)
+    {
+        memset(pixels, 0xaa, sizeof(pixels));
+        amiVideo_setScreenUncorrectedRGBPixelsPointer(&screen, pixels, WIDTH * 4, 0, rshift, gshift, bshift, ashift);
+        amiVideo_convertScreenBitplanesToRGBPixelsParallel(&screen, i, NULL, NULL);
+
+        if(memcmp(pixels, expectedPixels, sizeof(expectedPixels)) != 0)
+        {
+            fprintf(stderr, "The RGB pixels of %u bitplanes with shifts: %u %u %u %u converted with: %u threads are incorrect!\n", bitplaneDepth, rshift, gshift, bshift, ashift, i);
+            status = 1;
+        }
+    }
+
+    /* Conversion to corrected RGB pixels, without an intermediate surface */
+    repeatHorizontal = screen.correctedFormat.width / WIDTH;
+    repeatVertical = screen.correctedFormat.height / HEIGHT;
+    correctExpectedPixels(expectedPixels, repeatHorizontal, repeatVertical, expectedCorrectedPixels);
+
+    memset(pixels, 0xaa, sizeof(pixels));
+    amiVideo_setScreenUncorrectedRGBPixelsPointer(&screen, NULL, WIDTH * 4, 0, rshift, gshift, bshift, ashift);
+    amiVideo_setScreenCorrectedPixelsPointer(&screen, pixels, screen.correctedFormat.width * 4, 4, 1, rshift, gshift, bshift, ashift);
+    amiVideo_convertScreenBitplanesToCorrectedRGBPixels(&screen);
+
+    if(screen.uncorrectedRGBFormat.memoryAllocated || memcmp(pixels, expectedCorrectedPixels, WIDTH * HEIGHT * repeatHorizontal * repeatVertical * 4) != 0)
+    {
+        fprintf(stderr, "The corrected RGB pixels of %u bitplanes with shifts: %u %u %u %u are incorrect!\n", bitplaneDepth, rshift, gshift, bshift, ashift);
+        status = 1;
+    }
+
+    /* Streamed conversion to corrected RGB pixels */
+    memset(pixels, 0xaa, sizeof(pixels));
+    frame.pixels = (amiVideo_UByte*)pixels;
+    frame.pitch = screen.correctedFormat.width * 4;
+
+    if(amiVideo_initScanLineStream(&stream, &screen, AMIVIDEO_PIXEL_FORMAT_RGB32, 1, storeScanLine, &frame))
+    {
+        for(i = 0; i < HEIGHT; i++)
+        {
+            amiVideo_UByte *bitplaneRows[MAX_BITPLANE_DEPTH];
+            unsigned int j;
+
+            for(j = 0; j < bitplaneDepth; j++)
+                bitplaneRows[j] = screen.bitplaneFormat.bitplanes[j] + i * screen.bitplaneFormat.rowStride;
+
+            amiVideo_feedScanLineStream(&stream, bitplaneRows);
+        }
+
+        amiVideo_cleanupScanLineStream(&stream);
+
+        if(memcmp(pixels, expectedCorrectedPixels, WIDTH * HEIGHT * repeatHorizontal * repeatVertical * 4) != 0)
+        {
+            fprintf(stderr, "The streamed pixels of %u bitplanes with shifts: %u %u %u %u are incorrect!\n", bitplaneDepth, rshift, gshift, bshift, ashift);
+            status = 1;
+        }
+    }
+    else
+    {
+        fprintf(stderr, "Cannot stream the pixels of %u bitplanes!\n", bitplaneDepth);
+        status = 1;
+    }
+
+    /* Conversion to compact RGB565 pixels */
+    composeExpectedPixels(&screen, 16, 8, 0, 24, compactPixels);
+    amiVideo_convertRGBPixelsToRGB565(compactPixels, WIDTH * HEIGHT, expectedWordPixels);
+
+    memset(pixels, 0xaa, sizeof(pixels));
+    amiVideo_setScreenUncorrectedRGBPixelsPointer(&screen, pixels, WIDTH * 2, 0, rshift, gshift, bshift, ashift);
+    amiVideo_setScreenUncorrectedRGBPixelFormat(&screen, AMIVIDEO_PIXEL_FORMAT_RGB565);
+    amiVideo_convertScreenBitplanesToRGBPixels(&screen);
+
+    if(memcmp(pixels, expectedWordPixels, sizeof(expectedWordPixels)) != 0)
+    {
+        fprintf(stderr, "The RGB565 pixels of %u bitplanes are incorrect!\n", bitplaneDepth);
+        status = 1;
+    }
+
+    amiVideo_cleanupScreen(&screen);
+
+    return status;
+}
+
+int main(int argc, char *argv[])
+{
+    amiVideo_UByte *bitplanes;
+    unsigned int bitplanesSize = ((WIDTH + 15) / 16) * 2 * HEIGHT * MAX_BITPLANE_DEPTH;
+    unsigned int i;
+    int status = 0;
+
+    srand(1);
+
+    bitplanes = (amiVideo_UByte*)malloc(bitplanesSize);
+
+    if(bitplanes == NULL)
+    {
+        fprintf(stderr, "Cannot allocate the bitplanes!\n");
+        return 1;
+    }
+
+    for(i = 0; i < bitplanesSize; i++)
+        bitplanes[i] = rand();
+
+    /* The native layouts and a reversed layout */
+    status |= checkTrueColor(bitplanes, 24, 16, 8, 0, 24);
+    status |= checkTrueColor(bitplanes, 24, 0, 8, 16, 24);
+    status |= checkTrueColor(bitplanes, 32, 24, 16, 8, 0);
+    status |= checkTrueColor(bitplanes, 32, 0, 8, 16, 24);
+
+    free(bitplanes);
+
+    return status;
+}